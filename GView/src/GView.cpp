@@ -10,6 +10,7 @@ enum class CommandID
     ListTypes,
     UpdateConfig,
     Test,
+    Scan,
 };
 
 struct CommandInfo
@@ -39,6 +40,7 @@ CommandInfo commands[] = {
     { CommandID::ListTypes, _U("list-types") },
     { CommandID::UpdateConfig, _U("updateconfig") },
     { CommandID::Test, _U("test") },
+    { CommandID::Scan, _U("scan") },
 };
 
 std::string_view help = R"HELP(
@@ -63,6 +65,12 @@ Where <command> is on of:
    
    test [fileName|path]     Opens a script for testing                     
 
+   scan [fileName|path]     Analyzes one or multiple files or folders without
+                            the user interface. Every file is identified and
+                            parsed by its type plugin and a JSON line with the
+                            result is written for each file.
+                            Ex: 'GView scan samples/ --output:results.jsonl'
+
    list-types               List all available types (as loaded from gview.ini).
                             Ex: 'GView list-types' 
 And <options> are:
@@ -70,6 +78,12 @@ And <options> are:
                             Ex: 'GView open a.temp --type:PE'    
    --selectType             Specify the type of the file should be manually selected
                             Ex: 'GView open a.temp --selectType'   
+And <options> for 'scan' are:
+   --output:<file>          Writes the results (JSONL) in a file instead of stdout
+   --threads:<n>            Number of worker threads (default: all CPUs)
+   --maxSize:<n>            Skips files larger than <n> bytes
+   --noRecursive            Does not enter subfolders
+   --stats                  Shows type plugins statistics at the end
 )HELP";
 
 void ShowHelp()
@@ -193,6 +207,82 @@ int ProcessOpenCommand(int argc, T** argv, int startIndex, bool isTesting = fals
     return 0;
 }
 
+template <typename T>
+int ProcessScanCommand(int argc, T** argv, int startIndex)
+{
+    GView::App::ScanSettings settings;
+    std::vector<std::filesystem::path> paths;
+    LocalString<256> tempString;
+    bool showStats = false;
+
+    for (auto start = startIndex; start < argc; start++)
+    {
+        if (argv[start][0] != '-')
+        {
+            paths.emplace_back(argv[start]);
+            continue;
+        }
+        // options are always in ASCII format (except for the output file)
+        if (argv[start][1] == '-' && std::filesystem::path(argv[start]).u16string().starts_with(u"--output:"))
+        {
+            settings.output = std::filesystem::path(argv[start]).u16string().substr(9);
+            continue;
+        }
+        tempString.Clear();
+        const T* p = argv[start];
+        while ((*p))
+        {
+            tempString.AddChar(static_cast<char>(*p));
+            p++;
+        }
+        if (tempString.StartsWith("--threads:", true))
+        {
+            settings.threads = Number::ToUInt32(tempString.ToStringView().substr(10)).value_or(0);
+            continue;
+        }
+        if (tempString.StartsWith("--maxSize:", true))
+        {
+            settings.maxFileSize = Number::ToUInt64(tempString.ToStringView().substr(10)).value_or(0);
+            continue;
+        }
+        if (tempString.Equals("--noRecursive", true))
+        {
+            settings.recursive = false;
+            continue;
+        }
+        if (tempString.Equals("--stats", true))
+        {
+            showStats = true;
+            continue;
+        }
+        std::cout << "Unknown option: " << tempString.ToStringView() << std::endl;
+        std::cout << "Type 'GView help' for a detailed list of available options" << std::endl;
+        return 1;
+    }
+    if (paths.empty())
+    {
+        std::cout << "Missing files or folders to scan" << std::endl;
+        return 1;
+    }
+
+    auto result = GView::App::Scan(paths, settings);
+
+    if (showStats)
+    {
+        GView::App::TypePluginStats stats;
+        auto cnt = GView::App::GetTypePluginsCount();
+        std::cerr << std::left << std::setw(15) << "Type" << std::setw(10) << "Probes" << std::setw(10) << "Matches" << "Time (us)" << std::endl;
+        for (auto index = 0U; index < cnt; index++)
+        {
+            if (!GView::App::GetTypePluginStats(index, stats) || stats.probes == 0)
+                continue;
+            std::cerr << std::left << std::setw(15) << GView::App::GetTypePluginName(index) << std::setw(10) << stats.probes << std::setw(10)
+                      << stats.matches << stats.totalMicroseconds << std::endl;
+        }
+    }
+    return result ? 0 : 1;
+}
+
 #ifdef BUILD_FOR_WINDOWS
 int wmain(int argc, const wchar_t** argv)
 #else
@@ -226,6 +316,8 @@ int main(int argc, const char** argv)
         }
         return ProcessOpenCommand(argc, argv, 2, true);
     }
+    case CommandID::Scan:
+        return ProcessScanCommand(argc, argv, 2);
     case CommandID::Unknown:
         return ProcessOpenCommand(argc, argv, 1);
     default:
@@ -6,6 +6,9 @@
 #include <AppCUI/include/AppCUI.hpp>
 #include <filesystem>
 #include <vector>
+#include <map>
+#include <array>
+#include <functional>
 #include <cstdint>
 
 using namespace AppCUI::Controls;
@@ -468,6 +471,72 @@ namespace Hashes
       private:
         char hexDigest[(sizeof(hash) / sizeof(hash[0])) * 2];
     };
+
+    // hashes every `blockSize` bytes separately (the last block can be smaller)
+    class CORE_EXPORT PiecewiseHash
+    {
+      public:
+        PiecewiseHash(OpenSSLHashKind kind, uint32 blockSize);
+        ~PiecewiseHash();
+
+        bool Update(const void* input, uint32 length);
+        bool Final();
+        inline const std::vector<std::string>& GetBlocks() const
+        {
+            return blocks;
+        }
+        inline uint32 GetBlockSize() const
+        {
+            return blockSize;
+        }
+
+      private:
+        OpenSSLHashKind kind;
+        OpenSSLHash* current;
+        uint32 blockSize;
+        uint32 blockLeft;
+        std::vector<std::string> blocks;
+    };
+
+    // Memoizes the digests computed for a file (algorithm, offset, size -> hex digest). The results are saved in a per
+    // user cache folder (or next to the analyzed file as "<file>.hashes.cache" if "Config.HashCacheSameLocationAsAnalyzedFile"
+    // is set in the [GView] section) and are dropped when the size, the last write time or the first / last 64K of the
+    // file change. Objects that are not files (processes, memory buffers) are not cached.
+    class CORE_EXPORT HashCache
+    {
+      public:
+        static constexpr uint32 DEFAULT_BLOCK_SIZE = 0x100000;
+
+        // the Add / AddBlocks calls made while a batch exists are saved only once (when the batch is destroyed)
+        class CORE_EXPORT Batch
+        {
+            Reference<Object> object;
+
+          public:
+            Batch(Reference<Object> object);
+            ~Batch();
+        };
+
+        static bool Find(Reference<Object> object, std::string_view algorithm, uint64 offset, uint64 size, std::string& digest);
+        static bool Add(Reference<Object> object, std::string_view algorithm, uint64 offset, uint64 size, std::string_view digest);
+        static bool Add(Reference<Object> object, uint64 offset, uint64 size, const std::map<std::string, std::string>& digests);
+        static bool FindBlocks(
+              Reference<Object> object, std::string_view algorithm, uint64 offset, uint64 size, uint32 blockSize, std::vector<std::string>& blocks);
+        static bool AddBlocks(
+              Reference<Object> object, std::string_view algorithm, uint64 offset, uint64 size, uint32 blockSize, const std::vector<std::string>& blocks);
+
+        // digest of [offset, offset + size) and the digests of its blocks, in a single pass (or from the cache)
+        static bool Compute(
+              Reference<Object> object,
+              OpenSSLHashKind kind,
+              uint64 offset,
+              uint64 size,
+              uint32 blockSize,
+              std::string& digest,
+              std::vector<std::string>& blocks);
+
+        static std::string_view GetAlgorithmName(OpenSSLHashKind kind);
+    };
 } // namespace Hashes
 
 namespace DigitalSignature
@@ -728,9 +797,48 @@ namespace Decoding
 {
     namespace Base64
     {
+        // whitespaces (' ', '\t', '\r', '\n', '\f', '\v') are skipped in all the modes
+        enum class Mode : uint8 {
+            Strict,   // only the alphabet and a complete padding are accepted, nothing may follow the padding
+            Tolerant, // only the alphabet is accepted, the padding is optional and the data after it is ignored (with a warning)
+            Lenient,  // like Tolerant, but the characters that are not part of the alphabet are ignored as well
+        };
+
+        // decodes data that arrives in chunks; the decoded bytes are appended to the output
+        class CORE_EXPORT Decoder
+        {
+            Mode mode;
+            uint32 quantum; // bits of the characters that did not form 3 bytes yet
+            uint32 quantumCount;
+            uint32 paddingCount;
+            uint32 expectedPadding;
+            bool ended; // the padding was found
+            bool ignoreRest;
+            const char* warning;
+
+            bool DecodeCharacters(const uint8*& p, const uint8* e, uint8*& out);
+
+          public:
+            Decoder(Mode mode = Mode::Tolerant);
+            void Reset();
+            bool Add(BufferView view, Buffer& output);
+            bool Finish(Buffer& output);
+            inline bool HasWarning() const
+            {
+                return warning != nullptr;
+            }
+            inline const char* GetWarning() const
+            {
+                return warning ? warning : "";
+            }
+        };
+
+        CORE_EXPORT uint64 GetEncodedSize(uint64 size);
+        CORE_EXPORT uint64 GetMaxDecodedSize(uint64 size);
         CORE_EXPORT void Encode(BufferView view, Buffer& output);
-        CORE_EXPORT bool Decode(BufferView view, Buffer& output, bool& hasWarning, String& warningMessage);
-        CORE_EXPORT bool Decode(BufferView view, Buffer& output);
+        CORE_EXPORT bool Decode(BufferView view, Buffer& output, Mode mode, bool& hasWarning, String& warningMessage);
+        CORE_EXPORT bool Decode(BufferView view, Buffer& output, bool& hasWarning, String& warningMessage); // tolerant
+        CORE_EXPORT bool Decode(BufferView view, Buffer& output);                                           // tolerant
     } // namespace Base64
 
     namespace LZXPRESS::Huffman
@@ -770,8 +878,70 @@ namespace Decoding
 
     namespace ZLIB
     {
+        enum class Format : uint8 {
+            Auto, // zlib or gzip if the data starts with their header, raw deflate otherwise
+            Raw,
+            ZLIB,
+            GZIP
+        };
+
+        // guard against decompression bombs
+        constexpr uint64 DEFAULT_MAX_OUTPUT_SIZE = 0x40000000ULL;
+
+        // receives the decompressed data in chunks; returning false stops the decompression
+        using OutputCallback = std::function<bool(BufferView chunk)>;
+
+        // decompresses a stream that arrives in chunks, with a fixed amount of memory
+        class CORE_EXPORT Inflater
+        {
+            void* stream; // z_stream
+            Buffer window;
+            Format format;
+            uint64 maxOutputSize;
+            uint64 outputSize;
+            uint8 header[2];
+            uint32 headerSize;
+            bool finished;
+            std::string message;
+
+            bool Start(Format streamFormat);
+            bool Inflate(const uint8* data, uint64 size, const OutputCallback& output, uint64& sizeConsumed);
+
+          public:
+            Inflater();
+            ~Inflater();
+            Inflater(const Inflater&)            = delete;
+            Inflater& operator=(const Inflater&) = delete;
+
+            bool Init(Format format = Format::Auto, uint64 maxOutputSize = DEFAULT_MAX_OUTPUT_SIZE);
+            // sizeConsumed < input.GetLength() only if the stream ends inside this chunk
+            bool Add(BufferView input, const OutputCallback& output, uint64& sizeConsumed);
+            inline bool IsFinished() const
+            {
+                return finished;
+            }
+            inline uint64 GetOutputSize() const
+            {
+                return outputSize;
+            }
+            inline const char* GetMessage() const
+            {
+                return message.c_str();
+            }
+        };
+
+        CORE_EXPORT Format DetectFormat(BufferView input);
         CORE_EXPORT bool Decompress(const Buffer& input, uint64 inputSize, Buffer& output, uint64 outputSize);
-        CORE_EXPORT bool DecompressStream(const BufferView& input, Buffer& output, String& message, uint64& sizeConsumed);
+        CORE_EXPORT bool DecompressStream(const BufferView& input, Buffer& output, String& message, uint64& sizeConsumed); // zlib only
+        CORE_EXPORT bool DecompressStream(
+              const BufferView& input, Buffer& output, String& message, uint64& sizeConsumed, Format format, uint64 maxOutputSize);
+        CORE_EXPORT bool DecompressStream(
+              const BufferView& input,
+              const OutputCallback& output,
+              String& message,
+              uint64& sizeConsumed,
+              Format format        = Format::Auto,
+              uint64 maxOutputSize = DEFAULT_MAX_OUTPUT_SIZE);
     } // namespace ZLIB
 
     namespace ZIP
@@ -946,8 +1116,48 @@ namespace Regex
 
 namespace Entropy
 {
+    using Frequencies = std::array<uint32, 256>;
+
     CORE_EXPORT double ShannonEntropy(const BufferView& buffer);
     CORE_EXPORT double RenyiEntropy(const BufferView& buffer, double alpha);
+
+    // histogram based variants (the frequencies of several buffers can be added together)
+    CORE_EXPORT void AddFrequencies(const BufferView& buffer, Frequencies& frequency);
+    CORE_EXPORT double ShannonEntropy(const Frequencies& frequency, uint64 count);
+    CORE_EXPORT double RenyiEntropy(const Frequencies& frequency, uint64 count, double alpha);
+
+    // Shannon entropy of the last `windowSize` bytes, updated in O(1) for every new byte
+    class CORE_EXPORT SlidingWindowEntropy
+    {
+        std::vector<uint8> window;
+        std::vector<double> weights; // weights[f] = f * log2(f)
+        Frequencies frequency;
+        uint32 position;
+        uint32 count;
+        uint32 steps; // updates since the sum was last rebuilt from the frequencies
+        double sum;   // sum of weights[frequency[i]]
+
+        void Resync();
+
+      public:
+        SlidingWindowEntropy(uint32 windowSize);
+        void Reset();
+        void Add(uint8 value);
+        void Add(const BufferView& buffer);
+        double GetShannonEntropy() const;
+        inline uint32 GetCount() const
+        {
+            return count;
+        }
+        inline uint32 GetWindowSize() const
+        {
+            return static_cast<uint32>(window.size());
+        }
+        inline bool IsFull() const
+        {
+            return count == window.size();
+        }
+    };
 } // namespace Entropy
 
 namespace Security
@@ -1073,10 +1283,15 @@ namespace View
         uint64 viewSize{ GView::Utils::INVALID_OFFSET };
         uint64 cursorStartOffset{ GView::Utils::INVALID_OFFSET };
         unsigned char byte{ 0 };
+        Reference<GView::Object> object; // the object shown by the view that generated the data
     };
 
     struct CORE_EXPORT BufferColorInterface {
         virtual bool GetColorForByteAt(uint64 offset, const ViewData& vd, ColorPair& cp) = 0;
+        // called once before the view colors its bytes (whatever is shared by all the bytes of a paint goes here)
+        virtual void OnPaintStart(const ViewData&)
+        {
+        }
     };
 
     struct CORE_EXPORT OnStartViewMoveInterface {
@@ -1233,6 +1448,8 @@ namespace View
             void SetTabSize(uint32 tabSize);
             void ShowTabCharacter(bool show);
             void HightlightCurrentLine(bool highlight);
+            // the line index keeps the start of every `count`-th line (more lines => less memory, slower random access)
+            void SetLinesPerCheckpoint(uint32 count);
             bool SetName(std::string_view name);
         };
     }; // namespace TextViewer
@@ -1311,13 +1528,22 @@ namespace View
         };
         class CORE_EXPORT TextEditor
         {
+          public:
+            // [start, start + size) from the current text replaced "originalSize" characters from the original one
+            struct EditedRegion
+            {
+                uint32 start, size, originalSize;
+            };
+
           protected:
             bool Grow(size_t size);
+            void MarkAsEdited(uint32 offset, uint32 removedCount, uint32 insertedCount);
 
           protected:
             char16* text;
             uint32 size;
             uint32 allocated;
+            std::vector<EditedRegion> editedRegions; // sorted, they do not overlap or touch each other
 
             TextEditor();
 
@@ -1339,7 +1565,11 @@ namespace View
             void Clear();
             bool Reserve(uint32 charactersCount);
 
-            char16& operator[](uint32 index);
+            char16& operator[](uint32 index); // the character is marked as edited => use GetChar to only read it
+            inline char16 GetChar(uint32 index) const
+            {
+                return index < size ? text[index] : 0;
+            }
 
             inline uint32 Len() const
             {
@@ -1349,6 +1579,14 @@ namespace View
             {
                 return { text, (size_t) size };
             }
+            inline const std::vector<EditedRegion>& GetEditedRegions() const
+            {
+                return editedRegions;
+            }
+            inline void ClearEditedRegions()
+            {
+                editedRegions.clear();
+            }
         };
         enum class TokenDataType : uint8 { None, String, Number, MetaInformation, Boolean };
         enum class TokenAlignament : uint32 {
@@ -1713,6 +1951,20 @@ namespace View
 namespace App
 {
     enum class OpenMethod { FirstMatch, BestMatch, Select, ForceType };
+    struct TypePluginStats {
+        uint32 probes;            // how many times `Validate` was called
+        uint32 matches;           // how many times `Validate` returned true
+        uint32 cacheHits;         // how many times the result was taken from the identification cache
+        uint64 totalMicroseconds; // time spent in `Validate`
+        uint64 maxMicroseconds;   // slowest `Validate` call
+    };
+    struct ScanSettings {
+        std::filesystem::path output; // JSONL file (if empty the results are written to stdout)
+        uint32 threads{ 0 };          // 0 => one worker for each hardware thread
+        uint32 maxQueuedFiles{ 0 };   // 0 => 16 files for each worker
+        uint64 maxFileSize{ 0 };      // 0 => no limit
+        bool recursive{ true };
+    };
     bool CORE_EXPORT Init(bool isTestingEnabled);
     void CORE_EXPORT Run(std::string_view testing_script);
     bool CORE_EXPORT ResetConfiguration();
@@ -1737,6 +1989,9 @@ namespace App
     std::string_view CORE_EXPORT GetTypePluginName(uint32 index);
     std::string_view CORE_EXPORT GetTypePluginDescription(uint32 index);
     uint32 CORE_EXPORT GetTypePluginsCount();
+    bool CORE_EXPORT GetTypePluginStats(uint32 index, TypePluginStats& stats);
+    bool CORE_EXPORT Scan(const std::vector<std::filesystem::path>& paths, const ScanSettings& settings);
+    bool CORE_EXPORT HasUI(); // false for the headless commands (scan) => no dialogs
     bool CORE_EXPORT ShowAddNoteDialog();
 
 }; // namespace App
@@ -13,6 +13,7 @@ using namespace AppCUI::Input;
 using namespace AppCUI::Utils;
 
 GView::App::Instance* gviewAppInstance = nullptr;
+bool hasUI                              = false;
 
 constexpr uint32 DEFAULT_CACHE_SIZE = 0xA00000; // 10 MB // sync this with the one from App/Instance.cpp
 
@@ -52,8 +53,13 @@ bool GView::App::Init(bool isTestingEnabled)
         delete gviewAppInstance;
         RETURNERROR(false, "Fail to initialize GView app");
     }
+    hasUI = true;
     return true;
 }
+bool GView::App::HasUI()
+{
+    return hasUI;
+}
 void GView::App::Run(std::string_view testing_script)
 {
     if (gviewAppInstance)
@@ -101,6 +107,7 @@ bool GView::App::ResetConfiguration()
 
     // generic GView settings
     ini["GView"]["CacheSize"]        = DEFAULT_CACHE_SIZE;
+    ini["GView"]["Config.HashCacheSameLocationAsAnalyzedFile"] = false;
 
     const std::array<std::reference_wrapper<KeyboardControl>, 6> localKeys = {
         InstanceCommands::INSTANCE_CHANGE_VIEW,     InstanceCommands::INSTANCE_SWITCH_TO_VIEW, InstanceCommands::INSTANCE_COMMAND_GOTO,
@@ -183,6 +190,25 @@ uint32 CORE_EXPORT GView::App::GetTypePluginsCount()
     CHECK(gviewAppInstance, 0, "GView was not initialized !");
     return gviewAppInstance->GetTypePluginsCount();
 }
+bool GView::App::GetTypePluginStats(uint32 index, TypePluginStats& stats)
+{
+    CHECK(gviewAppInstance, false, "GView was not initialized !");
+    return gviewAppInstance->GetTypePluginStats(index, stats);
+}
+bool GView::App::Scan(const std::vector<std::filesystem::path>& paths, const ScanSettings& settings)
+{
+    if (gviewAppInstance == nullptr)
+    {
+        gviewAppInstance = new GView::App::Instance();
+        if (!gviewAppInstance->InitHeadless())
+        {
+            delete gviewAppInstance;
+            gviewAppInstance = nullptr;
+            RETURNERROR(false, "Fail to initialize GView (headless)");
+        }
+    }
+    return gviewAppInstance->Scan(paths, settings);
+}
 
 void FileWindow::ShowFilePropertiesDialog()
 {
@@ -1,5 +1,8 @@
 #include "Internal.hpp"
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 using namespace GView::App;
 using namespace GView::App::InstanceCommands;
@@ -15,6 +18,9 @@ constexpr uint32 GENERIC_PLUGINS_FRAME = 100;
 
 constexpr uint32 CACHE_SIZE_PROPERTY_ID = 1;
 
+constexpr size_t MAX_IDENTIFICATION_CACHE_ENTRIES = 0x4000;
+constexpr uint32 MAX_VALIDATION_THREADS           = 8;
+
 struct GViewMenuCommand {
     std::string_view name;
     int commandID;
@@ -82,11 +88,36 @@ Instance::Instance()
     this->mnuFile                  = nullptr;
     this->lastOpenedFolderLocation = ".";
 }
-bool Instance::LoadSettings()
+bool Instance::LoadSettings(AppCUI::Utils::IniObject* ini)
 {
-    auto ini = AppCUI::Application::GetAppSettings();
     CHECK(ini, false, "");
     CHECK(ini->GetSectionsCount() > 0, false, "");
+
+    // the plugins are taken from the registry (if it is still valid) to avoid parsing all the plugin sections
+    const auto settingsPath = AppCUI::Application::GetAppSettingsFile();
+    if (PluginRegistry::Load(settingsPath, this->typePlugins, this->genericPlugins, this->defaultCacheSize) == false) {
+        CHECK(LoadPlugins(ini), false, "");
+        if (!PluginRegistry::Save(settingsPath, this->typePlugins, this->genericPlugins, this->defaultCacheSize)) {
+            errList.AddWarning("Fail to save the plugin registry (%s)", PluginRegistry::GetPath(settingsPath).u8string().c_str());
+        }
+    }
+    IndexTypePlugins();
+
+    // read instance settings
+    auto sect                                  = ini->GetSection("GView");
+    this->defaultCacheSize                     = std::max<>(sect.GetValue("Config.CacheSize").ToUInt32(DEFAULT_CACHE_SIZE), MIN_CACHE_SIZE);
+
+    LocalString<64> keyCommand;
+    for (auto& k : GViewCommands) {
+        keyCommand.SetFormat("Key.%s", k->Caption);
+        k->Key = sect.GetValue(keyCommand.GetText()).ToKey(k->Key);
+    }
+    return true;
+}
+bool Instance::LoadPlugins(AppCUI::Utils::IniObject* ini)
+{
+    this->typePlugins.clear();
+    this->genericPlugins.clear();
     // check plugins
     for (auto section : *ini) {
         auto sectionName = section.GetName();
@@ -108,20 +139,19 @@ bool Instance::LoadSettings()
         }
     }
 
-    // sort all plugins based on their priority
+    // sort all plugins based on their priority (the registry keeps them in this order)
     std::sort(this->typePlugins.begin(), this->typePlugins.end());
 
-    // read instance settings
-    auto sect                                  = ini->GetSection("GView");
-    this->defaultCacheSize                     = std::max<>(sect.GetValue("Config.CacheSize").ToUInt32(DEFAULT_CACHE_SIZE), MIN_CACHE_SIZE);
-
-    LocalString<64> keyCommand;
-    for (auto& k : GViewCommands) {
-        keyCommand.SetFormat("Key.%s", k->Caption);
-        k->Key = sect.GetValue(keyCommand.GetText()).ToKey(k->Key);
-    }
+    auto sect              = ini->GetSection("GView");
+    this->defaultCacheSize = std::max<>(sect.GetValue("Config.CacheSize").ToUInt32(DEFAULT_CACHE_SIZE), MIN_CACHE_SIZE);
     return true;
 }
+void Instance::IndexTypePlugins()
+{
+    this->typePluginsIndex.Build(this->typePlugins);
+    this->typePluginsStats.assign(this->typePlugins.size(), TypePluginStats{});
+    this->identificationCache.clear();
+}
 bool Instance::BuildMainMenus()
 {
     CHECK(mnuFile = AppCUI::Application::AddMenu("File"), false, "Unable to create 'File' menu");
@@ -169,7 +199,7 @@ bool Instance::Init(bool isTestingEnabled)
     }
     // reserve some space fo type
     this->typePlugins.reserve(128);
-    if (!LoadSettings()) {
+    if (!LoadSettings(AppCUI::Application::GetAppSettings())) {
         auto preservedSettingsNewPath = settingsPath;
         preservedSettingsNewPath.replace_extension(".ini.bak");
         std::filesystem::rename(settingsPath, preservedSettingsNewPath);
@@ -195,6 +225,24 @@ bool Instance::Init(bool isTestingEnabled)
     dsk->Handlers()->OnStart = this;
     return true;
 }
+bool Instance::InitHeadless()
+{
+    this->typePlugins.reserve(128);
+    this->defaultPlugin.InitDefaultPlugin();
+
+    // a valid registry has everything that is needed (no need to parse the configuration file)
+    const auto settingsPath = AppCUI::Application::GetAppSettingsFile();
+    if (PluginRegistry::Load(settingsPath, this->typePlugins, this->genericPlugins, this->defaultCacheSize)) {
+        IndexTypePlugins();
+        return true;
+    }
+
+    // no AppCUI framework (no terminal) => read the settings directly
+    AppCUI::Utils::IniObject ini;
+    CHECK(ini.CreateFromFile(settingsPath), false, "Fail to read the configuration file (run 'GView reset' first) !");
+    CHECK(LoadSettings(&ini), false, "Invalid configuration file !");
+    return true;
+}
 Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin_WithSelectedType(
       const AppCUI::Utils::ConstString& name,
       const AppCUI::Utils::ConstString& path,
@@ -255,28 +303,122 @@ Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin_Select(
     }
     return nullptr;
 }
+static IdentificationKey ComputeIdentificationKey(AppCUI::Utils::BufferView buf, uint64 extensionHash, OpenMethod method)
+{
+    IdentificationKey key{ .digest = {}, .extensionHash = extensionHash, .method = method };
+    GView::Hashes::OpenSSLHash sha256(GView::Hashes::OpenSSLHashKind::Sha256);
+    sha256.Update(buf.GetData(), static_cast<uint32>(buf.GetLength()));
+    sha256.Final();
+    memcpy(key.digest.data(), sha256.Get(), std::min<size_t>(key.digest.size(), sha256.GetSize()));
+    return key;
+}
+struct TypePluginProbe {
+    bool matched;
+    uint64 microseconds;
+};
+static TypePluginProbe ProbeTypePlugin(const GView::Type::Plugin& plugin, AppCUI::Utils::BufferView buf, std::string_view extension)
+{
+    const auto start  = std::chrono::steady_clock::now();
+    const auto result = plugin.Validate(buf, extension);
+    const auto end    = std::chrono::steady_clock::now();
+    return { result, static_cast<uint64>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()) };
+}
+static void UpdateTypePluginStats(TypePluginStats& stats, const TypePluginProbe& probe)
+{
+    stats.probes++;
+    stats.matches += probe.matched ? 1 : 0;
+    stats.totalMicroseconds += probe.microseconds;
+    stats.maxMicroseconds = std::max<>(stats.maxMicroseconds, probe.microseconds);
+}
+bool Instance::ValidateTypePlugin(uint32 index, AppCUI::Utils::BufferView buf, std::string_view extension)
+{
+    auto& plugin = this->typePlugins[index];
+    if (!plugin.Load())
+        return false;
+    const auto probe = ProbeTypePlugin(plugin, buf, extension);
+    UpdateTypePluginStats(this->typePluginsStats[index], probe);
+    return probe.matched;
+}
+void Instance::ValidateTypePlugins(const std::vector<uint32>& candidates, AppCUI::Utils::BufferView buf, std::vector<bool>& results)
+{
+    // loading a plugin is not thread safe => load all of them first
+    for (auto index : candidates)
+        this->typePlugins[index].Load();
+
+    // `Validate` only reads the (immutable) buffer => candidates can be checked in parallel (by a bounded number of threads)
+    std::vector<TypePluginProbe> probes(candidates.size());
+    std::atomic<size_t> next{ 0 };
+    auto worker = [&]() {
+        for (auto idx = next.fetch_add(1); idx < candidates.size(); idx = next.fetch_add(1))
+            probes[idx] = ProbeTypePlugin(this->typePlugins[candidates[idx]], buf, std::string_view());
+    };
+    const auto threadsCount = std::min<size_t>({ candidates.size(), std::max<uint32>(std::thread::hardware_concurrency(), 1), MAX_VALIDATION_THREADS });
+    std::vector<std::thread> threads;
+    for (size_t idx = 1; idx < threadsCount; idx++)
+        threads.emplace_back(worker);
+    worker();
+    for (auto& th : threads)
+        th.join();
+
+    results.resize(candidates.size());
+    for (size_t idx = 0; idx < candidates.size(); idx++) {
+        UpdateTypePluginStats(this->typePluginsStats[candidates[idx]], probes[idx]);
+        results[idx] = probes[idx].matched;
+    }
+}
+const std::vector<uint32>* Instance::FindIdentification(const IdentificationKey& key)
+{
+    auto it = this->identificationCache.find(key);
+    if (it == this->identificationCache.end())
+        return nullptr;
+    for (auto index : it->second)
+        this->typePluginsStats[index].cacheHits++;
+    return &it->second;
+}
+const std::vector<uint32>* Instance::AddIdentification(const IdentificationKey& key, std::vector<uint32> matches)
+{
+    if (this->identificationCache.size() >= MAX_IDENTIFICATION_CACHE_ENTRIES)
+        this->identificationCache.clear();
+    return &(this->identificationCache[key] = std::move(matches));
+}
 Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin_FirstMatch(
       const string_view& extension, AppCUI::Utils::BufferView buf, GView::Type::Matcher::TextParser& textParser, uint64 extensionHash)
 {
+    const auto key = ComputeIdentificationKey(buf, extensionHash, OpenMethod::FirstMatch);
+    if (auto matches = FindIdentification(key)) {
+        if (matches->empty())
+            return &this->defaultPlugin;
+        return &this->typePlugins[(*matches)[0]];
+    }
+
     // check for extension first
     if (extensionHash != 0) {
-        for (auto& pType : this->typePlugins) {
+        for (auto index : this->typePluginsIndex.GetExtensionCandidates(extensionHash)) {
+            auto& pType = this->typePlugins[index];
             if (pType.MatchExtension(extensionHash)) {
-                if (pType.IsOfType(buf, textParser, extension))
+                if (ValidateTypePlugin(index, buf, extension)) {
+                    AddIdentification(key, { index });
                     return &pType;
+                }
             }
         }
     }
 
     // check the content
-    for (auto& pType : this->typePlugins) {
+    std::vector<uint32> candidates;
+    this->typePluginsIndex.GetContentCandidates(buf, textParser, candidates);
+    for (auto index : candidates) {
+        auto& pType = this->typePlugins[index];
         if (pType.MatchContent(buf, textParser)) {
-            if (pType.IsOfType(buf, textParser))
+            if (ValidateTypePlugin(index, buf, "")) {
+                AddIdentification(key, { index });
                 return &pType;
+            }
         }
     }
 
     // nothing matched => return the default plugin
+    AddIdentification(key, {});
     return &this->defaultPlugin;
 }
 Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin_BestMatch(
@@ -288,35 +430,49 @@ Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin_BestMatch(
       uint64 extensionHash,
       std::u16string& newName)
 {
-    auto plg   = &this->defaultPlugin;
-    auto count = 0;
-    if (extensionHash != 0) {
-        for (auto& pType : this->typePlugins) {
-            if (pType.MatchExtension(extensionHash)) {
-                if (pType.IsOfType(buf, textParser)) {
-                    count++;
-                    plg = &pType;
-                    if (count > 1) // at least two options
-                        return IdentifyTypePlugin_Select(name, path, dataSize, buf, textParser, extensionHash, newName);
-                }
+    const auto key = ComputeIdentificationKey(buf, extensionHash, OpenMethod::BestMatch);
+    auto cached    = FindIdentification(key);
+    if (cached == nullptr) {
+        // extension matches first and content matches after that (a plugin can be in both lists)
+        std::vector<uint32> probes;
+        if (extensionHash != 0) {
+            for (auto index : this->typePluginsIndex.GetExtensionCandidates(extensionHash)) {
+                if (this->typePlugins[index].MatchExtension(extensionHash))
+                    probes.push_back(index);
             }
         }
-    }
+        std::vector<uint32> candidates;
+        this->typePluginsIndex.GetContentCandidates(buf, textParser, candidates);
+        for (auto index : candidates) {
+            if (this->typePlugins[index].MatchContent(buf, textParser))
+                probes.push_back(index);
+        }
 
-    // check the content
-    for (auto& pType : this->typePlugins) {
-        if (pType.MatchContent(buf, textParser)) {
-            if (pType.IsOfType(buf, textParser)) {
-                count++;
-                plg = &pType;
-                if (count > 1) // at least two options
-                    return IdentifyTypePlugin_Select(name, path, dataSize, buf, textParser, extensionHash, newName);
-            }
+        // validate every plugin only once
+        candidates = probes;
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        std::vector<bool> results;
+        ValidateTypePlugins(candidates, buf, results);
+
+        std::vector<uint32> matches;
+        for (auto index : probes) {
+            auto pos = std::lower_bound(candidates.begin(), candidates.end(), index) - candidates.begin();
+            if (results[pos])
+                matches.push_back(index);
         }
+
+        cached = AddIdentification(key, std::move(matches));
     }
 
+    const auto& matches = *cached;
+    if (matches.size() > 1) // at least two options
+        return IdentifyTypePlugin_Select(name, path, dataSize, buf, textParser, extensionHash, newName);
+    if (matches.size() == 1)
+        return &this->typePlugins[matches[0]];
+
     // nothing matched => return the default plugin
-    return plg;
+    return &this->defaultPlugin;
 }
 Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin(
       const AppCUI::Utils::ConstString& name,
@@ -538,6 +694,12 @@ std::string_view Instance::GetTypePluginDescription(uint32 index)
         return "";
     return this->typePlugins[index].GetDescription();
 }
+bool Instance::GetTypePluginStats(uint32 index, TypePluginStats& stats)
+{
+    CHECK(index < this->typePluginsStats.size(), false, "Invalid type plugin index: %u", index);
+    stats = this->typePluginsStats[index];
+    return true;
+}
 
 //===============================[APPCUI HANDLERS]==============================
 bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
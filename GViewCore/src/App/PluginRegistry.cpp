@@ -0,0 +1,363 @@
+#include "Internal.hpp"
+
+using namespace GView::App;
+
+namespace
+{
+constexpr uint32 REGISTRY_MAGIC   = 0x52505647; // GVPR
+constexpr uint32 REGISTRY_VERSION = 2;
+
+struct FileStamp
+{
+    uint64 size;
+    int64 lastWriteTime;
+
+    bool operator==(const FileStamp& other) const = default;
+};
+
+FileStamp GetFileStamp(const std::filesystem::path& path)
+{
+    // a missing file has an empty stamp (if it appears later, the registry is rebuilt)
+    std::error_code ec;
+    FileStamp stamp{ 0, 0 };
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec)
+        return stamp;
+    auto time = std::filesystem::last_write_time(path, ec);
+    if (ec)
+        return stamp;
+    stamp.size          = size;
+    stamp.lastWriteTime = static_cast<int64>(time.time_since_epoch().count());
+    return stamp;
+}
+
+uint64 GetPluginSettingsHash(const std::filesystem::path& settingsPath)
+{
+    // only the plugin sections (and the cache size) are stored in the registry => other settings can be saved in the
+    // configuration file (e.g. the options of a dialog) without invalidating it
+    auto content = AppCUI::OS::File::ReadContent(settingsPath);
+    std::string_view text{ reinterpret_cast<const char*>(content.GetData()), content.GetLength() };
+
+    uint64 hash         = 0xcbf29ce484222325ULL;
+    bool pluginSection  = false;
+    bool generalSection = false;
+    while (!text.empty())
+    {
+        auto pos  = text.find('\n');
+        auto line = text.substr(0, pos);
+        text      = pos == std::string_view::npos ? std::string_view() : text.substr(pos + 1);
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t'))
+            line.remove_suffix(1);
+        while (!line.empty() && (line.front() == ' ' || line.front() == '\t'))
+            line.remove_prefix(1);
+
+        if (line.starts_with('['))
+        {
+            auto name      = line.substr(1);
+            pluginSection  = String::StartsWith(name, "type.", true) || String::StartsWith(name, "generic.", true);
+            generalSection = String::StartsWith(name, "GView]", true);
+        }
+        const auto hashLine = pluginSection || (generalSection && String::StartsWith(line, "Config.CacheSize", true));
+        if (!hashLine)
+            continue;
+        for (auto ch : line)
+            hash = (hash ^ static_cast<uint8>(ch)) * 0x00000100000001B3ULL;
+        hash = (hash ^ '\n') * 0x00000100000001B3ULL;
+    }
+    return hash;
+}
+
+std::filesystem::path GetGenericPluginPath(std::string_view name)
+{
+    auto path = AppCUI::OS::GetCurrentApplicationPath();
+    path.remove_filename();
+    path /= "GenericPlugins";
+    path /= "lib";
+    path += name;
+    path += ".gpl";
+    return path;
+}
+
+class RegistryWriter
+{
+    std::vector<uint8> data;
+
+  public:
+    template <typename T>
+    void Add(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        auto p = reinterpret_cast<const uint8*>(&value);
+        data.insert(data.end(), p, p + sizeof(T));
+    }
+    void AddBuffer(BufferView value)
+    {
+        Add(static_cast<uint16>(value.GetLength()));
+        data.insert(data.end(), value.GetData(), value.GetData() + value.GetLength());
+    }
+    void AddString(std::string_view value)
+    {
+        AddBuffer({ value.data(), value.size() });
+    }
+    inline BufferView GetData() const
+    {
+        return { data.data(), data.size() };
+    }
+};
+
+class RegistryReader
+{
+    const uint8* p;
+    const uint8* e;
+
+  public:
+    RegistryReader(BufferView buf) : p(buf.GetData()), e(buf.GetData() + buf.GetLength())
+    {
+    }
+    template <typename T>
+    bool Get(T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        CHECK(p + sizeof(T) <= e, false, "");
+        memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        return true;
+    }
+    bool GetBuffer(BufferView& value)
+    {
+        uint16 size;
+        CHECK(Get(size), false, "");
+        CHECK(p + size <= e, false, "");
+        value = { p, size };
+        p += size;
+        return true;
+    }
+    bool GetString(std::string_view& value)
+    {
+        BufferView buf;
+        CHECK(GetBuffer(buf), false, "");
+        value = { reinterpret_cast<const char*>(buf.GetData()), buf.GetLength() };
+        return true;
+    }
+    inline bool IsEOF() const
+    {
+        return p == e;
+    }
+};
+
+void WriteMatcher(RegistryWriter& w, GView::Type::Matcher::Interface* m)
+{
+    using namespace GView::Type::Matcher;
+    auto kind = m->GetKind();
+    w.Add(kind);
+    switch (kind)
+    {
+    case Kind::Magic:
+        w.AddBuffer(static_cast<MagicMatcher*>(m)->GetValue());
+        break;
+    case Kind::StartsWith:
+        w.AddString(static_cast<StartsWithMatcher*>(m)->GetValue());
+        break;
+    case Kind::LineStartsWith:
+        w.AddString(static_cast<LineStartsWithMatcher*>(m)->GetValue());
+        break;
+    }
+}
+GView::Type::Matcher::Interface* ReadMatcher(RegistryReader& r)
+{
+    GView::Type::Matcher::Kind kind;
+    BufferView value;
+    CHECK(r.Get(kind), nullptr, "");
+    CHECK(r.GetBuffer(value), nullptr, "");
+    return GView::Type::Matcher::Create(kind, value);
+}
+} // namespace
+
+std::filesystem::path PluginRegistry::GetPath(const std::filesystem::path& settingsPath)
+{
+    auto path = settingsPath;
+    path.replace_extension(".registry");
+    return path;
+}
+
+bool PluginRegistry::Save(
+      const std::filesystem::path& settingsPath,
+      const std::vector<Type::Plugin>& typePlugins,
+      const std::vector<Generic::Plugin>& genericPlugins,
+      uint32 cacheSize)
+{
+    RegistryWriter w;
+    w.Add(REGISTRY_MAGIC);
+    w.Add(REGISTRY_VERSION);
+    w.Add(GetPluginSettingsHash(settingsPath));
+    w.Add(cacheSize);
+
+    w.Add(static_cast<uint32>(typePlugins.size()));
+    for (const auto& plugin : typePlugins)
+    {
+        w.AddString(plugin.name);
+        w.AddString(plugin.description);
+        w.Add(plugin.priority);
+        w.Add(plugin.extension);
+        w.Add(static_cast<uint32>(plugin.extensions.size()));
+        for (auto hash : plugin.extensions)
+            w.Add(hash);
+        w.Add(static_cast<uint8>(plugin.pattern != nullptr));
+        if (plugin.pattern)
+            WriteMatcher(w, plugin.pattern);
+        w.Add(static_cast<uint32>(plugin.patterns.size()));
+        for (auto p : plugin.patterns)
+            WriteMatcher(w, p);
+        w.Add(static_cast<uint32>(plugin.commands.size()));
+        for (const auto& cmd : plugin.commands)
+        {
+            w.AddString(cmd.name);
+            w.Add(cmd.key);
+        }
+        w.Add(GetFileStamp(Type::Plugin::GetPluginPath(plugin.GetName())));
+    }
+
+    w.Add(static_cast<uint32>(genericPlugins.size()));
+    for (const auto& plugin : genericPlugins)
+    {
+        w.AddString(plugin.Name);
+        w.Add(plugin.CommandsCount);
+        for (auto idx = 0U; idx < plugin.CommandsCount; idx++)
+        {
+            w.AddString(plugin.Commands[idx].Name);
+            w.Add(plugin.Commands[idx].ShortKey);
+        }
+        w.Add(GetFileStamp(GetGenericPluginPath(plugin.Name)));
+    }
+
+    CHECK(AppCUI::OS::File::WriteContent(GetPath(settingsPath), w.GetData()), false, "Fail to write the plugin registry");
+    return true;
+}
+
+void PluginRegistry::ReleaseMatchers(std::vector<Type::Plugin>& typePlugins)
+{
+    for (auto& plugin : typePlugins)
+    {
+        delete plugin.pattern;
+        plugin.pattern = nullptr;
+        for (auto m : plugin.patterns)
+            delete m;
+        plugin.patterns.clear();
+    }
+}
+
+bool PluginRegistry::Load(
+      const std::filesystem::path& settingsPath,
+      std::vector<Type::Plugin>& typePlugins,
+      std::vector<Generic::Plugin>& genericPlugins,
+      uint32& cacheSize)
+{
+    auto content = AppCUI::OS::File::ReadContent(GetPath(settingsPath));
+    if (content.GetLength() == 0)
+        return false; // no registry (yet)
+
+    std::vector<Type::Plugin> types;
+    std::vector<Generic::Plugin> generics;
+    if (!Read(content, settingsPath, types, generics, cacheSize))
+    {
+        // the matchers of the plugins read so far are not used by anyone
+        ReleaseMatchers(types);
+        return false;
+    }
+
+    typePlugins    = std::move(types);
+    genericPlugins = std::move(generics);
+    return true;
+}
+
+bool PluginRegistry::Read(
+      BufferView content,
+      const std::filesystem::path& settingsPath,
+      std::vector<Type::Plugin>& types,
+      std::vector<Generic::Plugin>& generics,
+      uint32& cacheSize)
+{
+    RegistryReader r(content);
+    uint32 magic, version, count;
+    uint64 settingsHash;
+    FileStamp stamp;
+    CHECK(r.Get(magic) && (magic == REGISTRY_MAGIC), false, "Invalid plugin registry");
+    CHECK(r.Get(version) && (version == REGISTRY_VERSION), false, "Unsupported plugin registry version");
+    CHECK(r.Get(settingsHash), false, "");
+    // the plugin sections were changed since the registry was created
+    if (settingsHash != GetPluginSettingsHash(settingsPath))
+        return false;
+    CHECK(r.Get(cacheSize), false, "");
+
+    std::string_view text;
+    uint8 hasPattern;
+
+    CHECK(r.Get(count), false, "");
+    types.reserve(std::max<uint32>(count, 128));
+    for (auto idx = 0U; idx < count; idx++)
+    {
+        auto& plugin = types.emplace_back();
+        CHECK(r.GetString(text), false, "");
+        plugin.name.Set(text);
+        CHECK(r.GetString(text), false, "");
+        plugin.description.Set(text);
+        CHECK(r.Get(plugin.priority), false, "");
+        CHECK(r.Get(plugin.extension), false, "");
+
+        uint32 itemsCount;
+        CHECK(r.Get(itemsCount), false, "");
+        for (auto i = 0U; i < itemsCount; i++)
+        {
+            uint64 hash;
+            CHECK(r.Get(hash), false, "");
+            plugin.extensions.insert(hash);
+        }
+        CHECK(r.Get(hasPattern), false, "");
+        if (hasPattern)
+        {
+            CHECK(plugin.pattern = ReadMatcher(r), false, "");
+        }
+        CHECK(r.Get(itemsCount), false, "");
+        plugin.patterns.reserve(itemsCount);
+        for (auto i = 0U; i < itemsCount; i++)
+        {
+            auto m = ReadMatcher(r);
+            CHECK(m, false, "");
+            plugin.patterns.push_back(m);
+        }
+        CHECK(r.Get(itemsCount), false, "");
+        plugin.commands.reserve(itemsCount);
+        for (auto i = 0U; i < itemsCount; i++)
+        {
+            auto& cmd = plugin.commands.emplace_back();
+            CHECK(r.GetString(text), false, "");
+            cmd.name = text;
+            CHECK(r.Get(cmd.key), false, "");
+        }
+        CHECK(r.Get(stamp), false, "");
+        // the plugin was rebuilt / updated => its settings might be different
+        if (stamp != GetFileStamp(Type::Plugin::GetPluginPath(plugin.GetName())))
+            return false;
+    }
+
+    CHECK(r.Get(count), false, "");
+    generics.reserve(count);
+    for (auto idx = 0U; idx < count; idx++)
+    {
+        auto& plugin = generics.emplace_back();
+        CHECK(r.GetString(text), false, "");
+        plugin.Name = text;
+        CHECK(r.Get(plugin.CommandsCount) && (plugin.CommandsCount <= Generic::MAX_PLUGINS_COMMANDS), false, "");
+        for (auto i = 0U; i < plugin.CommandsCount; i++)
+        {
+            CHECK(r.GetString(text), false, "");
+            plugin.Commands[i].Name = text;
+            CHECK(r.Get(plugin.Commands[i].ShortKey), false, "");
+        }
+        CHECK(r.Get(stamp), false, "");
+        if (stamp != GetFileStamp(GetGenericPluginPath(plugin.Name)))
+            return false;
+    }
+    CHECK(r.IsEOF(), false, "Invalid plugin registry");
+    return true;
+}
@@ -0,0 +1,253 @@
+#include "Internal.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+using namespace GView::App;
+using nlohmann::json;
+
+namespace
+{
+std::string PathToUTF8(const std::filesystem::path& path)
+{
+    auto u8 = path.u8string();
+    return { u8.begin(), u8.end() };
+}
+
+// Every worker owns a queue: it takes work from the back of its own queue and, when that one is empty, steals from the
+// front of the other queues. The total number of queued files is bounded (the producer waits) so walking a folder with
+// 100k files does not keep all the paths in memory.
+class ScanPool
+{
+    struct WorkerQueue {
+        std::mutex lock;
+        std::deque<std::filesystem::path> files;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex stateLock;
+    std::condition_variable hasWork;
+    std::condition_variable hasRoom;
+    uint32 queued{ 0 };
+    uint32 maxQueued{ 0 };
+    uint32 nextQueue{ 0 };
+    bool finished{ false };
+
+    bool Pop(uint32 workerIndex, std::filesystem::path& file)
+    {
+        const auto count = static_cast<uint32>(queues.size());
+        for (uint32 idx = 0; idx < count; idx++) {
+            auto& q = *queues[(workerIndex + idx) % count];
+            std::lock_guard<std::mutex> guard(q.lock);
+            if (q.files.empty())
+                continue;
+            if (idx == 0) {
+                file = std::move(q.files.back());
+                q.files.pop_back();
+            } else {
+                file = std::move(q.files.front());
+                q.files.pop_front();
+            }
+            return true;
+        }
+        return false;
+    }
+
+    template <typename Processor>
+    void WorkerLoop(uint32 workerIndex, Processor& processor)
+    {
+        std::filesystem::path file;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> guard(stateLock);
+                hasWork.wait(guard, [this] { return queued > 0 || finished; });
+                if (queued == 0)
+                    return; // finished and nothing left
+                queued--;
+            }
+            hasRoom.notify_one();
+
+            // a slot was reserved => there is at least one file in one of the queues
+            while (!Pop(workerIndex, file))
+                std::this_thread::yield();
+            processor(file);
+        }
+    }
+
+  public:
+    template <typename Processor>
+    void Start(uint32 threadsCount, uint32 maxQueuedFiles, Processor& processor)
+    {
+        maxQueued = maxQueuedFiles;
+        for (uint32 idx = 0; idx < threadsCount; idx++)
+            queues.push_back(std::make_unique<WorkerQueue>());
+        for (uint32 idx = 0; idx < threadsCount; idx++)
+            threads.emplace_back([this, idx, &processor]() { WorkerLoop(idx, processor); });
+    }
+    void Submit(std::filesystem::path file)
+    {
+        std::unique_lock<std::mutex> guard(stateLock);
+        hasRoom.wait(guard, [this] { return queued < maxQueued; });
+        {
+            auto& q = *queues[nextQueue];
+            std::lock_guard<std::mutex> queueGuard(q.lock);
+            q.files.push_back(std::move(file));
+        }
+        nextQueue = (nextQueue + 1) % static_cast<uint32>(queues.size());
+        queued++;
+        guard.unlock();
+        hasWork.notify_one();
+    }
+    void Finish()
+    {
+        {
+            std::lock_guard<std::mutex> guard(stateLock);
+            finished = true;
+        }
+        hasWork.notify_all();
+        for (auto& t : threads)
+            t.join();
+        threads.clear();
+    }
+};
+} // namespace
+
+bool Instance::Scan(const std::vector<std::filesystem::path>& paths, const ScanSettings& settings)
+{
+    std::ofstream outputFile;
+    if (!settings.output.empty()) {
+        outputFile.open(settings.output, std::ios::out | std::ios::trunc | std::ios::binary);
+        CHECK(outputFile.is_open(), false, "Fail to create: %s", settings.output.u8string().c_str());
+    }
+    std::ostream& out = settings.output.empty() ? std::cout : outputFile;
+
+    auto threadsCount = settings.threads;
+    if (threadsCount == 0)
+        threadsCount = std::max<uint32>(1, std::thread::hardware_concurrency());
+    auto maxQueuedFiles = settings.maxQueuedFiles ? settings.maxQueuedFiles : threadsCount * 16;
+
+    std::mutex identifyLock; // plugins are loaded (and statistics updated) while identifying
+    std::mutex outputLock;
+    std::atomic<uint32> filesCount{ 0 };
+    std::atomic<uint32> errorsCount{ 0 };
+
+    auto processFile = [&](const std::filesystem::path& file) {
+        json entry;
+        entry["path"] = PathToUTF8(file);
+        try {
+            auto size     = std::filesystem::file_size(file);
+            entry["size"] = size;
+            while (true) {
+                if (settings.maxFileSize && size > settings.maxFileSize) {
+                    entry["error"] = "file too large (skipped)";
+                    break;
+                }
+
+                auto f = std::make_unique<AppCUI::OS::File>();
+                if (!f->OpenRead(file)) {
+                    entry["error"] = "fail to open file";
+                    break;
+                }
+                GView::Utils::DataCache cache;
+                if (!cache.Init(std::move(f), this->defaultCacheSize)) {
+                    entry["error"] = "fail to instantiate cache object";
+                    break;
+                }
+
+                auto u16Path = file.u16string();
+                auto u16Name = file.filename().u16string();
+                auto pos     = u16Name.find_last_of(u'.');
+                auto extHash = pos != std::u16string::npos ? GView::Type::Plugin::ExtensionToHash(std::u16string_view(u16Name).substr(pos))
+                                                           : GView::Type::Plugin::ExtensionToHash("");
+                std::u16string newName = u16Name;
+
+                Reference<GView::Type::Plugin> plg;
+                {
+                    std::lock_guard<std::mutex> guard(identifyLock);
+                    plg = IdentifyTypePlugin(std::u16string_view(u16Name), std::u16string_view(u16Path), cache, extHash, OpenMethod::FirstMatch, "", newName);
+                }
+                if (!plg) {
+                    entry["error"] = "unable to identify a type plugin";
+                    break;
+                }
+
+                auto contentType = plg->CreateInstance();
+                if (!contentType) {
+                    entry["error"] = "'CreateInstance' returned a null pointer";
+                    break;
+                }
+
+                GView::Object obj(
+                      GView::Object::Type::File, std::move(cache), contentType, std::u16string_view(newName), std::u16string_view(u16Path), 0);
+                entry["type"] = std::string(contentType->GetTypeName());
+                if (plg->CanUpdate()) {
+                    // a plugin that checks less than the whole structure says so => it is not reported as parsed
+                    const auto result = plg->Update(&obj);
+                    const auto scope  = plg->GetUpdateScope();
+                    if (scope == "structure") {
+                        entry["parsed"] = result;
+                    } else {
+                        entry["validated"]  = result;
+                        entry["validation"] = std::string(scope);
+                    }
+                }
+                auto context = contentType->GetSmartAssistantContext("", "");
+                if (context) {
+                    entry["context"] = json::parse(context->ToString(), nullptr, false);
+                    GView::Utils::JsonBuilderInterface::Destroy(context);
+                }
+                delete contentType;
+                break;
+            }
+        } catch (const std::exception& e) {
+            entry["error"] = e.what();
+        }
+
+        filesCount++;
+        if (entry.contains("error"))
+            errorsCount++;
+
+        auto line = entry.dump(-1, ' ', false, json::error_handler_t::replace);
+        std::lock_guard<std::mutex> guard(outputLock);
+        out << line << '\n';
+    };
+
+    ScanPool pool;
+    pool.Start(threadsCount, maxQueuedFiles, processFile);
+    for (const auto& p : paths) {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(p, ec)) {
+            pool.Submit(p);
+            continue;
+        }
+        auto options = std::filesystem::directory_options::skip_permission_denied;
+        if (settings.recursive) {
+            for (auto it = std::filesystem::recursive_directory_iterator(p, options, ec); !ec && it != std::filesystem::recursive_directory_iterator();
+                 it.increment(ec)) {
+                if (it->is_regular_file(ec))
+                    pool.Submit(it->path());
+            }
+        } else {
+            for (auto it = std::filesystem::directory_iterator(p, options, ec); !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+                if (it->is_regular_file(ec))
+                    pool.Submit(it->path());
+            }
+        }
+        if (ec) {
+            LOG_ERROR("Fail to enumerate: %s (%s)", p.u8string().c_str(), ec.message().c_str());
+        }
+    }
+    pool.Finish();
+    out.flush();
+
+    LOG_INFO("Scanned %u files (%u errors)", filesCount.load(), errorsCount.load());
+    return errorsCount == 0;
+}
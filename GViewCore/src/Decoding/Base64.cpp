@@ -1,112 +1,486 @@
 #include "Internal.hpp"
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#    define BASE64_X86
+#    if defined(_MSC_VER) && !defined(__clang__)
+#        include <intrin.h>
+#        define BASE64_TARGET(x)
+#    else
+#        define BASE64_TARGET(x) __attribute__((target(x)))
+#    endif
+#    include <immintrin.h>
+#endif
+
 constexpr char BASE64_ENCODE_TABLE[] = { 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V',
                                          'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r',
                                          's', 't', 'u', 'v', 'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/' };
 
-constexpr char BASE64_DECODE_TABLE[] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-                                         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63, 52, 53,
-                                         54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1, -1, 0,  1,  2,  3,  4,  5,  6,  7,  8,  9,
-                                         10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1, -1, 26, 27, 28,
-                                         29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51 };
+constexpr uint8 BASE64_INVALID    = 0xFF;
+constexpr uint8 BASE64_WHITESPACE = 0xFE;
+constexpr uint8 BASE64_PADDING    = 0xFD;
+
+// the vector decoders store 16 / 32 bytes for every 12 / 24 decoded bytes
+constexpr size_t DECODE_OUTPUT_SLACK = 8;
+
+constexpr std::array<uint8, 256> MakeDecodeTable()
+{
+    std::array<uint8, 256> table{};
+    for (auto& value : table) {
+        value = BASE64_INVALID;
+    }
+    for (uint8 i = 0; i < 64; i++) {
+        table[static_cast<uint8>(BASE64_ENCODE_TABLE[i])] = i;
+    }
+    for (auto c : { ' ', '\t', '\r', '\n', '\f', '\v' }) {
+        table[static_cast<uint8>(c)] = BASE64_WHITESPACE;
+    }
+    table['='] = BASE64_PADDING;
+    return table;
+}
+
+constexpr auto BASE64_DECODE_TABLE = MakeDecodeTable();
 
 namespace GView::Decoding::Base64
 {
-void Encode(BufferView view, Buffer& output)
+namespace
 {
-    uint32 sequence      = 0;
-    uint32 sequenceIndex = 0;
+    using Kernel = size_t (*)(const uint8* input, size_t size, uint8* output);
+
+    // full groups of 3 bytes => returns the number of bytes that were encoded
+    size_t EncodeScalar(const uint8* input, size_t size, uint8* output)
+    {
+        size_t i = 0;
+        for (; i + 3 <= size; i += 3, output += 4) {
+            const uint32 v = (static_cast<uint32>(input[i]) << 16) | (static_cast<uint32>(input[i + 1]) << 8) | input[i + 2];
+            output[0]      = BASE64_ENCODE_TABLE[v >> 18];
+            output[1]      = BASE64_ENCODE_TABLE[(v >> 12) & 0x3F];
+            output[2]      = BASE64_ENCODE_TABLE[(v >> 6) & 0x3F];
+            output[3]      = BASE64_ENCODE_TABLE[v & 0x3F];
+        }
+        return i;
+    }
+
+    // full groups of 4 valid characters => returns the number of characters that were decoded
+    size_t DecodeScalar(const uint8* input, size_t size, uint8* output)
+    {
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4, output += 3) {
+            const uint32 a = BASE64_DECODE_TABLE[input[i]];
+            const uint32 b = BASE64_DECODE_TABLE[input[i + 1]];
+            const uint32 c = BASE64_DECODE_TABLE[input[i + 2]];
+            const uint32 d = BASE64_DECODE_TABLE[input[i + 3]];
+            if ((a | b | c | d) >= 64) {
+                break; // whitespaces, padding or invalid characters
+            }
+            const auto v = (a << 18) | (b << 12) | (c << 6) | d;
+            output[0]    = static_cast<uint8>(v >> 16);
+            output[1]    = static_cast<uint8>(v >> 8);
+            output[2]    = static_cast<uint8>(v);
+        }
+        return i;
+    }
+
+    // the 1 or 2 bytes of an incomplete group (2 or 3 characters)
+    uint32 DecodeIncompleteQuantum(uint32 quantum, uint32 count, uint8* output)
+    {
+        if (count == 2) {
+            output[0] = static_cast<uint8>(quantum >> 4);
+            return 1;
+        }
+        if (count == 3) {
+            output[0] = static_cast<uint8>(quantum >> 10);
+            output[1] = static_cast<uint8>(quantum >> 2);
+            return 2;
+        }
+        return 0;
+    }
+
+#ifdef BASE64_X86
+    /*
+        Vector encoding (12 bytes => 16 characters per 128 bits):
+        - every group of 3 bytes is spread over 32 bits and the 4 indexes of 6 bits are moved into separate bytes with
+          two multiplications (instead of shifts with different counts)
+        - an index is converted to its character by adding an offset that depends on the range of the index (A-Z, a-z,
+          0-9, '+', '/'); the range is found with a saturated subtraction and a comparison, the offset with a shuffle
+    */
+    BASE64_TARGET("ssse3") inline __m128i EncodeIndexesSSSE3(__m128i in)
+    {
+        in              = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+        const auto high = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+        const auto low  = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+        const auto idx  = _mm_or_si128(high, low);
+
+        const auto offsets = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+        auto range         = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+        range              = _mm_sub_epi8(range, _mm_cmpgt_epi8(idx, _mm_set1_epi8(25)));
+        return _mm_add_epi8(idx, _mm_shuffle_epi8(offsets, range));
+    }
+
+    // inlined in the AVX2 functions as well (mixing them with non-VEX SSE code is slow)
+    BASE64_TARGET("ssse3") inline size_t EncodeBlocksSSSE3(const uint8* input, size_t size, uint8* output)
+    {
+        size_t i = 0;
+        for (; i + 16 <= size; i += 12, output += 16) {
+            const auto in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output), EncodeIndexesSSSE3(in));
+        }
+        return i;
+    }
 
-    for (uint32 i = 0; i < view.GetLength(); ++i) {
-        char decoded = view[i];
+    BASE64_TARGET("ssse3") size_t EncodeSSSE3(const uint8* input, size_t size, uint8* output)
+    {
+        return EncodeBlocksSSSE3(input, size, output);
+    }
+
+    BASE64_TARGET("avx2") size_t EncodeAVX2(const uint8* input, size_t size, uint8* output)
+    {
+        const auto shuffle = _mm256_setr_epi8(
+              1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+        const auto offsets = _mm256_setr_epi8(
+              65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0, 65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+
+        size_t i = 0;
+        for (; i + 28 <= size; i += 24, output += 32) {
+            const auto first  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            const auto second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 12));
+            auto in           = _mm256_inserti128_si256(_mm256_castsi128_si256(first), second, 1);
+
+            in              = _mm256_shuffle_epi8(in, shuffle);
+            const auto high = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+            const auto low  = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+            const auto idx  = _mm256_or_si256(high, low);
+
+            auto range = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+            range      = _mm256_sub_epi8(range, _mm256_cmpgt_epi8(idx, _mm256_set1_epi8(25)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_add_epi8(idx, _mm256_shuffle_epi8(offsets, range)));
+        }
+        i += EncodeBlocksSSSE3(input + i, size - i, output);
+        return i;
+    }
+
+    /*
+        Vector decoding (16 characters => 12 bytes per 128 bits):
+        - the high and low nibbles of every character select two bit masks; a character is valid if the masks have no
+          bit in common => a block with whitespaces, padding or invalid characters is left for the scalar code
+        - the value of a character is obtained by adding an offset selected by its high nibble ('/' is the only
+          character that shares its high nibble with another range, '+')
+        - the 6 bit values are packed with two multiply-add instructions and a shuffle
+    */
+    BASE64_TARGET("ssse3") inline size_t DecodeBlocksSSSE3(const uint8* input, size_t size, uint8* output)
+    {
+        const auto lutLo   = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const auto lutHi   = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const auto lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const auto mask2F  = _mm_set1_epi8(0x2F);
+        const auto pack    = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16, output += 12) {
+            auto in              = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            const auto hiNibbles = _mm_and_si128(_mm_srli_epi32(in, 4), mask2F);
+            const auto loNibbles = _mm_and_si128(in, mask2F);
+            const auto invalid   = _mm_and_si128(_mm_shuffle_epi8(lutLo, loNibbles), _mm_shuffle_epi8(lutHi, hiNibbles));
+            if (_mm_movemask_epi8(_mm_cmpgt_epi8(invalid, _mm_setzero_si128())) != 0) {
+                break;
+            }
+            in = _mm_add_epi8(in, _mm_shuffle_epi8(lutRoll, _mm_add_epi8(_mm_cmpeq_epi8(in, mask2F), hiNibbles)));
+
+            const auto merged = _mm_madd_epi16(_mm_maddubs_epi16(in, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_shuffle_epi8(merged, pack));
+        }
+        return i;
+    }
+
+    BASE64_TARGET("ssse3") size_t DecodeSSSE3(const uint8* input, size_t size, uint8* output)
+    {
+        return DecodeBlocksSSSE3(input, size, output);
+    }
+
+    BASE64_TARGET("avx2") size_t DecodeAVX2(const uint8* input, size_t size, uint8* output)
+    {
+        const auto lutLo = _mm256_setr_epi8(
+              0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+              0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const auto lutHi = _mm256_setr_epi8(
+              0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+              0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const auto lutRoll = _mm256_setr_epi8(
+              0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const auto mask2F = _mm256_set1_epi8(0x2F);
+        const auto pack   = _mm256_setr_epi8(
+              2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        const auto lanes = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
 
-        sequence |= decoded << ((3 - sequenceIndex) * 8);
-        sequenceIndex++;
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32, output += 24) {
+            auto in              = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+            const auto hiNibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), mask2F);
+            const auto loNibbles = _mm256_and_si256(in, mask2F);
+            const auto invalid   = _mm256_and_si256(_mm256_shuffle_epi8(lutLo, loNibbles), _mm256_shuffle_epi8(lutHi, hiNibbles));
+            if (_mm256_movemask_epi8(_mm256_cmpgt_epi8(invalid, _mm256_setzero_si256())) != 0) {
+                break;
+            }
+            in = _mm256_add_epi8(in, _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(_mm256_cmpeq_epi8(in, mask2F), hiNibbles)));
 
-        if (sequenceIndex % 3 == 0) {
-            // get 4 encoded components out of this one
-            // 0x3f -> 0b00111111
-            char buffer[] = {
-                BASE64_ENCODE_TABLE[(sequence >> 26) & 0x3f],
-                BASE64_ENCODE_TABLE[(sequence >> 20) & 0x3f],
-                BASE64_ENCODE_TABLE[(sequence >> 14) & 0x3f],
-                BASE64_ENCODE_TABLE[(sequence >> 8) & 0x3f],
-            };
+            const auto merged = _mm256_madd_epi16(_mm256_maddubs_epi16(in, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(merged, pack), lanes));
+        }
+        i += DecodeBlocksSSSE3(input + i, size - i, output);
+        return i;
+    }
 
-            output.Add(string_view(buffer, 4));
+    bool HasSSSE3()
+    {
+        static const bool supported = []() {
+#    if defined(_MSC_VER) && !defined(__clang__)
+            int regs[4];
+            __cpuid(regs, 1);
+            return (regs[2] & (1 << 9)) != 0;
+#    else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("ssse3");
+#    endif
+        }();
+        return supported;
+    }
+
+    bool HasAVX2()
+    {
+        static const bool supported = []() {
+#    if defined(_MSC_VER) && !defined(__clang__)
+            int regs[4];
+            __cpuid(regs, 1);
+            // the OS must also save the YMM registers (OSXSAVE + XCR0)
+            if (((regs[2] & (1 << 27)) == 0) || ((regs[2] & (1 << 28)) == 0) || ((_xgetbv(0) & 6) != 6)) {
+                return false;
+            }
+            __cpuidex(regs, 7, 0);
+            return (regs[1] & (1 << 5)) != 0;
+#    else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#    endif
+        }();
+        return supported;
+    }
+#endif
 
-            sequence      = 0;
-            sequenceIndex = 0;
+    Kernel GetEncodeKernel()
+    {
+#ifdef BASE64_X86
+        if (HasAVX2()) {
+            return EncodeAVX2;
         }
+        if (HasSSSE3()) {
+            return EncodeSSSE3;
+        }
+#endif
+        return EncodeScalar;
+    }
+
+    Kernel GetDecodeKernel()
+    {
+#ifdef BASE64_X86
+        if (HasAVX2()) {
+            return DecodeAVX2;
+        }
+        if (HasSSSE3()) {
+            return DecodeSSSE3;
+        }
+#endif
+        return DecodeScalar;
     }
+} // namespace
 
-    output.AddMultipleTimes(string_view("=", 1), (3 - sequenceIndex) % 3);
+uint64 GetEncodedSize(uint64 size)
+{
+    return ((size + 2) / 3) * 4;
 }
 
-bool Decode(BufferView view, Buffer& output, bool& hasWarning, String& warningMessage)
+uint64 GetMaxDecodedSize(uint64 size)
 {
-    uint32 sequence      = 0;
-    uint32 sequenceIndex = 0;
-    char lastEncoded     = 0;
-    uint8 paddingCount   = 0;
-    hasWarning           = false;
-    output.Reserve((view.GetLength() / 4) * 3);
+    return ((size + 3) / 4) * 3;
+}
 
-    for (uint32 i = 0; i < view.GetLength(); ++i) {
-        char encoded = view[i];
-        CHECK(encoded < sizeof(BASE64_DECODE_TABLE) / sizeof(*BASE64_DECODE_TABLE), false, "");
+void Encode(BufferView view, Buffer& output)
+{
+    static const Kernel encodeBlocks = GetEncodeKernel();
 
-        if (encoded == '\r' || encoded == '\n') {
-            continue;
-        }
+    const auto input     = view.GetData();
+    const auto size      = view.GetLength();
+    const auto oldLength = output.GetLength();
+    output.Resize(oldLength + GetEncodedSize(size));
+    auto out = output.GetData() + oldLength;
+
+    auto count = encodeBlocks(input, size, out);
+    count += EncodeScalar(input + count, size - count, out + (count / 3) * 4);
+    out += (count / 3) * 4;
+
+    // the last 1 or 2 bytes
+    if (count < size) {
+        const uint32 v = (static_cast<uint32>(input[count]) << 16) | (count + 1 < size ? static_cast<uint32>(input[count + 1]) << 8 : 0);
+        out[0]         = BASE64_ENCODE_TABLE[v >> 18];
+        out[1]         = BASE64_ENCODE_TABLE[(v >> 12) & 0x3F];
+        out[2]         = count + 1 < size ? BASE64_ENCODE_TABLE[(v >> 6) & 0x3F] : '=';
+        out[3]         = '=';
+    }
+}
+
+Decoder::Decoder(Mode mode) : mode(mode)
+{
+    Reset();
+}
+
+void Decoder::Reset()
+{
+    quantum         = 0;
+    quantumCount    = 0;
+    paddingCount    = 0;
+    expectedPadding = 0;
+    ended           = false;
+    ignoreRest      = false;
+    warning         = nullptr;
+}
 
-        if (lastEncoded == '=' && sequenceIndex == 0) {
-            hasWarning     = true;
-            warningMessage = "Ignoring extra bytes after the end of buffer";
+// one character at a time, until a new group of 4 characters starts (where the vector code can continue)
+bool Decoder::DecodeCharacters(const uint8*& p, const uint8* e, uint8*& out)
+{
+    const auto start = p;
+    for (; p < e; p++) {
+        if ((quantumCount == 0) && !ended && (p > start)) {
             break;
         }
 
-        uint32 decoded;
-
-        if (encoded == '=') {
-            // padding
-            decoded = 0;
+        const auto value = BASE64_DECODE_TABLE[*p];
+        if (value == BASE64_WHITESPACE) {
+            continue;
+        }
+        if ((value < 64) && !ended) {
+            quantum = (quantum << 6) | value;
+            if (++quantumCount == 4) {
+                out[0]       = static_cast<uint8>(quantum >> 16);
+                out[1]       = static_cast<uint8>(quantum >> 8);
+                out[2]       = static_cast<uint8>(quantum);
+                out          += 3;
+                quantum      = 0;
+                quantumCount = 0;
+            }
+            continue;
+        }
+        if ((value == BASE64_PADDING) && !ended) {
+            if (quantumCount < 2) {
+                CHECK(mode != Mode::Strict, false, "Unexpected padding after %u characters of a group", quantumCount);
+                warning = "Ignoring an incomplete group before the padding";
+            }
+            out             += DecodeIncompleteQuantum(quantum, quantumCount, out);
+            ended           = true;
+            expectedPadding = 4 - quantumCount;
+            paddingCount    = 1;
+            quantum         = 0;
+            quantumCount    = 0;
+            continue;
+        }
+        if ((value == BASE64_PADDING) && (paddingCount < expectedPadding)) {
             paddingCount++;
-        } else {
-            decoded = BASE64_DECODE_TABLE[encoded];
-            CHECK(decoded != -1, false, "");
+            continue;
+        }
+        if ((value == BASE64_INVALID) && !ended) {
+            CHECK(mode == Mode::Lenient, false, "Invalid character (0x%02X)", *p);
+            warning = "Ignoring characters that are not part of the base64 alphabet";
+            continue;
         }
 
-        sequence |= decoded << (2 + (4 - sequenceIndex) * 6);
-        sequenceIndex++;
+        CHECK(mode != Mode::Strict, false, "Data after the padding");
+        // the data after the padding is ignored (for this chunk and the next ones)
+        warning    = "Ignoring extra bytes after the end of buffer";
+        ignoreRest = true;
+        p          = e;
+        break;
+    }
+    return true;
+}
 
-        if (sequenceIndex % 4 == 0) {
-            char* buffer = (char*) &sequence;
+bool Decoder::Add(BufferView view, Buffer& output)
+{
+    static const Kernel decodeBlocks = GetDecodeKernel();
 
-            output.Add(string_view(buffer + 3, 1));
-            output.Add(string_view(buffer + 2, 1));
-            output.Add(string_view(buffer + 1, 1));
+    auto p       = view.GetData();
+    const auto e = p + view.GetLength();
+    if (ignoreRest || (p == e)) {
+        return true;
+    }
 
-            sequence      = 0;
-            sequenceIndex = 0;
+    // room for everything => no reallocation while decoding
+    const auto oldLength = output.GetLength();
+    output.Resize(oldLength + GetMaxDecodedSize(view.GetLength()) + DECODE_OUTPUT_SLACK);
+    const auto begin = output.GetData() + oldLength;
+    auto out         = begin;
+
+    while (p < e) {
+        if ((quantumCount == 0) && !ended) {
+            auto count = decodeBlocks(p, e - p, out);
+            count += DecodeScalar(p + count, e - p - count, out + (count / 4) * 3);
+            p += count;
+            out += (count / 4) * 3;
+        }
+        if (!DecodeCharacters(p, e, out)) {
+            output.Resize(oldLength);
+            return false;
         }
+    }
+    output.Resize(oldLength + (out - begin));
+    return true;
+}
 
-        lastEncoded = encoded;
+bool Decoder::Finish(Buffer& output)
+{
+    if (ended) {
+        CHECK((mode != Mode::Strict) || (paddingCount == expectedPadding), false, "Incomplete padding");
+        return true;
+    }
+    if (quantumCount == 0) {
+        return true;
     }
 
-    // trim the trailing bytes
-    CHECK(paddingCount < 3, false, "");
-    output.Resize(output.GetLength() - paddingCount);
+    CHECK(mode != Mode::Strict, false, "Missing padding");
+    if (quantumCount == 1) {
+        warning = "Ignoring the last character (a group needs at least 2 characters)";
+    } else {
+        uint8 bytes[2];
+        output.Add(BufferView(bytes, DecodeIncompleteQuantum(quantum, quantumCount, bytes)));
+    }
+    quantum      = 0;
+    quantumCount = 0;
+    return true;
+}
 
+bool Decode(BufferView view, Buffer& output, Mode mode, bool& hasWarning, String& warningMessage)
+{
+    Decoder decoder(mode);
+    const auto oldLength = output.GetLength();
+    hasWarning           = false;
+    if (!decoder.Add(view, output) || !decoder.Finish(output)) {
+        output.Resize(oldLength);
+        return false;
+    }
+    if (decoder.HasWarning()) {
+        hasWarning     = true;
+        warningMessage = decoder.GetWarning();
+    }
     return true;
 }
 
+bool Decode(BufferView view, Buffer& output, bool& hasWarning, String& warningMessage)
+{
+    return Decode(view, output, Mode::Tolerant, hasWarning, warningMessage);
+}
+
 bool Decode(BufferView view, Buffer& output)
 {
     bool tempHasWarning;
     String tempWarningMessage;
 
-    return Decode(view, output, tempHasWarning, tempWarningMessage);
+    return Decode(view, output, Mode::Tolerant, tempHasWarning, tempWarningMessage);
 }
 
 } // namespace GView::Decoding::Base64
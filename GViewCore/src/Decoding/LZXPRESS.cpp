@@ -11,370 +11,311 @@
 
 namespace GView::Decoding::LZXPRESS::Huffman
 {
-constexpr uint32 MAX_BITS_COUNT     = 32U;
-constexpr uint32 UINT32_BITS_COUNT  = 32U;
-constexpr uint32 UINT16_BITS_COUNT  = 16U;
 constexpr uint32 CHUNK_SIZE         = 0x10000;
 constexpr uint32 MAXIMUM_CODE_SIZE  = 15U;
 constexpr uint32 SYMBOLS_ARRAY_SIZE = 512U;
 constexpr uint32 SYMBOL_MAX_SIZE    = 256U;
-
-struct Stream
+constexpr uint32 CODE_SIZES_BYTES   = SYMBOLS_ARRAY_SIZE / 2;
+
+// codes of up to PRIMARY_BITS bits are decoded with a single lookup, the longer ones with a second lookup in a table
+// of 2 ^ (MAXIMUM_CODE_SIZE - PRIMARY_BITS) entries
+constexpr uint32 PRIMARY_BITS       = 11U;
+constexpr uint32 SECONDARY_BITS     = MAXIMUM_CODE_SIZE - PRIMARY_BITS;
+constexpr uint16 SECONDARY_TABLE    = 0x8000;
+constexpr uint32 ENTRY_LENGTH_SHIFT = 9U;
+constexpr uint16 ENTRY_SYMBOL_MASK  = 0x01FF;
+
+/*
+    The bits are read as 16 bit little endian words (most significant bit first), while the extended match lengths and
+    the code sizes of the next chunk are bytes read from the current position of the stream. The format defines that
+    position for a reader that keeps between 16 and 31 unused bits => this reader keeps up to 64 bits and, before a
+    byte read, gives back the words that the format's reader would not have read yet.
+*/
+class BitReader
 {
-  private:
-    const uint8* stream;
+    const uint8* data;
     size_t size;
-    size_t offset;
-
-    uint32 bits;
-    uint8 bitsCount;
+    size_t position; // may go past the end (the missing words are read as 0)
+    uint64 bits;     // the next bits are the most significant ones
+    uint32 bitsCount;
 
   public:
-    bool Initialize(const uint8* _stream, size_t _size)
+    BitReader(const uint8* data, size_t size) : data(data), size(size), position(0), bits(0), bitsCount(0)
     {
-        CHECK(_stream != nullptr, false, "");
-        CHECK(_size <= (size_t) INT32_MAX, false, "");
-
-        stream = _stream;
-        size   = _size;
-
-        return true;
     }
 
-    inline void PushUInt16()
+    // at least 49 bits after a refill
+    inline void Refill()
     {
-        bits <<= UINT16_BITS_COUNT;
-        bitsCount += UINT16_BITS_COUNT;
-
-        if (size >= sizeof(uint16) || offset <= (size - sizeof(uint16)))
+        if (position + 8 <= size)
         {
-            *((uint16*) &bits) = *((uint16*) (stream + offset));
-            offset += sizeof(uint16);
+            // the next 4 words in reading order, then as many of them as there is room for
+            uint64 raw;
+            memcpy(&raw, data + position, sizeof(raw));
+            const auto words = (raw << 48) | ((raw & 0xFFFF0000ULL) << 16) | ((raw >> 16) & 0xFFFF0000ULL) | (raw >> 48);
+            const auto count = (64 - bitsCount) >> 4;
+            bits |= (words & (0xFFFFFFFFFFFFFFFFULL << (64 - 16 * count))) >> bitsCount;
+            bitsCount += 16 * count;
+            position += 2 * count;
+            return;
         }
-    }
-
-    inline void Next()
-    {
-        if (bitsCount < UINT16_BITS_COUNT)
+        while (bitsCount <= 48)
         {
-            PushUInt16();
+            uint64 word = 0;
+            if (position + 2 <= size)
+            {
+                word = data[position] | (static_cast<uint32>(data[position + 1]) << 8);
+            }
+            bits |= word << (48 - bitsCount);
+            bitsCount += 16;
+            position += 2;
         }
     }
 
-    inline void PushUInt32()
+    inline uint32 GetBitsCount() const
     {
-        PushUInt16();
-        PushUInt16();
+        return bitsCount;
     }
 
-    inline uint32 GetBits() const
+    inline uint32 Peek(uint32 count) const
     {
-        return bits;
+        return static_cast<uint32>(bits >> (64 - count));
     }
 
-    inline uint8 GetBitsCount() const
+    inline void Skip(uint32 count)
     {
-        return bitsCount;
+        bits <<= count;
+        bitsCount -= count;
     }
 
-    inline void ResetBits()
+    inline uint32 Get(uint32 count)
     {
-        bitsCount = 0;
-    }
-
-    bool GetValue(uint8 bitsToRead, uint32& value)
-    {
-        CHECK(bitsToRead <= MAX_BITS_COUNT, false, "");
-
-        value = 0;
-        CHECK(bitsToRead != 0, true, "");
-
-        if (bitsCount < bitsToRead)
+        if (count == 0)
         {
-            CHECK(Read(bitsToRead), false, "");
+            return 0;
         }
+        const auto value = Peek(count);
+        Skip(count);
+        return value;
+    }
 
-        value = bits;
-
-        if (bitsToRead < MAX_BITS_COUNT)
-        {
-            value >>= bitsCount - bitsToRead;
-        }
-        bitsCount -= bitsToRead;
+    inline bool IsOverrun() const
+    {
+        // more than the words that a reader needs ahead
+        return position > size + 8;
+    }
 
-        if (bitsCount == 0)
-        {
-            bits = 0;
-        }
-        else
+    // the bits that the format's reader did not load yet are given back
+    bool Synchronize()
+    {
+        if (bitsCount < 16)
         {
-            const uint8 bitBufferSizeLeft = MAX_BITS_COUNT - bitsCount;
-            bits &= 0xffffffffUL >> bitBufferSizeLeft;
+            Refill();
         }
-
+        const auto keep = 16 + ((bitsCount - 16) % 16);
+        position -= (bitsCount - keep) / 8;
+        bits &= ~(0xFFFFFFFFFFFFFFFFULL >> keep);
+        bitsCount = keep;
         return true;
     }
 
     template <typename V>
-    inline bool Read(V& value)
+    bool Read(V& value)
     {
-        CHECK(offset <= size - sizeof(V), false, "");
-
-        value = *(V*) (stream + offset);
-        offset += sizeof(V);
-
+        CHECK(Synchronize(), false, "");
+        CHECK(position + sizeof(V) <= size, false, "");
+        memcpy(&value, data + position, sizeof(V));
+        position += sizeof(V);
+        Refill();
         return true;
     }
 
-    inline size_t GetSize() const
+    // starts a new chunk: the code sizes and the first 32 bits
+    bool ReadCodeSizes(uint8 (&codeSizes)[SYMBOLS_ARRAY_SIZE])
     {
-        return size;
-    }
-
-    inline size_t GetOffset() const
-    {
-        return offset;
+        if (position > 0)
+        {
+            CHECK(Synchronize(), false, "");
+        }
+        CHECK(position + CODE_SIZES_BYTES <= size, false, "Not enough data for the Huffman table");
+        for (uint32 i = 0; i < CODE_SIZES_BYTES; i++)
+        {
+            codeSizes[2 * i]     = data[position + i] & 0x0F;
+            codeSizes[2 * i + 1] = data[position + i] >> 4;
+        }
+        position += CODE_SIZES_BYTES;
+        bits      = 0;
+        bitsCount = 0;
+        Refill();
+        return true;
     }
 };
 
-struct HuffmanTree
+// entries: symbol (9 bits) | code size << 9; a code size of 0 marks an invalid code
+class DecodingTable
 {
-    uint8 maximumCodeSize;
-    std::unique_ptr<int32> symbols;
-    std::unique_ptr<int32> codeSizeCounts;
-
-    bool Initialize(int32 symbolsCount, uint8 _maximumCodeSize)
-    {
-        CHECK(symbolsCount >= 0, false, "");
-        CHECK(symbolsCount <= 1024, false, "");
-
-        size_t size = sizeof(int32) * symbolsCount;
+    uint16 primary[1U << PRIMARY_BITS];
+    std::vector<uint16> secondary;
 
-        symbols.reset(new int32[size]);
-        CHECK(symbols.get() != nullptr, false, "");
-        memset(symbols.get(), 0, size);
-
-        size = sizeof(int32) * (_maximumCodeSize + 1ULL);
-
-        codeSizeCounts.reset(new int32[size]);
-        CHECK(codeSizeCounts.get() != nullptr, false, "");
-        memset(codeSizeCounts.get(), 0, size);
-
-        maximumCodeSize = _maximumCodeSize;
-
-        return true;
-    }
-
-    bool Build(const uint8* codeSizes, int32 _codeSizesCount)
+  public:
+    bool Build(const uint8 (&codeSizes)[SYMBOLS_ARRAY_SIZE])
     {
-        CHECK(codeSizes != nullptr, false, "");
-        CHECK(_codeSizesCount >= 0, false, "");
-
-        size_t size = sizeof(int32) * (maximumCodeSize + 1ULL);
-        memset(codeSizeCounts.get(), 0, size);
-
-        for (int32 i = 0; i < _codeSizesCount; i++)
-        {
-            const uint8 size = codeSizes[i];
-            CHECK(size <= maximumCodeSize, false, "");
-
-            codeSizeCounts.get()[size] += 1;
-        }
-
-        CHECK(codeSizeCounts.get()[0] != _codeSizesCount, true, "");
-
-        int32 leftValue = 1;
-        for (auto i = 1; i <= maximumCodeSize; i++)
+        uint32 counts[MAXIMUM_CODE_SIZE + 1]{ 0 };
+        for (auto size : codeSizes)
         {
-            leftValue <<= 1;
-            leftValue -= codeSizeCounts.get()[i];
-            CHECK(leftValue >= 0, false, "");
+            counts[size]++;
         }
+        CHECK(counts[0] != SYMBOLS_ARRAY_SIZE, false, "Empty Huffman table");
 
-        std::unique_ptr<int32> symbolOffsets(new int32[size]);
-        CHECK(symbolOffsets.get() != nullptr, false, "");
-
-        symbolOffsets.get()[0] = 0;
-        symbolOffsets.get()[1] = 0;
-
-        for (uint8 i = 1; i < maximumCodeSize; i++)
+        // canonical codes: shorter codes first, the same size => ordered by symbol
+        int32 left = 1;
+        uint32 nextCode[MAXIMUM_CODE_SIZE + 1]{ 0 };
+        uint32 code = 0;
+        for (uint32 i = 1; i <= MAXIMUM_CODE_SIZE; i++)
         {
-            symbolOffsets.get()[i + 1] = symbolOffsets.get()[i] + codeSizeCounts.get()[i];
+            left = (left << 1) - static_cast<int32>(counts[i]);
+            CHECK(left >= 0, false, "Over-subscribed Huffman table");
+            code        = (code + (i > 1 ? counts[i - 1] : 0)) << 1;
+            nextCode[i] = code;
         }
 
-        for (int32 symbol = 0; symbol < _codeSizesCount; symbol++)
+        memset(primary, 0, sizeof(primary));
+        secondary.clear();
+        for (uint32 symbol = 0; symbol < SYMBOLS_ARRAY_SIZE; symbol++)
         {
-            const uint8 codeSize = codeSizes[symbol];
-            if (codeSize == 0)
+            const auto size = codeSizes[symbol];
+            if (size == 0)
             {
                 continue;
             }
+            const auto symbolCode = nextCode[size]++;
+            const auto entry      = static_cast<uint16>(symbol | (size << ENTRY_LENGTH_SHIFT));
+            if (size <= PRIMARY_BITS)
+            {
+                const auto first = symbolCode << (PRIMARY_BITS - size);
+                std::fill_n(primary + first, 1U << (PRIMARY_BITS - size), entry);
+                continue;
+            }
 
-            const int32 offset = symbolOffsets.get()[codeSize];
-            CHECK(offset >= 0, false, "");
-            CHECK(offset <= _codeSizesCount, false, "");
-
-            symbolOffsets.get()[codeSize] += 1;
-            symbols.get()[offset] = symbol;
+            auto& link = primary[symbolCode >> (size - PRIMARY_BITS)];
+            if ((link & SECONDARY_TABLE) == 0)
+            {
+                link = static_cast<uint16>(SECONDARY_TABLE | (secondary.size() >> SECONDARY_BITS));
+                secondary.resize(secondary.size() + (1U << SECONDARY_BITS), 0);
+            }
+            const auto table = static_cast<size_t>(link & ~SECONDARY_TABLE) << SECONDARY_BITS;
+            const auto first = (symbolCode & ((1U << (size - PRIMARY_BITS)) - 1)) << (MAXIMUM_CODE_SIZE - size);
+            std::fill_n(secondary.begin() + table + first, 1U << (MAXIMUM_CODE_SIZE - size), entry);
         }
-
         return true;
     }
 
-    bool GetSymbol(Stream& stream, uint32& symbol)
+    // the reader must have at least MAXIMUM_CODE_SIZE bits
+    inline bool GetSymbol(BitReader& reader, uint32& symbol) const
     {
-        while (stream.GetBitsCount() < maximumCodeSize)
+        auto entry = primary[reader.Peek(PRIMARY_BITS)];
+        if (entry & SECONDARY_TABLE)
         {
-            CHECK(stream.Read(maximumCodeSize), false, "");
+            const auto table = static_cast<size_t>(entry & ~SECONDARY_TABLE) << SECONDARY_BITS;
+            entry            = secondary[table + (reader.Peek(MAXIMUM_CODE_SIZE) & ((1U << SECONDARY_BITS) - 1))];
         }
-
-        const uint8 bitsCount = maximumCodeSize < stream.GetBitsCount() ? maximumCodeSize : stream.GetBitsCount();
-
-        uint32 value       = 0;
-        int32 code         = 0;
-        int32 initialCode  = 0;
-        int32 initialIndex = 0;
-        symbol             = 0;
-        bool result        = false;
-        for (uint8 i = 1; i <= bitsCount; i++)
-        {
-            CHECK(stream.GetValue(1, value), false, "");
-
-            code <<= 1;
-            code |= (int32) value;
-
-            const int32 codeSizeCount = codeSizeCounts.get()[i];
-
-            if ((code - codeSizeCount) < initialCode)
-            {
-                symbol = symbols.get()[initialIndex + (code - initialCode)];
-                result = true;
-                break;
-            }
-            initialCode += codeSizeCount;
-            initialCode <<= 1;
-            initialIndex += codeSizeCount;
-        }
-
-        CHECK(result, false, "");
-
+        const auto size = entry >> ENTRY_LENGTH_SHIFT;
+        CHECK(size != 0, false, "Invalid Huffman code");
+        reader.Skip(size);
+        symbol = entry & ENTRY_SYMBOL_MASK;
         return true;
     }
 };
 
-bool Update(Stream& stream, Buffer& uncompressed, size_t& uncompressedDataOffset)
+// a match may overlap with its own output (offset < length) => it is copied in steps of at most `offset` bytes
+inline void CopyMatch(uint8* output, size_t offset, size_t length, const uint8* end)
 {
-    CHECK((stream.GetSize() - stream.GetOffset()) >= 260, false, "");
-    CHECK(uncompressed.GetLength() <= (size_t) INT32_MAX, false, "");
-    CHECK(uncompressedDataOffset < uncompressed.GetLength(), false, "");
-
-    uint32 i = 0;
-    uint8 codeSizes[SYMBOLS_ARRAY_SIZE]{ 0 };
-    while (i < SYMBOLS_ARRAY_SIZE)
+    const uint8* source = output - offset;
+    if ((offset >= 8) && (output + length + 8 <= end))
     {
-        uint8 value;
-        CHECK(stream.Read<decltype(value)>(value), false, "");
-        codeSizes[i++] = value & 0x0f;
-        codeSizes[i++] = (value & 0xf0) >> 4;
+        for (size_t i = 0; i < length; i += 8)
+        {
+            memcpy(output + i, source + i, 8);
+        }
+        return;
     }
-
-    HuffmanTree tree{};
-    CHECK(tree.Initialize(SYMBOLS_ARRAY_SIZE, MAXIMUM_CODE_SIZE), false, "");
-    CHECK(tree.Build(codeSizes, SYMBOLS_ARRAY_SIZE), false, "");
-
-    stream.PushUInt32();
-
-    size_t nextChunk = uncompressedDataOffset + CHUNK_SIZE;
-    if (nextChunk > uncompressed.GetLength())
+    for (size_t i = 0; i < length; i++)
     {
-        nextChunk = uncompressed.GetLength();
+        output[i] = source[i];
     }
+}
 
-    while ((stream.GetOffset() < stream.GetSize()) || (stream.GetBitsCount() > 0))
-    {
-        CHECKBK(uncompressedDataOffset < nextChunk, "");
-
-        uint32 symbol = 0;
-        CHECK(tree.GetSymbol(stream, symbol), false, "");
-
-        if (symbol < SYMBOL_MAX_SIZE)
-        {
-            uncompressed.GetData()[uncompressedDataOffset++] = (uint8) symbol;
-        }
+bool Decompress_FallBack(const BufferView& compressed, Buffer& decompressed)
+{
+    CHECK(compressed.IsValid(), false, "");
+    BitReader reader(compressed.GetData(), compressed.GetLength());
+    auto table = std::make_unique<DecodingTable>();
 
-        stream.Next();
+    uint8* const output    = decompressed.GetData();
+    const size_t size      = decompressed.GetLength();
+    const uint8* outputEnd = output + size;
+    size_t offset          = 0;
 
-        if (stream.GetBits() == 0 && uncompressedDataOffset >= uncompressed.GetLength())
-        {
-            break;
-        }
+    while (offset < size)
+    {
+        // every chunk of 64K of output has its own Huffman table
+        uint8 codeSizes[SYMBOLS_ARRAY_SIZE];
+        CHECK(reader.ReadCodeSizes(codeSizes), false, "");
+        CHECK(table->Build(codeSizes), false, "");
 
-        if (symbol >= SYMBOL_MAX_SIZE)
+        const auto chunkEnd = std::min<size_t>(offset + CHUNK_SIZE, size);
+        while (offset < chunkEnd)
         {
-            symbol -= SYMBOL_MAX_SIZE;
-            uint32 compressionSize = symbol & 0x000f;
-            symbol >>= 4;
+            // a symbol and the offset of a match use at most 30 bits
+            if (reader.GetBitsCount() < 2 * MAXIMUM_CODE_SIZE)
+            {
+                reader.Refill();
+                CHECK(!reader.IsOverrun(), false, "Unexpected end of the compressed data");
+            }
 
-            uint32 compressionOffset = 0;
-            if (symbol != 0)
+            uint32 symbol;
+            CHECK(table->GetSymbol(reader, symbol), false, "");
+            if (symbol < SYMBOL_MAX_SIZE)
             {
-                CHECK(stream.GetValue((uint8) symbol, compressionOffset), false, "");
+                output[offset++] = static_cast<uint8>(symbol);
+                continue;
             }
-            compressionOffset = (uint32) ((1 << symbol) | compressionOffset);
 
-            if (compressionSize == 15)
+            symbol -= SYMBOL_MAX_SIZE;
+            uint32 length           = symbol & 0x0F;
+            const uint32 offsetBits = symbol >> 4;
+            if (length == 15)
             {
                 uint8 val8;
-                CHECK(stream.Read<decltype(val8)>(val8), false, "");
-                compressionSize += val8;
-
-                if (compressionSize == 270)
+                CHECK(reader.Read(val8), false, "");
+                length += val8;
+                if (length == 270)
                 {
                     uint16 val16;
-                    CHECK(stream.Read<decltype(val16)>(val16), false, "");
-                    compressionSize = val16;
-
-                    if (compressionSize == 0)
+                    CHECK(reader.Read(val16), false, "");
+                    length = val16;
+                    if (length == 0)
                     {
-                        CHECK(stream.Read<decltype(compressionSize)>(compressionSize), false, "");
+                        CHECK(reader.Read(length), false, "");
                     }
+                    CHECK(length >= 15, false, "Invalid match length");
                 }
             }
-            compressionSize += 3;
-
-            CHECK(compressionOffset <= uncompressedDataOffset, false, "");
-            CHECK(compressionSize <= (uncompressed.GetLength() - uncompressedDataOffset), false, "");
+            CHECK(length <= UINT32_MAX - 3, false, "");
+            length += 3;
 
-            compressionOffset = (uint32) (uncompressedDataOffset - compressionOffset);
+            const size_t matchOffset = (1ULL << offsetBits) | reader.Get(offsetBits);
+            CHECK(matchOffset <= offset, false, "");
+            CHECK(length <= size - offset, false, "");
 
-            memcpy(uncompressed.GetData() + uncompressedDataOffset, uncompressed.GetData() + compressionOffset, compressionSize);
-            uncompressedDataOffset += compressionSize;
-            compressionOffset += compressionSize;
-            compressionSize = 0;
-
-            stream.Next();
+            CopyMatch(output + offset, matchOffset, length, outputEnd);
+            offset += length;
         }
     }
 
     return true;
 }
 
-bool Decompress_FallBack(const BufferView& compressed, Buffer& decompressed)
-{
-    Stream stream{};
-    CHECK(stream.Initialize(compressed.GetData(), compressed.GetLength()), false, "");
-
-    size_t offset = 0;
-    while (stream.GetOffset() < stream.GetSize() && offset < decompressed.GetLength())
-    {
-        stream.ResetBits();
-        CHECK(Update(stream, decompressed, offset), false, "");
-    }
-    CHECK(decompressed.GetLength() == offset, false, "");
-
-    return true;
-}
-
 bool Decompress(const BufferView& compressed, Buffer& decompressed)
 {
 #if defined(BUILD_FOR_WINDOWS)
@@ -438,4 +379,4 @@ bool Decompress(const BufferView& compressed, Buffer& decompressed)
 #endif
     return false;
 }
-} // namespace GView::Compression::LZXPRESS::Huffman
+} // namespace GView::Decoding::LZXPRESS::Huffman
@@ -3,6 +3,74 @@
 
 namespace GView::Decoding::ZLIB
 {
+constexpr uint32 INFLATE_WINDOW_SIZE = 0x10000;
+constexpr uint64 MAX_ZLIB_CHUNK      = 0x40000000; // avail_in / avail_out are 32 bits
+constexpr uint64 MAX_INITIAL_OUTPUT  = 0x400000;   // 4 MB - the output buffer is doubled when it is full
+
+namespace
+{
+    int GetWindowBits(Format format)
+    {
+        switch (format) {
+        case Format::Raw:
+            return -MAX_WBITS;
+        case Format::GZIP:
+            return MAX_WBITS + 16;
+        default:
+            return MAX_WBITS;
+        }
+    }
+
+    // the size of the output, if it can be found or estimated without decompressing
+    uint64 GetOutputSizeHint(const BufferView& input, Format format)
+    {
+        // gzip ends with the size of the data (modulo 4GB); deflate cannot compress more than ~1032:1
+        if ((format == Format::GZIP) && (input.GetLength() >= 18)) {
+            uint32 size;
+            memcpy(&size, input.GetData() + input.GetLength() - 4, sizeof(size));
+            if ((size >= input.GetLength() / 2) && (size <= input.GetLength() * 1032)) {
+                return size;
+            }
+        }
+        // the input might hold much more than one stream (e.g. a whole selection) => only a small first guess
+        return std::min<uint64>(input.GetLength() * 4, MAX_INITIAL_OUTPUT);
+    }
+
+    void FormatMessage(String& message, int ret, const z_stream& stream)
+    {
+        message.Format("Return code: %d with msg: %s", ret, stream.msg ? stream.msg : "");
+    }
+
+    struct ZWrapper {
+        z_stream& z;
+
+        ZWrapper(z_stream& z) : z(z)
+        {
+        }
+        ~ZWrapper()
+        {
+            inflateEnd(&z);
+        }
+    };
+} // namespace
+
+Format DetectFormat(BufferView input)
+{
+    if (input.GetLength() < 2) {
+        return Format::Raw;
+    }
+    const auto first  = input[0];
+    const auto second = input[1];
+    if ((first == 0x1F) && (second == 0x8B)) {
+        return Format::GZIP;
+    }
+    // CMF: deflate with a window of at most 32K, FLG: the check bits make CMF * 256 + FLG a multiple of 31
+    if (((first & 0x0F) == Z_DEFLATED) && ((first >> 4) <= 7) && (((first << 8) | second) % 31 == 0)) {
+        return Format::ZLIB;
+    }
+    return Format::Raw;
+}
+
 bool Decompress(const Buffer& input, uint64 inputSize, Buffer& output, uint64 outputSize)
 {
     CHECK(input.IsValid(), false, "");
@@ -11,59 +79,229 @@ bool Decompress(const Buffer& input, uint64 inputSize, Buffer& output, uint64 ou
 
     output.Resize(outputSize);
 
-    uint64 outputSizeCopy = outputSize;
-    int32 ret             = uncompress(output.GetData(), (uLongf*) &outputSizeCopy, input.GetData(), static_cast<uLong>(inputSize));
+    uLongf outputSizeCopy = static_cast<uLongf>(outputSize);
+    int32 ret             = uncompress(output.GetData(), &outputSizeCopy, input.GetData(), static_cast<uLong>(inputSize));
     CHECK(outputSize == outputSizeCopy, false, "ZLIB error: %d!", ret);
     CHECK(ret == Z_OK, false, "ZLIB error: %d!", ret);
 
     return true;
 }
 
-bool DecompressStream(const BufferView& input, Buffer& output, String& message, uint64& sizeConsumed)
+/*
+    The whole input is available => the output is decompressed in place (no intermediate window):
+    - the buffer starts with the size stored by gzip or with a small estimation and it is doubled when it is full (linear
+      amount of copying, limited by maxOutputSize)
+    - Z_FINISH lets zlib skip the allocation of its sliding window when the output fits
+*/
+bool DecompressStream(const BufferView& input, Buffer& output, String& message, uint64& sizeConsumed, Format format, uint64 maxOutputSize)
 {
     CHECK(input.IsValid(), false, "");
     CHECK(input.GetLength() > 0, false, "");
-    output.Resize(input.GetLength());
+    CHECK(maxOutputSize > 0, false, "");
     sizeConsumed = 0;
+    if (format == Format::Auto) {
+        format = DetectFormat(input);
+    }
 
     z_stream stream;
     memset(&stream, Z_NULL, sizeof(stream));
-
-    stream.avail_in  = static_cast<uInt>(input.GetLength());
-    stream.next_in   = const_cast<Bytef*>(input.GetData());
-    stream.avail_out = static_cast<uInt>(input.GetLength());
-    stream.next_out  = reinterpret_cast<Bytef*>(output.GetData());
-
-    int ret = inflateInit(&stream);
+    int ret = inflateInit2(&stream, GetWindowBits(format));
     CHECK(ret == Z_OK, false, "");
+    ZWrapper zWrapper(stream);
 
-    struct ZWrapper {
-        z_stream& z;
+    auto capacity = std::min<uint64>(std::max<uint64>(GetOutputSizeHint(input, format), 1), maxOutputSize);
+    output.Resize(capacity);
 
-        ZWrapper(z_stream& z) : z(z)
-        {
+    const auto inputStart = input.GetData();
+    const auto inputEnd   = inputStart + input.GetLength();
+    stream.next_in        = const_cast<Bytef*>(inputStart);
+    uint64 produced       = 0;
+    while (true) {
+        if (produced == capacity) {
+            if (capacity == maxOutputSize) {
+                output.Resize(produced);
+                message.Format("The decompressed data exceeds the limit of %llu bytes", maxOutputSize);
+                return false;
+            }
+            capacity = std::min<uint64>(capacity * 2, maxOutputSize);
+            output.Resize(capacity);
         }
-        ~ZWrapper()
-        {
-            inflateEnd(&z);
+        if (stream.avail_in == 0) {
+            stream.avail_in = static_cast<uInt>(std::min<uint64>(inputEnd - stream.next_in, MAX_ZLIB_CHUNK));
+        }
+        const auto lastInput = stream.next_in + stream.avail_in == inputEnd;
+        const auto space     = static_cast<uInt>(std::min<uint64>(capacity - produced, MAX_ZLIB_CHUNK));
+        stream.next_out      = reinterpret_cast<Bytef*>(output.GetData() + produced);
+        stream.avail_out     = space;
+
+        ret = inflate(&stream, lastInput ? Z_FINISH : Z_NO_FLUSH);
+        produced += space - stream.avail_out;
+        if (ret == Z_STREAM_END) {
+            break;
         }
-    } zWrapper(stream);
-
-    while (ret == Z_OK || ret == Z_BUF_ERROR) {
-        ret = inflate(&stream, Z_NO_FLUSH);
-        if (ret == Z_BUF_ERROR) {
-            output.Resize(stream.total_out * 2);
-            stream.avail_out = static_cast<uInt>(stream.total_out);
-            stream.next_out  = reinterpret_cast<Bytef*>(output.GetData() + stream.total_out);
+        // Z_BUF_ERROR => more output space (handled above) or the input is truncated
+        if ((ret == Z_BUF_ERROR) && lastInput && (stream.avail_in == 0) && (stream.avail_out > 0)) {
+            break;
         }
+        if ((ret != Z_OK) && (ret != Z_BUF_ERROR)) {
+            break;
+        }
+    }
+
+    output.Resize(produced);
+    sizeConsumed = static_cast<uint64>(stream.next_in - inputStart);
+    FormatMessage(message, ret, stream);
+
+    CHECK(ret == Z_STREAM_END, false, "");
+
+    return true;
+}
+
+bool DecompressStream(const BufferView& input, Buffer& output, String& message, uint64& sizeConsumed)
+{
+    // the callers expect a zlib stream (and an error for anything else) => no detection
+    return DecompressStream(input, output, message, sizeConsumed, Format::ZLIB, DEFAULT_MAX_OUTPUT_SIZE);
+}
+
+bool DecompressStream(const BufferView& input, const OutputCallback& output, String& message, uint64& sizeConsumed, Format format, uint64 maxOutputSize)
+{
+    CHECK(input.IsValid(), false, "");
+    CHECK(input.GetLength() > 0, false, "");
+    sizeConsumed = 0;
+
+    Inflater inflater;
+    CHECK(inflater.Init(format, maxOutputSize), false, "");
+    const auto result = inflater.Add(input, output, sizeConsumed);
+    message.Format("%s", inflater.GetMessage());
+    CHECK(result, false, "");
+    if (!inflater.IsFinished()) {
+        message.Format("Truncated stream");
+        return false;
     }
 
-    output.Resize(stream.total_out);
-    sizeConsumed = stream.total_in;
-    message.Format("Return code: %d with msg: %s", ret, stream.msg);
+    return true;
+}
+
+Inflater::Inflater() : stream(nullptr), format(Format::Auto), maxOutputSize(0), outputSize(0), header{ 0, 0 }, headerSize(0), finished(false)
+{
+}
 
-    CHECK(ret == Z_OK || ret == Z_STREAM_END, false, "");
+Inflater::~Inflater()
+{
+    if (stream) {
+        inflateEnd(reinterpret_cast<z_stream*>(stream));
+        delete reinterpret_cast<z_stream*>(stream);
+    }
+}
+
+bool Inflater::Init(Format format, uint64 maxOutputSize)
+{
+    CHECK(maxOutputSize > 0, false, "");
+    if (stream) {
+        inflateEnd(reinterpret_cast<z_stream*>(stream));
+        delete reinterpret_cast<z_stream*>(stream);
+        stream = nullptr;
+    }
+    this->format        = format;
+    this->maxOutputSize = maxOutputSize;
+    outputSize          = 0;
+    headerSize          = 0;
+    finished            = false;
+    message.clear();
+    window.Resize(INFLATE_WINDOW_SIZE);
 
+    // auto => the format is known once the first 2 bytes arrive
+    return (format == Format::Auto) || Start(format);
+}
+
+bool Inflater::Start(Format streamFormat)
+{
+    auto z = new z_stream;
+    memset(z, Z_NULL, sizeof(*z));
+    if (inflateInit2(z, GetWindowBits(streamFormat)) != Z_OK) {
+        delete z;
+        message = "Fail to initialize zlib";
+        return false;
+    }
+    stream = z;
+    format = streamFormat;
+    return true;
+}
+
+bool Inflater::Inflate(const uint8* data, uint64 size, const OutputCallback& output, uint64& sizeConsumed)
+{
+    auto z = reinterpret_cast<z_stream*>(stream);
+    for (uint64 done = 0; (done < size) && !finished;) {
+        const auto chunk = static_cast<uInt>(std::min<uint64>(size - done, MAX_ZLIB_CHUNK));
+        z->next_in       = const_cast<Bytef*>(data + done);
+        z->avail_in      = chunk;
+
+        while (true) {
+            z->next_out     = reinterpret_cast<Bytef*>(window.GetData());
+            z->avail_out    = INFLATE_WINDOW_SIZE;
+            const auto ret      = inflate(z, Z_NO_FLUSH);
+            const auto produced = INFLATE_WINDOW_SIZE - z->avail_out;
+            if (produced > 0) {
+                if (outputSize + produced > maxOutputSize) {
+                    message = "The decompressed data exceeds the limit of " + std::to_string(maxOutputSize) + " bytes";
+                    return false;
+                }
+                outputSize += produced;
+                if (!output(BufferView(window.GetData(), produced))) {
+                    message = "Stopped";
+                    return false;
+                }
+            }
+            if (ret == Z_STREAM_END) {
+                finished = true;
+                break;
+            }
+            if ((ret != Z_OK) && (ret != Z_BUF_ERROR)) {
+                message = std::string("Return code: ") + std::to_string(ret) + " with msg: " + (z->msg ? z->msg : "");
+                return false;
+            }
+            // the window was not filled => all the input was used
+            if (z->avail_out > 0) {
+                break;
+            }
+        }
+
+        const auto used = chunk - z->avail_in;
+        done += used;
+        sizeConsumed += used;
+    }
     return true;
 }
-} // namespace GView::ZLIB
+
+bool Inflater::Add(BufferView input, const OutputCallback& output, uint64& sizeConsumed)
+{
+    sizeConsumed = 0;
+    CHECK(window.GetLength() > 0, false, "Init was not called");
+    if (finished || (input.GetLength() == 0)) {
+        return true;
+    }
+
+    auto data = input.GetData();
+    auto size = static_cast<uint64>(input.GetLength());
+    if (stream == nullptr) {
+        // auto detection => the first 2 bytes are kept until they are both available
+        while ((headerSize < 2) && (size > 0)) {
+            header[headerSize++] = *data++;
+            size--;
+            sizeConsumed++;
+        }
+        if (headerSize < 2) {
+            return true;
+        }
+        CHECK(Start(DetectFormat(BufferView(header, 2))), false, "");
+        uint64 headerConsumed = 0;
+        CHECK(Inflate(header, 2, output, headerConsumed), false, "");
+        if (finished) {
+            // a stream that ends within its first 2 bytes cannot use anything from this chunk
+            sizeConsumed -= std::min<uint64>(sizeConsumed, 2 - headerConsumed);
+            return true;
+        }
+    }
+    return Inflate(data, size, output, sizeConsumed);
+}
+} // namespace GView::Decoding::ZLIB
@@ -4,15 +4,40 @@
 #include <array>
 
 constexpr uint32 MAX_NUMBER_OF_BYTES = 256;
+constexpr uint32 HISTOGRAM_BANKS     = 4;
 
 namespace GView::Entropy
 {
-void SetFrequencies(const BufferView& buffer, std::array<char, MAX_NUMBER_OF_BYTES>& frequency)
+/*
+    Counting into a single table stalls on runs of the same byte (every increment waits for the previous store to the
+    same counter). Consecutive bytes are spread over 4 separate tables (banks) instead and the banks are added together
+    at the end. The input is read 8 bytes at a time.
+*/
+void AddFrequencies(const BufferView& buffer, Frequencies& frequency)
 {
-    // Count frequency of each byte in the buffer
-    for (uint32 i = 0; i < buffer.GetLength(); i++) {
-        const auto c = buffer[i];
-        frequency[c]++;
+    uint32 banks[HISTOGRAM_BANKS][MAX_NUMBER_OF_BYTES] = {};
+
+    auto p         = buffer.GetData();
+    const auto e   = p + buffer.GetLength();
+    const auto end = p + (buffer.GetLength() & ~static_cast<size_t>(7));
+    for (; p < end; p += 8) {
+        uint64 v;
+        memcpy(&v, p, sizeof(v));
+        banks[0][v & 0xFF]++;
+        banks[1][(v >> 8) & 0xFF]++;
+        banks[2][(v >> 16) & 0xFF]++;
+        banks[3][(v >> 24) & 0xFF]++;
+        banks[0][(v >> 32) & 0xFF]++;
+        banks[1][(v >> 40) & 0xFF]++;
+        banks[2][(v >> 48) & 0xFF]++;
+        banks[3][v >> 56]++;
+    }
+    for (; p < e; p++) {
+        banks[0][*p]++;
+    }
+
+    for (uint32 i = 0; i < MAX_NUMBER_OF_BYTES; i++) {
+        frequency[i] += banks[0][i] + banks[1][i] + banks[2][i] + banks[3][i];
     }
 }
 
@@ -27,14 +52,18 @@ void SetFrequencies(const BufferView& buffer, std::array<char, MAX_NUMBER_OF_BYT
     The joint entropy of variables X_1, ..., X_n is then defined by
     H(X_1, ..., X_n) congruent - sum_(x_1) ... sum_(x_n) P(x_1, ..., x_n) log_2[P(x_1, ..., x_n)].
 */
-double ShannonEntropy_private(const BufferView& buffer, std::array<char, MAX_NUMBER_OF_BYTES>& frequency)
+double ShannonEntropy(const Frequencies& frequency, uint64 count)
 {
+    if (count == 0) {
+        return 0.0;
+    }
+
     double entropy = 0.0;
     for (auto f : frequency) {
         if (f == 0) {
             continue;
         }
-        double probability = static_cast<double>(f) / buffer.GetLength();
+        double probability = static_cast<double>(f) / count;
         entropy -= probability * log2(probability);
     }
 
@@ -43,9 +72,9 @@ double ShannonEntropy_private(const BufferView& buffer, std::array<char, MAX_NUM
 
 double ShannonEntropy(const BufferView& buffer)
 {
-    std::array<char, MAX_NUMBER_OF_BYTES> frequency{};
-    SetFrequencies(buffer, frequency);
-    return ShannonEntropy_private(buffer, frequency);
+    Frequencies frequency{};
+    AddFrequencies(buffer, frequency);
+    return ShannonEntropy(frequency, buffer.GetLength());
 }
 
 /*
@@ -56,19 +85,19 @@ double ShannonEntropy(const BufferView& buffer)
     H_α(p_1, p_2, ..., p_n)<=H_α'(p_1, p_2, ..., p_n)
     for α<=α'.
 */
-double RenyiEntropy(const BufferView& buffer, double alpha)
+double RenyiEntropy(const Frequencies& frequency, uint64 count, double alpha)
 {
-    std::array<char, MAX_NUMBER_OF_BYTES> frequency{};
-    SetFrequencies(buffer, frequency);
-
     if (alpha == 1.0) {
-        return ShannonEntropy_private(buffer, frequency);
+        return ShannonEntropy(frequency, count);
+    }
+    if (count == 0) {
+        return 0.0;
     }
 
     double sum = 0.0;
     for (auto f : frequency) {
         if (f > 0) {
-            const double probability = static_cast<double>(f) / buffer.GetLength();
+            const double probability = static_cast<double>(f) / count;
             sum += pow(probability, alpha);
         }
     }
@@ -77,4 +106,89 @@ double RenyiEntropy(const BufferView& buffer, double alpha)
     // return std::max(((1.0 / (1.0 - alpha)) * log(sum)) / log(2), 0.0);
     return ((1.0 / (1.0 - alpha)) * log(sum)) / log(2);
 }
+
+double RenyiEntropy(const BufferView& buffer, double alpha)
+{
+    Frequencies frequency{};
+    AddFrequencies(buffer, frequency);
+    return RenyiEntropy(frequency, buffer.GetLength(), alpha);
+}
+
+/*
+    With N bytes in the window and f_i the frequency of byte i:
+    H = - sum_i (f_i / N) log_2(f_i / N) = log_2(N) - (1 / N) sum_i f_i log_2(f_i)
+    Adding / removing a byte changes a single f_i => the sum is updated with two lookups in a table of f log_2(f).
+    The frequencies are exact (integers) but the running sum collects rounding errors with every update => it is rebuilt
+    from the frequencies every RESYNC_STEPS updates (256 lookups, O(1) per byte amortized), so it never drifts.
+*/
+constexpr uint32 RESYNC_STEPS = 4096;
+
+SlidingWindowEntropy::SlidingWindowEntropy(uint32 windowSize)
+    : window(std::max<uint32>(windowSize, 1)), weights(static_cast<size_t>(std::max<uint32>(windowSize, 1)) + 1)
+{
+    for (uint32 f = 1; f < static_cast<uint32>(weights.size()); f++) {
+        weights[f] = f * log2(static_cast<double>(f));
+    }
+    Reset();
+}
+
+void SlidingWindowEntropy::Reset()
+{
+    frequency.fill(0);
+    position = 0;
+    count    = 0;
+    steps    = 0;
+    sum      = 0.0;
+}
+
+void SlidingWindowEntropy::Resync()
+{
+    sum = 0.0;
+    for (uint32 i = 0; i < MAX_NUMBER_OF_BYTES; i++) {
+        sum += weights[frequency[i]];
+    }
+    steps = 0;
+}
+
+void SlidingWindowEntropy::Add(uint8 value)
+{
+    if (count == window.size()) {
+        // the oldest byte leaves the window
+        auto& f = frequency[window[position]];
+        sum += weights[f - 1] - weights[f];
+        f--;
+    } else {
+        count++;
+    }
+
+    auto& f = frequency[value];
+    sum += weights[f + 1] - weights[f];
+    f++;
+
+    window[position] = value;
+    if (++position == window.size()) {
+        position = 0;
+    }
+
+    if (++steps == RESYNC_STEPS) {
+        Resync();
+    }
+}
+
+void SlidingWindowEntropy::Add(const BufferView& buffer)
+{
+    for (size_t i = 0; i < buffer.GetLength(); i++) {
+        Add(buffer[i]);
+    }
+}
+
+double SlidingWindowEntropy::GetShannonEntropy() const
+{
+    if (count == 0) {
+        return 0.0;
+    }
+    // at most RESYNC_STEPS updates of rounding error => only the last ulps have to be kept within [0, 8]
+    const auto entropy = log2(static_cast<double>(count)) - sum / count;
+    return std::min<double>(std::max<double>(entropy, 0.0), 8.0);
+}
 } // namespace GView::Entropy
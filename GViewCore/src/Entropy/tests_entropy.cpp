@@ -0,0 +1,36 @@
+#include <catch.hpp>
+#include "Internal.hpp"
+
+#include <math.h>
+#include <vector>
+
+using namespace GView::Entropy;
+
+TEST_CASE("SlidingWindowEntropy", "[Entropy]SlidingWindow")
+{
+    constexpr uint32 windowSize = 1024;
+
+    // skewed pseudo-random bytes (LCG) => the frequencies keep changing as the window slides
+    std::vector<uint8> data(1 << 20);
+    uint32 seed = 0x12345678;
+    for (auto& b : data) {
+        seed = seed * 1103515245 + 12345;
+        b    = static_cast<uint8>((seed >> 16) & ((seed >> 30) ? 0xFF : 0x0F));
+    }
+
+    SlidingWindowEntropy sliding(windowSize);
+    for (size_t i = 0; i < data.size(); i++) {
+        sliding.Add(data[i]);
+        // many slides later it must still match the entropy computed from scratch on the same window
+        if (((i + 1) % 65537) == 0 || i + 1 == data.size()) {
+            const auto start    = (i + 1) - std::min<size_t>(i + 1, windowSize);
+            const auto expected = ShannonEntropy(BufferView(data.data() + start, (i + 1) - start));
+            REQUIRE(sliding.IsFull());
+            REQUIRE(fabs(sliding.GetShannonEntropy() - expected) < 1e-9);
+        }
+    }
+
+    sliding.Reset();
+    REQUIRE(sliding.GetCount() == 0);
+    REQUIRE(sliding.GetShannonEntropy() == 0.0);
+}
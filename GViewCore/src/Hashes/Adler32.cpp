@@ -1,9 +1,9 @@
-#include "Internal.hpp"
+#include "Slicing.hpp"
 
 namespace GView::Hashes
 {
 constexpr uint32 ADLER32_BASE         = 65521;
-constexpr uint32 ADLER32_MODULO_VALUE = 8;
+constexpr uint32 ADLER32_NMAX         = 5552; // largest n such that 255n(n+1)/2 + (n+1)(BASE-1) fits in 32 bits
 
 bool Adler32::Init()
 {
@@ -15,6 +15,40 @@ bool Adler32::Init()
     return true;
 }
 
+#ifdef HASHES_SSE2
+// processes a block (at most ADLER32_NMAX bytes, multiple of 16) => s1 and s2 are not reduced
+static void UpdateBlockSSE2(uint32& s1, uint32& s2, const uint8* input, uint32 length)
+{
+    const auto zero      = _mm_setzero_si128();
+    const auto weightsLo = _mm_setr_epi16(16, 15, 14, 13, 12, 11, 10, 9);
+    const auto weightsHi = _mm_setr_epi16(8, 7, 6, 5, 4, 3, 2, 1);
+
+    auto vs1      = zero; // sum of bytes
+    auto vs1Prior = zero; // sum of vs1 before every 16 bytes chunk
+    auto vs2      = zero; // weighted sum of bytes
+    for (auto i = 0U; i < length; i += 16)
+    {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        vs1Prior     = _mm_add_epi32(vs1Prior, vs1);
+        vs1          = _mm_add_epi32(vs1, _mm_sad_epu8(v, zero));
+        vs2          = _mm_add_epi32(vs2, _mm_madd_epi16(_mm_unpacklo_epi8(v, zero), weightsLo));
+        vs2          = _mm_add_epi32(vs2, _mm_madd_epi16(_mm_unpackhi_epi8(v, zero), weightsHi));
+    }
+
+    alignas(16) uint32 r1[4], rPrior[4], r2[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(r1), vs1);
+    _mm_store_si128(reinterpret_cast<__m128i*>(rPrior), vs1Prior);
+    _mm_store_si128(reinterpret_cast<__m128i*>(r2), vs2);
+
+    const uint64 sum1  = static_cast<uint64>(r1[0]) + r1[2];
+    const uint64 prior = static_cast<uint64>(rPrior[0]) + rPrior[2];
+    const uint64 sum2  = static_cast<uint64>(r2[0]) + r2[1] + r2[2] + r2[3];
+
+    s2 = static_cast<uint32>((s2 + static_cast<uint64>(s1) * length + prior * 16 + sum2) % ADLER32_BASE);
+    s1 = static_cast<uint32>((s1 + sum1) % ADLER32_BASE);
+}
+#endif
+
 bool Adler32::Update(const unsigned char* input, uint32 length)
 {
     CHECK(input != nullptr, false, "");
@@ -22,48 +56,49 @@ bool Adler32::Update(const unsigned char* input, uint32 length)
     uint32 s1 = a;
     uint32 s2 = b;
 
-    if (length % ADLER32_MODULO_VALUE != 0)
+    while (length > 0)
     {
-        do
-        {
-            s1 += *input++;
-            s2 += s1;
-            length--;
-        } while (length % ADLER32_MODULO_VALUE != 0);
+        auto n = std::min<>(length, ADLER32_NMAX);
+        length -= n;
 
-        if (s1 >= ADLER32_BASE)
+#ifdef HASHES_SSE2
+        const auto vectorSize = n & ~15U;
+        if (vectorSize > 0)
         {
-            s1 -= ADLER32_BASE;
+            UpdateBlockSSE2(s1, s2, input, vectorSize);
+            input += vectorSize;
+            n -= vectorSize;
         }
-        s2 %= ADLER32_BASE;
-    }
-
-    while (length > 0)
-    {
-        s1 += input[0];
-        s2 += s1;
-        s1 += input[1];
-        s2 += s1;
-        s1 += input[2];
-        s2 += s1;
-        s1 += input[3];
-        s2 += s1;
-        s1 += input[4];
-        s2 += s1;
-        s1 += input[5];
-        s2 += s1;
-        s1 += input[6];
-        s2 += s1;
-        s1 += input[7];
-        s2 += s1;
-
-        length -= ADLER32_MODULO_VALUE;
-        input += ADLER32_MODULO_VALUE;
-
-        if (s1 >= ADLER32_BASE)
+#endif
+        while (n >= 8)
         {
-            s1 -= ADLER32_BASE;
+            s1 += input[0];
+            s2 += s1;
+            s1 += input[1];
+            s2 += s1;
+            s1 += input[2];
+            s2 += s1;
+            s1 += input[3];
+            s2 += s1;
+            s1 += input[4];
+            s2 += s1;
+            s1 += input[5];
+            s2 += s1;
+            s1 += input[6];
+            s2 += s1;
+            s1 += input[7];
+            s2 += s1;
+            input += 8;
+            n -= 8;
         }
+        while (n > 0)
+        {
+            s1 += *input++;
+            s2 += s1;
+            n--;
+        }
+
+        s1 %= ADLER32_BASE;
         s2 %= ADLER32_BASE;
     }
 
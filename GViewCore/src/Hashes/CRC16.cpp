@@ -1,8 +1,8 @@
-#include "Internal.hpp"
+#include "Slicing.hpp"
 
 namespace GView::Hashes
 {
-static const uint16_t CRC16FalseTable[] = {
+static constexpr uint16 CRC16FalseTable[256] = {
     0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7, 0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
     0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6, 0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
     0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485, 0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
@@ -21,6 +21,8 @@ static const uint16_t CRC16FalseTable[] = {
     0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8, 0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
 };
 
+static constexpr auto CRC16FalseTables = Slicing::MakeNormalTables<uint16, 16, 8>(CRC16FalseTable);
+
 bool CRC16::Init()
 {
     value = 0x0000;
@@ -33,7 +35,16 @@ bool CRC16::Update(const unsigned char* input, uint32 length)
 {
     CHECK(input != nullptr, false, "");
 
-    for (auto i = 0U; i < length; i++)
+    // slice-by-8 => only the first two bytes are affected by the current value
+    const auto& t = CRC16FalseTables;
+    auto i        = 0U;
+    for (; i + 8 <= length; i += 8)
+    {
+        const auto* p = input + i;
+        value         = t[7][(value >> 8) ^ p[0]] ^ t[6][(value & 0xFF) ^ p[1]] ^ t[5][p[2]] ^ t[4][p[3]] ^ t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^
+                t[0][p[7]];
+    }
+    for (; i < length; i++)
     {
         const uint16 j = value >> 8 ^ input[i];
         value          = (uint16) (value << 8 ^ CRC16FalseTable[j]);
@@ -1,8 +1,8 @@
-#include "Internal.hpp"
+#include "Slicing.hpp"
 
 namespace GView::Hashes
 {
-static const uint32 CRC32Table[] = {
+static constexpr uint32 CRC32Table[256] = {
     0x00000000L, 0x77073096L, 0xee0e612cL, 0x990951baL, 0x076dc419L, 0x706af48fL, 0xe963a535L, 0x9e6495a3L, 0x0edb8832L, 0x79dcb8a4L,
     0xe0d5e91eL, 0x97d2d988L, 0x09b64c2bL, 0x7eb17cbdL, 0xe7b82d07L, 0x90bf1d91L, 0x1db71064L, 0x6ab020f2L, 0xf3b97148L, 0x84be41deL,
     0x1adad47dL, 0x6ddde4ebL, 0xf4d4b551L, 0x83d385c7L, 0x136c9856L, 0x646ba8c0L, 0xfd62f97aL, 0x8a65c9ecL, 0x14015c4fL, 0x63066cd9L,
@@ -31,6 +31,98 @@ static const uint32 CRC32Table[] = {
     0x5d681b02L, 0x2a6f2b94L, 0xb40bbe37L, 0xc30c8ea1L, 0x5a05df1bL, 0x2d02ef8dL
 };
 
+static constexpr auto CRC32Tables = Slicing::MakeReflectedTables<uint32, 16>(CRC32Table);
+
+static uint32 UpdateSliceBy16(uint32 crc, const uint8* input, uint32 length)
+{
+    const auto& t = CRC32Tables;
+    while (length >= 16)
+    {
+        const auto a = Slicing::Load32(input) ^ crc;
+        const auto b = Slicing::Load32(input + 4);
+        const auto c = Slicing::Load32(input + 8);
+        const auto d = Slicing::Load32(input + 12);
+        crc = t[15][a & 0xFF] ^ t[14][(a >> 8) & 0xFF] ^ t[13][(a >> 16) & 0xFF] ^ t[12][a >> 24] ^ t[11][b & 0xFF] ^ t[10][(b >> 8) & 0xFF] ^
+              t[9][(b >> 16) & 0xFF] ^ t[8][b >> 24] ^ t[7][c & 0xFF] ^ t[6][(c >> 8) & 0xFF] ^ t[5][(c >> 16) & 0xFF] ^ t[4][c >> 24] ^
+              t[3][d & 0xFF] ^ t[2][(d >> 8) & 0xFF] ^ t[1][(d >> 16) & 0xFF] ^ t[0][d >> 24];
+        input += 16;
+        length -= 16;
+    }
+    while (length--)
+    {
+        crc = CRC32Table[(crc & 0xff) ^ *input++] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#ifdef HASHES_X86
+// carry-less multiplication folding ("Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction", Intel)
+HASHES_TARGET("pclmul,sse4.1") static inline __m128i FoldPCLMUL(__m128i value, __m128i next, __m128i k)
+{
+    return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(value, k, 0x11), _mm_clmulepi64_si128(value, k, 0x00)), next);
+}
+// length must be a multiple of 16 and at least 64
+HASHES_TARGET("pclmul,sse4.1") static uint32 UpdatePCLMUL(uint32 crc, const uint8* input, uint32 length)
+{
+    alignas(16) static const uint64 k1k2[] = { 0x0154442bd4, 0x01c6e41596 };
+    alignas(16) static const uint64 k3k4[] = { 0x01751997d0, 0x00ccaa009e };
+    alignas(16) static const uint64 k5k0[] = { 0x0163cd6124, 0x0000000000 };
+    alignas(16) static const uint64 poly[] = { 0x01db710641, 0x01f7011641 };
+
+    auto load = [](const uint8* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); };
+
+    auto x1 = _mm_xor_si128(load(input), _mm_cvtsi32_si128(static_cast<int>(crc)));
+    auto x2 = load(input + 16);
+    auto x3 = load(input + 32);
+    auto x4 = load(input + 48);
+    input += 64;
+    length -= 64;
+
+    // fold 4 x 128 bits at a time
+    auto k = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+    while (length >= 64)
+    {
+        auto x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+        auto x6 = _mm_clmulepi64_si128(x2, k, 0x00);
+        auto x7 = _mm_clmulepi64_si128(x3, k, 0x00);
+        auto x8 = _mm_clmulepi64_si128(x4, k, 0x00);
+        x1      = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), x5), load(input));
+        x2      = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x2, k, 0x11), x6), load(input + 16));
+        x3      = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x3, k, 0x11), x7), load(input + 32));
+        x4      = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x4, k, 0x11), x8), load(input + 48));
+        input += 64;
+        length -= 64;
+    }
+
+    // fold into a single 128 bit value
+    k  = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+    x1 = FoldPCLMUL(x1, x2, k);
+    x1 = FoldPCLMUL(x1, x3, k);
+    x1 = FoldPCLMUL(x1, x4, k);
+    while (length >= 16)
+    {
+        x1 = FoldPCLMUL(x1, load(input), k);
+        input += 16;
+        length -= 16;
+    }
+
+    // 128 -> 64 bits
+    const auto mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x2                = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1                = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    k                 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+    x2                = _mm_srli_si128(x1, 4);
+    x1                = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x00), x2);
+
+    // Barrett reduction (64 -> 32 bits)
+    k  = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask32), k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return static_cast<uint32>(_mm_extract_epi32(x1, 1));
+}
+#endif
+
 bool CRC32::Init(CRC32Type type)
 {
     this->type = type;
@@ -45,12 +137,16 @@ bool CRC32::Update(const unsigned char* input, uint32 length)
     CHECK(input != nullptr, false, "");
     uint32 crc = value;
 
-    while (length--)
+#ifdef HASHES_X86
+    if ((length >= 64) && Slicing::HasPCLMUL())
     {
-        crc = CRC32Table[(crc & 0xff) ^ *input++] ^ (crc >> 8);
+        const auto size = length & ~15U;
+        crc             = UpdatePCLMUL(crc, input, size);
+        input += size;
+        length -= size;
     }
-
-    value = crc;
+#endif
+    value = UpdateSliceBy16(crc, input, length);
 
     return true;
 }
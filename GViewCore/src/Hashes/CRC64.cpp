@@ -1,8 +1,8 @@
-#include "Internal.hpp"
+#include "Slicing.hpp"
 
 namespace GView::Hashes
 {
-static const uint64 CRC64Table[256] = {
+static constexpr uint64 CRC64Table[256] = {
     0x0000000000000000, 0x42F0E1EBA9EA3693, 0x85E1C3D753D46D26, 0xC711223CFA3E5BB5, 0x493366450E42ECDF, 0x0BC387AEA7A8DA4C,
     0xCCD2A5925D9681F9, 0x8E224479F47CB76A, 0x9266CC8A1C85D9BE, 0xD0962D61B56FEF2D, 0x17870F5D4F51B498, 0x5577EEB6E6BB820B,
     0xDB55AACF12C73561, 0x99A54B24BB2D03F2, 0x5EB4691841135847, 0x1C4488F3E8F96ED4, 0x663D78FF90E185EF, 0x24CD9914390BB37C,
@@ -48,6 +48,8 @@ static const uint64 CRC64Table[256] = {
     0x5DEDC41A34BBEEB2, 0x1F1D25F19D51D821, 0xD80C07CD676F8394, 0x9AFCE626CE85B507
 };
 
+static constexpr auto CRC64Tables = Slicing::MakeNormalTables<uint64, 64, 8>(CRC64Table);
+
 bool CRC64::Final()
 {
     CHECK(init, false, "");
@@ -68,8 +70,18 @@ bool CRC64::Init(CRC64Type type)
 bool CRC64::Update(const unsigned char* input, uint32 length)
 {
     CHECK(input != nullptr, false, "");
-    uint64 crc = value;
+    uint64 crc    = value;
+    const auto& t = CRC64Tables;
 
+    // slice-by-8 (the CRC is MSB first => the bytes are read as a big endian value)
+    while (length >= 8)
+    {
+        const auto x = Slicing::Load64BigEndian(input) ^ crc;
+        crc = t[7][x >> 56] ^ t[6][(x >> 48) & 0xFF] ^ t[5][(x >> 40) & 0xFF] ^ t[4][(x >> 32) & 0xFF] ^ t[3][(x >> 24) & 0xFF] ^
+              t[2][(x >> 16) & 0xFF] ^ t[1][(x >> 8) & 0xFF] ^ t[0][x & 0xFF];
+        input += 8;
+        length -= 8;
+    }
     while (length--)
     {
         uint64 i = ((uint64) (crc >> 56) ^ *input++) & 0xFF;
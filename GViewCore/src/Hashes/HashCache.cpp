@@ -0,0 +1,479 @@
+#include "Internal.hpp"
+
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace GView::Hashes
+{
+constexpr uint32 HASH_CACHE_MAGIC   = 0x43485647; // GVHC
+constexpr uint32 HASH_CACHE_VERSION = 2;
+constexpr uint32 SAMPLE_SIZE        = 0x10000; // first and last 64K of the file are part of its identity
+
+PiecewiseHash::PiecewiseHash(OpenSSLHashKind kind, uint32 blockSize)
+    : kind(kind), current(nullptr), blockSize(std::max<uint32>(blockSize, 1)), blockLeft(0)
+{
+}
+PiecewiseHash::~PiecewiseHash()
+{
+    delete current;
+}
+bool PiecewiseHash::Update(const void* input, uint32 length)
+{
+    auto p = reinterpret_cast<const uint8*>(input);
+    while (length > 0)
+    {
+        if (current == nullptr)
+        {
+            current   = new OpenSSLHash(kind);
+            blockLeft = blockSize;
+        }
+        const auto size = std::min<uint32>(length, blockLeft);
+        CHECK(current->Update(p, size), false, "");
+        p += size;
+        length -= size;
+        blockLeft -= size;
+        if (blockLeft == 0)
+        {
+            CHECK(Final(), false, "");
+        }
+    }
+    return true;
+}
+bool PiecewiseHash::Final()
+{
+    if (current == nullptr)
+        return true;
+    blocks.emplace_back(current->GetHexValue());
+    delete current;
+    current = nullptr;
+    return !blocks.back().empty();
+}
+
+namespace
+{
+    using DigestKey = std::tuple<std::string, uint64, uint64>;         // algorithm, offset, size
+    using BlocksKey = std::tuple<std::string, uint64, uint64, uint32>; // algorithm, offset, size, block size
+
+    struct CachedFile
+    {
+        uint64 size{ 0 };
+        int64 lastWriteTime{ 0 };
+        std::string sample;
+        std::map<DigestKey, std::string> digests;
+        std::map<BlocksKey, std::vector<std::string>> blocks;
+        uint32 batches{ 0 };
+        bool modified{ false };
+    };
+
+    std::mutex cacheLock;
+    std::map<std::u16string, CachedFile, std::less<>> cachedFiles;
+
+    bool IsSameLocationAsAnalyzedFile()
+    {
+        auto ini = AppCUI::Application::GetAppSettings();
+        if (ini == nullptr)
+            return false;
+        auto sect = ini->GetSection("GView");
+        if (!sect.Exists())
+            return false;
+        return sect.GetValue("Config.HashCacheSameLocationAsAnalyzedFile").ToBool(false);
+    }
+
+    std::filesystem::path GetUserCacheFolder()
+    {
+#ifdef BUILD_FOR_WINDOWS
+        if (auto p = std::getenv("LOCALAPPDATA"); p && *p)
+            return std::filesystem::path(p) / "GView" / "HashCache";
+#else
+        if (auto p = std::getenv("XDG_CACHE_HOME"); p && *p)
+            return std::filesystem::path(p) / "gview" / "hashes";
+        if (auto p = std::getenv("HOME"); p && *p)
+            return std::filesystem::path(p) / ".cache" / "gview" / "hashes";
+#endif
+        std::error_code ec;
+        return std::filesystem::temp_directory_path(ec) / "gview-hashes";
+    }
+
+    std::filesystem::path GetCacheFilePath(std::u16string_view filePath)
+    {
+        // by default nothing is written next to the analyzed file (it could be evidence) => one file per analyzed file
+        // in a per user folder, named after the hash of its full path (the path is also stored in the file)
+        if (IsSameLocationAsAnalyzedFile())
+        {
+            std::filesystem::path path = filePath;
+            path += ".hashes.cache";
+            return path;
+        }
+        uint64 hash = 0xcbf29ce484222325ULL;
+        for (auto ch : filePath)
+            hash = (hash ^ ch) * 0x00000100000001B3ULL;
+        LocalString<32> name;
+        name.SetFormat("%016llX.hashes.cache", hash);
+
+        auto folder = GetUserCacheFolder();
+        std::error_code ec;
+        std::filesystem::create_directories(folder, ec);
+        return folder / name.GetText();
+    }
+
+    std::string ComputeSample(Reference<Object> object, uint64 size)
+    {
+        // size and last write time can be preserved (or set back) by whoever changed the file => the first and the
+        // last bytes of the file are checked as well
+        OpenSSLHash sample(OpenSSLHashKind::Sha1);
+        auto& cache = object->GetData();
+        for (auto offset : { 0ULL, size > SAMPLE_SIZE ? size - SAMPLE_SIZE : 0ULL })
+        {
+            const auto toRead = static_cast<uint32>(std::min<uint64>(size - offset, SAMPLE_SIZE));
+            if (toRead == 0)
+                continue;
+            auto buffer = cache.CopyToBuffer(offset, toRead, true);
+            CHECK(buffer.IsValid(), "", "");
+            CHECK(sample.Update(buffer.GetData(), toRead), "", "");
+        }
+        CHECK(sample.Final(), "", "");
+        return std::string(sample.GetHexValue());
+    }
+
+    class Writer
+    {
+        std::vector<uint8> data;
+
+      public:
+        template <typename T>
+        void Add(T value)
+        {
+            auto p = reinterpret_cast<const uint8*>(&value);
+            data.insert(data.end(), p, p + sizeof(T));
+        }
+        void AddString(std::string_view value)
+        {
+            Add(static_cast<uint32>(value.size()));
+            data.insert(data.end(), value.begin(), value.end());
+        }
+        inline BufferView GetData() const
+        {
+            return { data.data(), data.size() };
+        }
+    };
+    class Reader
+    {
+        const uint8* p;
+        const uint8* e;
+
+      public:
+        Reader(BufferView buf) : p(buf.GetData()), e(buf.GetData() + buf.GetLength())
+        {
+        }
+        template <typename T>
+        bool Get(T& value)
+        {
+            CHECK(p + sizeof(T) <= e, false, "");
+            memcpy(&value, p, sizeof(T));
+            p += sizeof(T);
+            return true;
+        }
+        bool GetString(std::string& value)
+        {
+            uint32 size;
+            CHECK(Get(size), false, "");
+            CHECK(size <= static_cast<uint64>(e - p), false, "");
+            value.assign(reinterpret_cast<const char*>(p), size);
+            p += size;
+            return true;
+        }
+    };
+
+    bool LoadCacheFile(std::u16string_view filePath, CachedFile& file)
+    {
+        auto content = AppCUI::OS::File::ReadContent(GetCacheFilePath(filePath));
+        if (content.GetLength() == 0)
+            return false;
+
+        Reader r(content);
+        uint32 magic, version, count;
+        uint64 size;
+        int64 lastWriteTime;
+        std::string path, sample;
+        CHECK(r.Get(magic) && (magic == HASH_CACHE_MAGIC), false, "");
+        CHECK(r.Get(version) && (version == HASH_CACHE_VERSION), false, "");
+        CHECK(r.GetString(path) && r.Get(size) && r.Get(lastWriteTime) && r.GetString(sample), false, "");
+        // another file with the same path hash
+        if (path != std::filesystem::path(filePath).u8string())
+            return false;
+        // the file was modified => the cached hashes are no longer valid
+        if ((size != file.size) || (lastWriteTime != file.lastWriteTime) || (sample != file.sample))
+            return false;
+
+        CHECK(r.Get(count), false, "");
+        for (auto idx = 0U; idx < count; idx++)
+        {
+            DigestKey key;
+            std::string digest;
+            CHECK(r.GetString(std::get<0>(key)) && r.Get(std::get<1>(key)) && r.Get(std::get<2>(key)), false, "");
+            CHECK(r.GetString(digest), false, "");
+            file.digests[std::move(key)] = std::move(digest);
+        }
+        CHECK(r.Get(count), false, "");
+        for (auto idx = 0U; idx < count; idx++)
+        {
+            BlocksKey key;
+            uint32 blocksCount;
+            CHECK(r.GetString(std::get<0>(key)) && r.Get(std::get<1>(key)) && r.Get(std::get<2>(key)) && r.Get(std::get<3>(key)), false, "");
+            CHECK(r.Get(blocksCount), false, "");
+            std::vector<std::string> blocks(blocksCount);
+            for (auto& b : blocks)
+            {
+                CHECK(r.GetString(b), false, "");
+            }
+            file.blocks[std::move(key)] = std::move(blocks);
+        }
+        return true;
+    }
+
+    bool SaveCacheFile(std::u16string_view filePath, const CachedFile& file)
+    {
+        Writer w;
+        w.Add(HASH_CACHE_MAGIC);
+        w.Add(HASH_CACHE_VERSION);
+        const auto path = std::filesystem::path(filePath).u8string();
+        w.AddString({ reinterpret_cast<const char*>(path.data()), path.size() });
+        w.Add(file.size);
+        w.Add(file.lastWriteTime);
+        w.AddString(file.sample);
+        w.Add(static_cast<uint32>(file.digests.size()));
+        for (const auto& [key, digest] : file.digests)
+        {
+            w.AddString(std::get<0>(key));
+            w.Add(std::get<1>(key));
+            w.Add(std::get<2>(key));
+            w.AddString(digest);
+        }
+        w.Add(static_cast<uint32>(file.blocks.size()));
+        for (const auto& [key, blocks] : file.blocks)
+        {
+            w.AddString(std::get<0>(key));
+            w.Add(std::get<1>(key));
+            w.Add(std::get<2>(key));
+            w.Add(std::get<3>(key));
+            w.Add(static_cast<uint32>(blocks.size()));
+            for (const auto& b : blocks)
+                w.AddString(b);
+        }
+        // the cache location could be read-only => the results remain cached (in memory) for this session
+        return AppCUI::OS::File::WriteContent(GetCacheFilePath(filePath), w.GetData());
+    }
+
+    // cacheLock must be held
+    void UpdateCacheFile(std::u16string_view filePath, CachedFile& file)
+    {
+        // inside a batch => the file is saved only once, when the batch ends
+        if (file.batches > 0)
+        {
+            file.modified = true;
+            return;
+        }
+        file.modified = false;
+        SaveCacheFile(filePath, file);
+    }
+
+    // cacheLock must be held
+    CachedFile* GetCachedFile(Reference<Object> object)
+    {
+        CHECK(object.IsValid(), nullptr, "");
+        if (object->GetObjectType() != Object::Type::File)
+            return nullptr;
+
+        const auto filePath = object->GetPath();
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(filePath, ec);
+        CHECK(!ec, nullptr, "");
+        const auto lastWriteTime = static_cast<int64>(std::filesystem::last_write_time(filePath, ec).time_since_epoch().count());
+        CHECK(!ec, nullptr, "");
+
+        auto it = cachedFiles.find(filePath);
+        if ((it != cachedFiles.end()) && (it->second.size == size) && (it->second.lastWriteTime == lastWriteTime))
+            return &it->second;
+
+        CachedFile file;
+        file.size          = size;
+        file.lastWriteTime = lastWriteTime;
+        file.sample        = ComputeSample(object, size);
+        if (!LoadCacheFile(filePath, file))
+        {
+            file.digests.clear();
+            file.blocks.clear();
+        }
+        return &(cachedFiles[std::u16string(filePath)] = std::move(file));
+    }
+} // namespace
+
+bool HashCache::Find(Reference<Object> object, std::string_view algorithm, uint64 offset, uint64 size, std::string& digest)
+{
+    std::lock_guard<std::mutex> guard(cacheLock);
+    auto file = GetCachedFile(object);
+    if (file == nullptr)
+        return false;
+    auto it = file->digests.find(DigestKey{ algorithm, offset, size });
+    if (it == file->digests.end())
+        return false;
+    digest = it->second;
+    return true;
+}
+
+bool HashCache::Add(Reference<Object> object, std::string_view algorithm, uint64 offset, uint64 size, std::string_view digest)
+{
+    CHECK(!digest.empty(), false, "");
+    std::lock_guard<std::mutex> guard(cacheLock);
+    auto file = GetCachedFile(object);
+    if (file == nullptr)
+        return false;
+    file->digests[DigestKey{ algorithm, offset, size }] = digest;
+    UpdateCacheFile(object->GetPath(), *file);
+    return true;
+}
+
+bool HashCache::Add(Reference<Object> object, uint64 offset, uint64 size, const std::map<std::string, std::string>& digests)
+{
+    Batch batch(object);
+    for (const auto& [algorithm, digest] : digests)
+    {
+        CHECK(Add(object, algorithm, offset, size, digest), false, "");
+    }
+    return true;
+}
+
+bool HashCache::FindBlocks(
+      Reference<Object> object, std::string_view algorithm, uint64 offset, uint64 size, uint32 blockSize, std::vector<std::string>& blocks)
+{
+    std::lock_guard<std::mutex> guard(cacheLock);
+    auto file = GetCachedFile(object);
+    if (file == nullptr)
+        return false;
+    auto it = file->blocks.find(BlocksKey{ algorithm, offset, size, blockSize });
+    if (it == file->blocks.end())
+        return false;
+    blocks = it->second;
+    return true;
+}
+
+bool HashCache::AddBlocks(
+      Reference<Object> object, std::string_view algorithm, uint64 offset, uint64 size, uint32 blockSize, const std::vector<std::string>& blocks)
+{
+    CHECK(blockSize > 0, false, "");
+    CHECK(blocks.size() == (size + blockSize - 1) / blockSize, false, "Invalid number of blocks");
+    std::lock_guard<std::mutex> guard(cacheLock);
+    auto file = GetCachedFile(object);
+    if (file == nullptr)
+        return false;
+    file->blocks[BlocksKey{ algorithm, offset, size, blockSize }] = blocks;
+    UpdateCacheFile(object->GetPath(), *file);
+    return true;
+}
+
+bool HashCache::Compute(
+      Reference<Object> object,
+      OpenSSLHashKind kind,
+      uint64 offset,
+      uint64 size,
+      uint32 blockSize,
+      std::string& digest,
+      std::vector<std::string>& blocks)
+{
+    CHECK(object.IsValid(), false, "");
+    CHECK(blockSize > 0, false, "");
+    const auto algorithm = GetAlgorithmName(kind);
+    if (Find(object, algorithm, offset, size, digest) && FindBlocks(object, algorithm, offset, size, blockSize, blocks))
+        return true;
+
+    OpenSSLHash hash(kind);
+    PiecewiseHash pieces(kind, blockSize);
+    auto& cache      = object->GetData();
+    const auto chunk = std::max<uint64>(cache.GetCacheSize() / 2, 1);
+    for (auto left = size; left > 0;)
+    {
+        const auto toRead = static_cast<uint32>(std::min<uint64>(left, chunk));
+        const auto buffer = cache.Get(offset + (size - left), toRead, true);
+        CHECK(buffer.IsValid(), false, "Fail to read %u bytes from offset %llu", toRead, offset + (size - left));
+        CHECK(hash.Update(buffer.GetData(), toRead), false, "");
+        CHECK(pieces.Update(buffer.GetData(), toRead), false, "");
+        left -= toRead;
+    }
+    CHECK(pieces.Final(), false, "");
+
+    digest = hash.GetHexValue();
+    blocks = pieces.GetBlocks();
+    CHECK(!digest.empty(), false, "");
+
+    Batch batch(object);
+    Add(object, algorithm, offset, size, digest);
+    AddBlocks(object, algorithm, offset, size, blockSize, blocks);
+    return true;
+}
+
+HashCache::Batch::Batch(Reference<Object> object) : object(object)
+{
+    if (!object.IsValid())
+        return;
+    std::lock_guard<std::mutex> guard(cacheLock);
+    auto file = GetCachedFile(object);
+    if (file != nullptr)
+        file->batches++;
+}
+
+HashCache::Batch::~Batch()
+{
+    std::lock_guard<std::mutex> guard(cacheLock);
+    if (!object.IsValid() || object->GetObjectType() != Object::Type::File)
+        return;
+    const auto filePath = object->GetPath();
+    auto it             = cachedFiles.find(filePath);
+    // the entry is recreated (with no batches) if the file changed in the meantime
+    if ((it == cachedFiles.end()) || (it->second.batches == 0))
+        return;
+    if ((--it->second.batches == 0) && it->second.modified)
+        UpdateCacheFile(filePath, it->second);
+}
+
+std::string_view HashCache::GetAlgorithmName(OpenSSLHashKind kind)
+{
+    switch (kind)
+    {
+    case OpenSSLHashKind::Md5:
+        return "MD5";
+    case OpenSSLHashKind::Blake2s256:
+        return "BLAKE2S256";
+    case OpenSSLHashKind::Blake2b512:
+        return "BLAKE2B512";
+    case OpenSSLHashKind::Sha1:
+        return "SHA1";
+    case OpenSSLHashKind::Sha224:
+        return "SHA224";
+    case OpenSSLHashKind::Sha256:
+        return "SHA256";
+    case OpenSSLHashKind::Sha384:
+        return "SHA384";
+    case OpenSSLHashKind::Sha512:
+        return "SHA512";
+    case OpenSSLHashKind::Sha512_224:
+        return "SHA512_224";
+    case OpenSSLHashKind::Sha512_256:
+        return "SHA512_256";
+    case OpenSSLHashKind::Sha3_224:
+        return "SHA3_224";
+    case OpenSSLHashKind::Sha3_256:
+        return "SHA3_256";
+    case OpenSSLHashKind::Sha3_384:
+        return "SHA3_384";
+    case OpenSSLHashKind::Sha3_512:
+        return "SHA3_512";
+    case OpenSSLHashKind::Shake128:
+        return "SHAKE128";
+    case OpenSSLHashKind::Shake256:
+        return "SHAKE256";
+    }
+    return "";
+}
+} // namespace GView::Hashes
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Internal.hpp"
+
+#include <array>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#    define HASHES_X86
+#    if defined(_MSC_VER) && !defined(__clang__)
+#        include <intrin.h>
+#        define HASHES_TARGET(x)
+#    else
+#        define HASHES_TARGET(x) __attribute__((target(x)))
+#    endif
+#    include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define HASHES_SSE2
+#    include <emmintrin.h>
+#endif
+
+namespace GView::Hashes::Slicing
+{
+// Tables for processing N bytes at once ("slice-by-N"): tables[k][b] is the CRC of byte b followed by k zero bytes.
+// Reflected CRCs (LSB first) shift to the right, normal ones (MSB first) shift to the left.
+template <typename T, size_t N>
+constexpr std::array<std::array<T, 256>, N> MakeReflectedTables(const T (&table)[256])
+{
+    std::array<std::array<T, 256>, N> result{};
+    for (size_t i = 0; i < 256; i++)
+        result[0][i] = table[i];
+    for (size_t k = 1; k < N; k++)
+        for (size_t i = 0; i < 256; i++)
+            result[k][i] = (result[k - 1][i] >> 8) ^ table[result[k - 1][i] & 0xFF];
+    return result;
+}
+template <typename T, uint32 Width, size_t N>
+constexpr std::array<std::array<T, 256>, N> MakeNormalTables(const T (&table)[256])
+{
+    std::array<std::array<T, 256>, N> result{};
+    for (size_t i = 0; i < 256; i++)
+        result[0][i] = table[i];
+    for (size_t k = 1; k < N; k++)
+        for (size_t i = 0; i < 256; i++)
+            result[k][i] = static_cast<T>((result[k - 1][i] << 8) ^ table[(result[k - 1][i] >> (Width - 8)) & 0xFF]);
+    return result;
+}
+
+inline uint32 Load32(const uint8* p)
+{
+    uint32 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+inline uint64 Load64BigEndian(const uint8* p)
+{
+    uint64 v;
+    memcpy(&v, p, sizeof(v));
+#if defined(_MSC_VER) && !defined(__clang__)
+    return _byteswap_uint64(v);
+#else
+    return __builtin_bswap64(v);
+#endif
+}
+
+inline bool HasPCLMUL()
+{
+#ifdef HASHES_X86
+    static const bool supported = []() {
+#    if defined(_MSC_VER) && !defined(__clang__)
+        int regs[4];
+        __cpuid(regs, 1);
+        return ((regs[2] & (1 << 1)) != 0) && ((regs[2] & (1 << 19)) != 0); // PCLMULQDQ & SSE4.1
+#    else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#    endif
+    }();
+    return supported;
+#else
+    return false;
+#endif
+}
+} // namespace GView::Hashes::Slicing
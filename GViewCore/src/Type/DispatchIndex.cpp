@@ -0,0 +1,141 @@
+#include "Internal.hpp"
+
+#include <algorithm>
+
+namespace GView::Type
+{
+template <typename T>
+DispatchIndex::PrefixTrie<T>::PrefixTrie()
+{
+    nodes.emplace_back(); // root
+}
+template <typename T>
+void DispatchIndex::PrefixTrie<T>::Clear()
+{
+    nodes.clear();
+    nodes.emplace_back();
+}
+template <typename T>
+void DispatchIndex::PrefixTrie<T>::Add(const T* key, size_t size, uint32 pluginIndex)
+{
+    uint32 current = 0;
+    for (size_t idx = 0; idx < size; idx++)
+    {
+        auto& children = nodes[current].children;
+        auto it        = std::find_if(children.begin(), children.end(), [&](const auto& c) { return c.first == key[idx]; });
+        if (it != children.end())
+        {
+            current = it->second;
+            continue;
+        }
+        const auto next = static_cast<uint32>(nodes.size());
+        nodes[current].children.emplace_back(key[idx], next);
+        nodes.emplace_back();
+        current = next;
+    }
+    nodes[current].plugins.push_back(pluginIndex);
+}
+template <typename T>
+void DispatchIndex::PrefixTrie<T>::Find(const T* data, size_t size, std::vector<uint32>& result) const
+{
+    // every node reached on the way is a pattern that is a prefix of data
+    uint32 current = 0;
+    for (size_t idx = 0; idx < size; idx++)
+    {
+        const auto& children = nodes[current].children;
+        auto it              = std::find_if(children.begin(), children.end(), [&](const auto& c) { return c.first == data[idx]; });
+        if (it == children.end())
+            return;
+        current = it->second;
+        result.insert(result.end(), nodes[current].plugins.begin(), nodes[current].plugins.end());
+    }
+}
+
+// the text matchers compare a char16 with a char (signed) => values over 0x7F never match
+static bool ToTextKey(std::string_view value, std::u16string& key)
+{
+    key.clear();
+    for (auto ch : value)
+    {
+        if (static_cast<uint8>(ch) > 0x7F)
+            return false;
+        key.push_back(static_cast<char16>(ch));
+    }
+    return !key.empty();
+}
+
+void DispatchIndex::Build(const std::vector<Plugin>& plugins)
+{
+    extensions.clear();
+    magics.Clear();
+    textStarts.Clear();
+    lineStarts.Clear();
+    unindexed.clear();
+
+    std::vector<Matcher::Interface*> patterns;
+    std::vector<uint64> extensionHashes;
+    std::u16string key;
+
+    for (uint32 index = 0; index < static_cast<uint32>(plugins.size()); index++)
+    {
+        const auto& plugin = plugins[index];
+
+        extensionHashes.clear();
+        plugin.GetExtensions(extensionHashes);
+        for (auto hash : extensionHashes)
+            extensions[hash].push_back(index);
+
+        patterns.clear();
+        plugin.GetPatterns(patterns);
+        for (auto p : patterns)
+        {
+            switch (p->GetKind())
+            {
+            case Matcher::Kind::Magic:
+            {
+                auto value = static_cast<Matcher::MagicMatcher*>(p)->GetValue();
+                magics.Add(value.GetData(), value.GetLength(), index);
+                break;
+            }
+            case Matcher::Kind::StartsWith:
+                if (ToTextKey(static_cast<Matcher::StartsWithMatcher*>(p)->GetValue(), key))
+                    textStarts.Add(key.data(), key.size(), index);
+                break;
+            case Matcher::Kind::LineStartsWith:
+                if (ToTextKey(static_cast<Matcher::LineStartsWithMatcher*>(p)->GetValue(), key))
+                    lineStarts.Add(key.data(), key.size(), index);
+                break;
+            default:
+                unindexed.push_back(index);
+                break;
+            }
+        }
+    }
+}
+std::span<const uint32> DispatchIndex::GetExtensionCandidates(uint64 extensionHash) const
+{
+    auto it = extensions.find(extensionHash);
+    if (it == extensions.end())
+        return {};
+    return { it->second.data(), it->second.size() };
+}
+void DispatchIndex::GetContentCandidates(AppCUI::Utils::BufferView buf, Matcher::TextParser& textParser, std::vector<uint32>& candidates) const
+{
+    candidates.clear();
+    candidates.insert(candidates.end(), unindexed.begin(), unindexed.end());
+
+    magics.Find(buf.GetData(), buf.GetLength(), candidates);
+
+    auto text = textParser.GetText();
+    if (!text.empty())
+    {
+        textStarts.Find(text.data(), text.size(), candidates);
+        for (auto ofs : textParser.GetLines())
+            lineStarts.Find(text.data() + ofs, text.size() - ofs, candidates);
+    }
+
+    // keep the priority order (same as iterating through all plugins)
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+}
+} // namespace GView::Type
@@ -46,6 +46,13 @@ bool MagicMatcher::Init(std::string_view text)
     // all good
     return count>0;
 }
+bool MagicMatcher::Init(AppCUI::Utils::BufferView bytes)
+{
+    CHECK((bytes.GetLength() > 0) && (bytes.GetLength() <= ARRAY_LEN(this->u8)), false, "");
+    memcpy(this->u8, bytes.GetData(), bytes.GetLength());
+    this->count = static_cast<uint8>(bytes.GetLength());
+    return true;
+}
 bool MagicMatcher::Match(AppCUI::Utils::BufferView buf, TextParser& )
 {
     const auto* p = buf.GetData();
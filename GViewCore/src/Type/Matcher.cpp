@@ -44,4 +44,34 @@ Interface* CreateFromString(std::string_view str)
     }
     return i;
 }
+Interface* Create(Kind kind, AppCUI::Utils::BufferView value)
+{
+    // same as CreateFromString, but from an already parsed value (see App::PluginRegistry)
+    Interface* i = nullptr;
+    bool result  = false;
+    switch (kind)
+    {
+    case Kind::Magic:
+    {
+        auto m = new MagicMatcher();
+        result = m->Init(value);
+        i      = m;
+        break;
+    }
+    case Kind::StartsWith:
+        i      = new StartsWithMatcher();
+        result = i->Init(std::string_view{ reinterpret_cast<const char*>(value.GetData()), value.GetLength() });
+        break;
+    case Kind::LineStartsWith:
+        i      = new LineStartsWithMatcher();
+        result = i->Init(std::string_view{ reinterpret_cast<const char*>(value.GetData()), value.GetLength() });
+        break;
+    }
+    if (!result)
+    {
+        delete i;
+        return nullptr;
+    }
+    return i;
+}
 } // namespace GView::Type::Matcher
@@ -62,6 +62,8 @@ Plugin::Plugin()
     this->fnValidate       = nullptr;
     this->fnCreateInstance = nullptr;
     this->fnPopulateWindow = nullptr;
+    this->fnUpdate         = nullptr;
+    this->fnUpdateScope    = nullptr;
 }
 void Plugin::InitDefaultPlugin()
 {
@@ -154,15 +156,20 @@ bool Plugin::Init(AppCUI::Utils::IniSection section)
 
     return true;
 }
-bool Plugin::LoadPlugin()
+std::filesystem::path Plugin::GetPluginPath(std::string_view name)
 {
-    AppCUI::OS::Library lib;
     auto path = AppCUI::OS::GetCurrentApplicationPath();
     path.remove_filename();
     path /= "Types";
     path /= "lib";
-    path += this->GetName();
+    path += name;
     path += ".tpl";
+    return path;
+}
+bool Plugin::LoadPlugin()
+{
+    AppCUI::OS::Library lib;
+    auto path = GetPluginPath(this->GetName());
     CHECK(lib.Load(path), false, "Unable to load: %s", path.generic_string().c_str());
 
     this->fnValidate       = lib.GetFunction<decltype(this->fnValidate)>("Validate");
@@ -173,6 +180,10 @@ bool Plugin::LoadPlugin()
     CHECK(fnCreateInstance, false, "Missing 'CreateInstance' export !");
     CHECK(fnPopulateWindow, false, "Missing 'PopulateWindow' export !");
 
+    // optional
+    this->fnUpdate      = lib.GetFunction<decltype(this->fnUpdate)>("Update");
+    this->fnUpdateScope = lib.GetFunction<decltype(this->fnUpdateScope)>("UpdateScope");
+
     return true;
 }
 bool Plugin::MatchExtension(uint64 extensionHash)
@@ -207,7 +218,7 @@ bool Plugin::MatchContent(AppCUI::Utils::BufferView buf, Matcher::TextParser& te
     }
     return false;
 }
-bool Plugin::IsOfType(AppCUI::Utils::BufferView buf, Matcher::TextParser& textParser, const std::string_view& extension)
+bool Plugin::Load()
 {
     if (this->Invalid)
         return false;
@@ -215,13 +226,49 @@ bool Plugin::IsOfType(AppCUI::Utils::BufferView buf, Matcher::TextParser& textPa
     {
         this->Invalid = !LoadPlugin();
         this->Loaded  = !this->Invalid;
-        if (this->Invalid)
-            return false; // something went wrong when loading he plugin
     }
+    return this->Loaded;
+}
+bool Plugin::Validate(AppCUI::Utils::BufferView buf, const std::string_view& extension) const
+{
+    // no loading here => can be called from multiple threads once `Load` was called
+    if ((this->Invalid) || (!this->Loaded))
+        return false;
+    return fnValidate(buf, extension);
+}
+bool Plugin::IsOfType(AppCUI::Utils::BufferView buf, Matcher::TextParser& textParser, const std::string_view& extension)
+{
+    if (!Load())
+        return false; // something went wrong when loading he plugin
     // all good -> code is loaded
     return fnValidate(buf, extension);
 }
 
+void Plugin::GetPatterns(std::vector<Matcher::Interface*>& list) const
+{
+    if (this->patterns.empty())
+    {
+        if (this->pattern)
+            list.push_back(this->pattern);
+    }
+    else
+    {
+        list.insert(list.end(), this->patterns.begin(), this->patterns.end());
+    }
+}
+void Plugin::GetExtensions(std::vector<uint64>& list) const
+{
+    if (this->extensions.empty())
+    {
+        if (this->extension != EXTENSION_EMPTY_HASH)
+            list.push_back(this->extension);
+    }
+    else
+    {
+        list.insert(list.end(), this->extensions.begin(), this->extensions.end());
+    }
+}
+
 bool Plugin::PopulateWindow(Reference<GView::View::WindowInterface> win) const
 {
     CHECK(!this->Invalid, false, "Invalid plugin (not loaded properly or no valid exports)");
@@ -234,3 +281,10 @@ TypeInterface* Plugin::CreateInstance() const
     CHECK(this->Loaded, nullptr, "Plugin was no loaded. Have you call `Validate` first ?");
     return this->fnCreateInstance();
 }
+bool Plugin::Update(Reference<GView::Object> obj) const
+{
+    CHECK(!this->Invalid, false, "Invalid plugin (not loaded properly or no valid exports)");
+    CHECK(this->Loaded, false, "Plugin was no loaded. Have you call `Validate` first ?");
+    CHECK(this->fnUpdate, false, "Missing 'Update' export !");
+    return this->fnUpdate(obj);
+}
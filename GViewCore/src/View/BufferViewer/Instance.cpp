@@ -89,6 +89,7 @@ bool Instance::GetViewData(ViewData& vd, uint64 offset)
     } else {
         vd.byte = 0;
     }
+    vd.object = this->obj;
 
     return true;
 }
@@ -212,7 +213,8 @@ void Instance::MoveTo(uint64 offset, bool select)
                   ViewData{ .viewStartOffset   = cursor.GetStartView(),
                             .viewSize          = static_cast<uint64>(Layout.charactersPerLine) * Layout.visibleRows,
                             .cursorStartOffset = cursor.GetCurrentPosition(),
-                            .byte              = 0 });
+                            .byte              = 0,
+                            .object            = this->obj });
         }
     }
 
@@ -567,7 +569,8 @@ ColorPair Instance::OffsetToColor(uint64 offset)
                               ViewData{ .viewStartOffset   = cursor.GetStartView(),
                                         .viewSize          = static_cast<uint64>(Layout.charactersPerLine) * Layout.visibleRows,
                                         .cursorStartOffset = cursor.GetCurrentPosition(),
-                                        .byte              = b.GetData()[0] },
+                                        .byte              = b.GetData()[0],
+                                        .object            = this->obj },
                               bufColor.color)) {
                         bufColor.start = offset;
                         bufColor.end   = offset;
@@ -1038,6 +1041,13 @@ void Instance::Paint(Renderer& renderer)
         settings->zList.SetCache({ startView, ((uint64) Layout.charactersPerLine) * (Layout.visibleRows - 1ull) + startView });
     }
 
+    if (settings && (showCodeExecution || showSyncCompare) && settings->bufferColorCallback) {
+        ViewData vd;
+        if (GetViewData(vd, GView::Utils::INVALID_OFFSET)) {
+            settings->bufferColorCallback->OnPaintStart(vd);
+        }
+    }
+
     DrawLineInfo dli;
     for (uint32 tr = 0; tr < Layout.visibleRows; tr++) {
         dli.offset = ((uint64) Layout.charactersPerLine) * tr + startView;
@@ -0,0 +1,427 @@
+#include "DissasmCodeZone.hpp"
+#include "DissasmFunctionUtils.hpp"
+
+using namespace GView::View::DissasmViewer;
+
+constexpr size_t DISSASM_INSTRUCTION_OFFSET_MARGIN = 500;
+constexpr uint32 MAX_INSTRUCTION_SIZE              = 16;
+constexpr uint32 READ_SIZE                         = 0x100000;
+constexpr uint64 FIRST_SCAN_SIZE                   = 0x10000; // disassembled right away (enough for the first screen)
+constexpr uint64 WORKER_STEP_SIZE                  = 0x400000;
+constexpr uint32 ADD_INSTRUCTIONS_STOP             = 30; // TODO: update this -> for now it stops, later will fold
+constexpr uint32 AL_OP_STR                         = 7102752u; //* (uint32*) " al";
+
+const uint8 HEX_MAPPER[] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  0,  0,  0,  0,  0, 0, 0,
+                             0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0, 0, 0, 0,  0,  0,  0,  0,  0, 0, 0,
+                             0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 11, 12, 13, 14, 15 };
+
+inline uint64 ExtractBranchTarget(const char* op_str, const DisassemblyZone& zoneDetails)
+{
+    uint64 computedValue = 0;
+    if (op_str[1] == 'x') {
+        const char* ptr = &op_str[2];
+        // TODO: also check not to overflow access!
+        while (*ptr && *ptr != ' ' && *ptr != ',') {
+            if (!(*ptr >= 'a' && *ptr <= 'f' || *ptr >= '0' && *ptr <= '9')) {
+                computedValue = 0;
+                break;
+            }
+            computedValue = computedValue * 16 + HEX_MAPPER[static_cast<uint8>(*ptr)];
+            ptr++;
+        }
+    } else {
+        const char* ptr = &op_str[0];
+        while (*ptr && *ptr != ' ' && *ptr != ',') {
+            if (*ptr < '0' || *ptr > '9') {
+                computedValue = 0;
+                break;
+            }
+            computedValue = computedValue * 10 + (static_cast<uint8>(*ptr) - '0');
+            ptr++;
+        }
+        if (computedValue < zoneDetails.startingZonePoint)
+            computedValue += zoneDetails.startingZonePoint;
+    }
+    return computedValue;
+}
+
+DissasmCodeScanner::DissasmCodeScanner() : zoneDetails{}, fileSize(0), handle(0), insn(nullptr), maxLocationMemoryMappingSize(0), deepScan(false), sweep{}, found{}, hasProgress(false), publishedOffsets(0)
+{
+}
+
+DissasmCodeScanner::~DissasmCodeScanner()
+{
+    Stop();
+}
+
+void DissasmCodeScanner::Stop()
+{
+    stopRequested = true;
+    if (worker.joinable())
+        worker.join();
+    Close();
+}
+
+void DissasmCodeScanner::Close()
+{
+    if (insn) {
+        cs_free(insn, 1);
+        insn = nullptr;
+    }
+    if (handle) {
+        cs_close(&handle);
+        handle = 0;
+    }
+    file.Close();
+}
+
+bool DissasmCodeScanner::Start(
+      Reference<GView::Object> _obj, const DisassemblyZone& _zoneDetails, int architecture, bool _deepScan, uint64 _maxLocationMemoryMappingSize)
+{
+    Stop();
+    this->obj                          = _obj;
+    this->zoneDetails                  = _zoneDetails;
+    this->deepScan                     = _deepScan;
+    this->maxLocationMemoryMappingSize = _maxLocationMemoryMappingSize;
+    this->found                        = {};
+    this->hasProgress                  = false;
+    this->publishedOffsets             = 0;
+    this->stopRequested                = false;
+    this->path.clear();
+
+    CHECK(zoneDetails.entryPoint >= zoneDetails.startingZonePoint, false, "");
+    CHECK(zoneDetails.entryPoint - zoneDetails.startingZonePoint < zoneDetails.size, false, "");
+    const auto resCode = cs_open(CS_ARCH_X86, static_cast<cs_mode>(architecture), &handle);
+    if (resCode != CS_ERR_OK) {
+        handle = 0;
+        RETURNERROR(false, "%s", cs_strerror(resCode));
+    }
+    insn = cs_malloc(handle);
+
+    // the code starts from the entry point until a lower branch target is found
+    StartSweep(zoneDetails.entryPoint, true);
+
+    // the caches of the objects are used by the views => only files (that can be opened again) are disassembled in background
+    if (obj->GetObjectType() == Object::Type::File) {
+        // even if the first sweep ends here, the search for lower branch targets is left to the worker
+        const auto continueSweep = SweepUntil(std::min<uint64>(sweep.address + FIRST_SCAN_SIZE, zoneDetails.size));
+        Publish(false, false);
+        this->path     = obj->GetPath();
+        this->fileSize = obj->GetData().GetSize();
+        this->worker   = std::thread([this, continueSweep]() { Build(continueSweep); });
+        return true;
+    }
+    Build(true);
+    return true;
+}
+
+void DissasmCodeScanner::StartSweep(uint64 start, bool trackTargets)
+{
+    sweep.address                   = start - zoneDetails.startingZonePoint;
+    sweep.lastOffset                = sweep.address;
+    sweep.base                      = start;
+    sweep.minimalTarget             = start;
+    sweep.linesCount                = 0;
+    sweep.continuousAddInstructions = 0;
+    sweep.countLines                = true;
+    sweep.trackTargets              = trackTargets;
+    sweep.callsFound.clear();
+    sweep.callsMap.clear();
+    sweep.callAddress = 0;
+    sweep.foundCall   = false;
+    sweep.offsets.clear();
+    sweep.offsets.push_back({ start, 0 });
+}
+
+BufferView DissasmCodeScanner::Read(uint64 address, uint32 size)
+{
+    if (path.empty())
+        return obj->GetData().Get(zoneDetails.startingZonePoint + address, size, false);
+
+    const auto offset = zoneDetails.startingZonePoint + address;
+    if (offset >= fileSize)
+        return {};
+    size = static_cast<uint32>(std::min<uint64>(size, fileSize - offset));
+    buffer.resize(size);
+    CHECK(file.SetCurrentPos(offset), BufferView(), "");
+    CHECK(file.Read(buffer.data(), size), BufferView(), "Fail to read %u bytes from %llu", size, offset);
+    return BufferView(buffer.data(), size);
+}
+
+// disassembles the instructions from [address, endAddress) while onInstruction returns true (false if the code could not be disassembled)
+template <typename Callback>
+bool DissasmCodeScanner::Disassemble(uint64& address, uint64 endAddress, Callback onInstruction)
+{
+    BufferView chunk;
+    uint64 chunkStart = 0;
+    bool lastChunk    = false;
+    while (address < endAddress) {
+        if (stopRequested)
+            return false;
+        // the address can also move back (when the sweep is restarted)
+        if ((chunk.Empty()) || (address < chunkStart) || (address >= chunkStart + chunk.GetLength()) ||
+            (!lastChunk && address + MAX_INSTRUCTION_SIZE > chunkStart + chunk.GetLength())) {
+            const auto required = std::min<uint64>(std::max<uint64>(endAddress - address + MAX_INSTRUCTION_SIZE, MAX_INSTRUCTION_SIZE * 64), READ_SIZE);
+            const auto size     = static_cast<uint32>(std::min<uint64>(required, zoneDetails.size - address));
+            chunkStart          = address;
+            chunk               = Read(chunkStart, size);
+            lastChunk           = chunkStart + chunk.GetLength() >= zoneDetails.size;
+            if (chunk.Empty())
+                return false;
+        }
+        auto data   = chunk.GetData() + (address - chunkStart);
+        size_t size = chunkStart + chunk.GetLength() - address;
+        if (!cs_disasm_iter(handle, &data, &size, &address, insn))
+            return false;
+        if (!onInstruction())
+            return true;
+    }
+    return true;
+}
+
+bool DissasmCodeScanner::ProcessInstruction(Sweep& s)
+{
+    if (s.trackTargets && (insn->mnemonic[0] == 'j' || *(uint32*) insn->mnemonic == callOP)) {
+        const auto computedValue = ExtractBranchTarget(insn->op_str, zoneDetails);
+        if (computedValue < s.minimalTarget && computedValue >= zoneDetails.startingZonePoint)
+            s.minimalTarget = computedValue;
+    }
+    if (!s.countLines)
+        return s.trackTargets;
+
+    s.linesCount++;
+    if (s.address - s.lastOffset >= DISSASM_INSTRUCTION_OFFSET_MARGIN) {
+        s.lastOffset = s.address;
+        s.offsets.push_back({ s.address + zoneDetails.startingZonePoint, s.linesCount });
+    }
+    if (*(uint32*) insn->mnemonic == addOP && insn->op_str[0] == 'b' && *(uint32*) &insn->op_str[15] == AL_OP_STR) {
+        if (++s.continuousAddInstructions == ADD_INSTRUCTIONS_STOP) {
+            s.linesCount -= s.continuousAddInstructions;
+            s.countLines = false;
+            return s.trackTargets;
+        }
+    } else
+        s.continuousAddInstructions = 0;
+
+    if (deepScan)
+        ProcessCall(s);
+    return true;
+}
+
+void DissasmCodeScanner::ProcessCall(Sweep& s)
+{
+    const bool isJump = insn->mnemonic[0] == 'j';
+    if (*(uint32*) insn->mnemonic == callOP || isJump) {
+        uint64 value;
+        const bool foundValue = CheckExtractInsnHexValue(insn->op_str, value, maxLocationMemoryMappingSize);
+        if (foundValue && value < zoneDetails.startingZonePoint + zoneDetails.size) {
+            if (value < s.base)
+                value += s.base;
+            const char* prefix = isJump ? "offset_0x" : "sub_0x";
+            const auto it      = s.callsMap.find(value);
+            if (it != s.callsMap.end()) {
+                if (isJump == it->second)
+                    return;
+            }
+            auto callName = FormatFunctionName(value, prefix);
+            s.callsFound.emplace_back(value, callName.GetText());
+            s.callsMap.insert({ value, isJump });
+        }
+        return;
+    }
+    const auto mnemonicVal = *(uint32*) insn->mnemonic;
+    if (s.foundCall) {
+        if (mnemonicVal == movOP && strcmp(insn->op_str, "ebp, esp") == 0) {
+            if (s.callAddress < s.base)
+                s.callAddress += s.base;
+            const auto it = s.callsMap.find(s.callAddress);
+            if (it != s.callsMap.end()) {
+                if (!it->second)
+                    return;
+            }
+            auto callName = FormatFunctionName(s.callAddress, "sub_0x");
+            s.callsFound.emplace_back(s.callAddress, callName.GetText());
+            s.callsMap.insert({ s.callAddress, true });
+        }
+        s.foundCall = false;
+    } else if (mnemonicVal == pushOP && strcmp(insn->op_str, "ebp") == 0) {
+        s.callAddress = insn->address;
+        s.foundCall   = true;
+    }
+}
+
+// returns true if the sweep did not reach its end
+bool DissasmCodeScanner::SweepUntil(uint64 endAddress)
+{
+    bool finished = false;
+    const auto ok = Disassemble(sweep.address, endAddress, [this, &finished]() {
+        finished = !ProcessInstruction(sweep);
+        // the lowest possible start is the start of the zone => there is nothing else to search
+        if (sweep.trackTargets && sweep.minimalTarget == zoneDetails.startingZonePoint && sweep.base != zoneDetails.startingZonePoint) {
+            StartSweep(zoneDetails.startingZonePoint, false);
+            Publish(true, false);
+        }
+        return !finished;
+    });
+    return ok && !finished && sweep.address < zoneDetails.size;
+}
+
+/*
+    The first sweep starts from the entry point and searches the lowest branch target:
+    - if a target is found before the entry point, the regions before are searched as well (they might contain lower targets)
+      and the lines are found again starting from the lowest target
+    - if the lowest target is the start of the zone, the first sweep is replaced right away (no lower start is possible)
+    The checkpoints are published after every step => the zone grows while the sweep catches up.
+*/
+void DissasmCodeScanner::Build(bool continueSweep)
+{
+    if (!path.empty()) {
+        if (!file.OpenRead(std::filesystem::path(path))) {
+            // keep what was disassembled so far
+            Publish(false, true);
+            return;
+        }
+    }
+
+    while (continueSweep && SweepUntil(std::min<uint64>(sweep.address + WORKER_STEP_SIZE, zoneDetails.size)))
+        Publish(false, false);
+    if (stopRequested)
+        return;
+
+    if (sweep.trackTargets && sweep.minimalTarget < sweep.base) {
+        auto minimalValue   = sweep.minimalTarget;
+        auto startingOffset = sweep.base;
+        while (minimalValue < startingOffset) {
+            // [minimalValue, startingOffset) might have lower targets
+            uint64 address   = minimalValue - zoneDetails.startingZonePoint;
+            const auto start = minimalValue;
+            Disassemble(address, startingOffset - zoneDetails.startingZonePoint, [this, &minimalValue]() {
+                if (insn->mnemonic[0] == 'j' || *(uint32*) insn->mnemonic == callOP) {
+                    const auto computedValue = ExtractBranchTarget(insn->op_str, zoneDetails);
+                    if (computedValue < minimalValue && computedValue >= zoneDetails.startingZonePoint)
+                        minimalValue = computedValue;
+                }
+                return true;
+            });
+            if (stopRequested)
+                return;
+            startingOffset = start;
+        }
+        StartSweep(minimalValue, false);
+        Publish(true, false);
+        while (SweepUntil(std::min<uint64>(sweep.address + WORKER_STEP_SIZE, zoneDetails.size)))
+            Publish(false, false);
+        if (stopRequested)
+            return;
+    }
+    Publish(false, true);
+}
+
+// the line of the instruction from an offset (from the closest checkpoint before it)
+bool DissasmCodeScanner::FindLine(uint64 offsetToReach, uint32& line)
+{
+    const auto closestData = SearchForClosestAsmOffsetLineByOffset(sweep.offsets, offsetToReach);
+    if (offsetToReach >= sweep.base)
+        offsetToReach -= sweep.base;
+    const auto baseAddress = sweep.base - zoneDetails.startingZonePoint;
+    auto address           = closestData.offset - zoneDetails.startingZonePoint;
+    uint32 count           = 0;
+    const auto ok          = Disassemble(address, baseAddress + offsetToReach + 1, [&count]() {
+        count++;
+        return true;
+    });
+    if (!ok || count == 0)
+        return false;
+    line = count + closestData.line - 1;
+    return true;
+}
+
+void DissasmCodeScanner::BuildAnnotations(std::vector<Annotation>& annotations)
+{
+    auto& callsFound = sweep.callsFound;
+    if (callsFound.empty())
+        return;
+
+    enum labelType { SUB, OFFSET, OTHER };
+    auto getLabelType = [](const std::string& s) -> labelType {
+        assert(!s.empty());
+        if (s.size() < 4)
+            return OTHER;
+        if (memcmp(s.c_str(), "sub_", 4) == 0)
+            return SUB;
+        if (s.size() < 7)
+            return OTHER;
+        if (memcmp(s.c_str(), "offset_", 7) == 0)
+            return OFFSET;
+        return OTHER;
+    };
+
+    for (int32 i = static_cast<int32>(callsFound.size()) - 1; i >= 0; i--) {
+        if (callsFound[i].first == zoneDetails.entryPoint) {
+            callsFound.erase(callsFound.begin() + i);
+            break;
+        }
+    }
+
+    callsFound.emplace_back(zoneDetails.entryPoint, "EntryPoint");
+    // TODO: this can be extracted for the user to add / delete its own operations
+    std::sort(callsFound.begin(), callsFound.end(), [getLabelType](const auto& a, const auto& b) {
+        if (a.first < b.first)
+            return true;
+        if (a.first > b.first)
+            return false;
+        return getLabelType(a.second) < getLabelType(b.second);
+    });
+
+    // TODO: if there are missing called improve predicate to delele only sub and offset
+    callsFound.erase(
+          std::unique(callsFound.begin(), callsFound.end(), [](const auto& left, const auto& right) { return left.first == right.first; }), callsFound.end());
+
+    uint32 extraLines = 0;
+    for (auto& call : callsFound) {
+        uint32 diffLines = 0;
+        if (stopRequested)
+            return;
+        if (FindLine(call.first, diffLines)) {
+            annotations.push_back({ diffLines + extraLines, call.first - sweep.base, std::move(call.second) });
+            extraLines++;
+        }
+    }
+    sweep.linesCount += static_cast<uint32>(callsFound.size());
+}
+
+void DissasmCodeScanner::Publish(bool restarted, bool completed)
+{
+    std::vector<Annotation> annotations;
+    if (completed) {
+        if (deepScan)
+            BuildAnnotations(annotations);
+        Close();
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (restarted) {
+        found.offsets.clear();
+        found.annotations.clear();
+        found.restarted  = true;
+        publishedOffsets = 0;
+    }
+    // the checkpoints published before are already in the zone
+    found.offsets.insert(found.offsets.end(), sweep.offsets.begin() + publishedOffsets, sweep.offsets.end());
+    publishedOffsets = sweep.offsets.size();
+    found.annotations.insert(found.annotations.end(), std::make_move_iterator(annotations.begin()), std::make_move_iterator(annotations.end()));
+    found.linesCount = sweep.linesCount;
+    found.completed  = completed;
+    hasProgress      = true;
+}
+
+bool DissasmCodeScanner::Update(Progress& progress)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if (!hasProgress)
+        return false;
+    progress    = std::move(found);
+    found       = {};
+    hasProgress = false;
+    return true;
+}
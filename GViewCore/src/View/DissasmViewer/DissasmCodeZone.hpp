@@ -2,8 +2,92 @@
 
 #include "DissasmViewer.hpp"
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 namespace GView::View::DissasmViewer
 {
+// Linear sweep of a code zone. The lines are found through sparse (offset, line) checkpoints: a line is disassembled on
+// demand starting from the closest checkpoint before it. For files the sweep continues in background after Start
+// and the zone takes what was found so far with Update.
+class DissasmCodeScanner
+{
+  public:
+    struct Annotation {
+        uint32 line;
+        uint64 offset;
+        std::string name;
+    };
+    struct Progress {
+        std::vector<AsmOffsetLine> offsets; // the new checkpoints (all of them if restarted)
+        std::vector<Annotation> annotations;
+        uint32 linesCount;
+        bool restarted; // code was found before the entry point => the zone starts from there (all lines are renumbered)
+        bool completed;
+    };
+
+  private:
+    struct Sweep {
+        std::vector<AsmOffsetLine> offsets;
+        uint64 address; // relative to the start of the zone
+        uint64 lastOffset;
+        uint64 base; // the offset of the first line
+        uint64 minimalTarget;
+        uint32 linesCount;
+        uint32 continuousAddInstructions;
+        bool countLines;   // false after the padding from the end of the code
+        bool trackTargets; // searches the lowest branch target (the code might start before the entry point)
+
+        // calls and jumps that get a label (deep scan)
+        std::vector<std::pair<uint64, std::string>> callsFound;
+        std::unordered_map<uint64, bool> callsMap;
+        uint64 callAddress;
+        bool foundCall;
+    };
+
+    DisassemblyZone zoneDetails;
+    Reference<GView::Object> obj;
+    AppCUI::OS::File file;
+    uint64 fileSize;
+    std::vector<uint8> buffer;
+    csh handle;
+    cs_insn* insn;
+    uint64 maxLocationMemoryMappingSize;
+    bool deepScan;
+    Sweep sweep;
+
+    // found by the worker and not yet taken by the zone
+    Progress found;
+    bool hasProgress;
+    size_t publishedOffsets;
+    std::u16string path;
+    std::thread worker;
+    std::mutex lock;
+    std::atomic<bool> stopRequested{ false };
+
+    void StartSweep(uint64 start, bool trackTargets);
+    BufferView Read(uint64 address, uint32 size);
+    template <typename Callback>
+    bool Disassemble(uint64& address, uint64 endAddress, Callback onInstruction);
+    bool ProcessInstruction(Sweep& s);
+    void ProcessCall(Sweep& s);
+    bool SweepUntil(uint64 endAddress);
+    bool FindLine(uint64 offset, uint32& line);
+    void BuildAnnotations(std::vector<Annotation>& annotations);
+    void Publish(bool restarted, bool completed);
+    void Build(bool continueSweep);
+    void Close();
+
+  public:
+    DissasmCodeScanner();
+    ~DissasmCodeScanner();
+
+    bool Start(Reference<GView::Object> obj, const DisassemblyZone& zoneDetails, int architecture, bool deepScan, uint64 maxLocationMemoryMappingSize);
+    void Stop();
+    bool Update(Progress& progress);
+};
+
 struct DissasmCodeZone : public ParseZone {
     enum class CollapseExpandType : uint8 { Collapse, Expand, NegateCurrentState };
     uint32 lastDrawnLine; // optimization not to recompute buffer every time
@@ -27,8 +111,10 @@ struct DissasmCodeZone : public ParseZone {
     DisassemblyZone zoneDetails;
     int internalArchitecture; // used for dissasm libraries
     bool isInit;
+    bool isScanCompleted;
     bool changedLevel;
     InternalTypeNewLevelChangeData newLevelChangeData;
+    DissasmCodeScanner scanner;
 
     void ResetZoneCaching();
     bool AddCollapsibleZone(uint32 zoneLineStart, uint32 zoneLineEnd);
@@ -42,6 +128,11 @@ struct DissasmCodeZone : public ParseZone {
     bool RemoveCollapsibleZone(uint32 zoneLine);
 
     bool InitZone(DissasmCodeZoneInitData& initData);
+    bool UpdateScanProgress(uint32& zoneSize);
+    inline bool IsScanInProgress() const
+    {
+        return isInit && !isScanCompleted;
+    }
     void ReachZoneLine(uint32 line);
 
     bool ResetTypesReferenceList();
@@ -145,7 +145,7 @@ bool AnnotationContainer::LoadFromBuffer(const std::byte*& start, const std::byt
         if (!read_primitive(start, end, callValue))
             return false;
         std::string annName((const char*) annotation, annotationSize);
-        mappings[offset] = { std::move(annName), callValue };
+        (*this)[offset] = { std::move(annName), callValue };
         --annotationsCount;
     }
 
@@ -71,6 +71,18 @@ namespace View
             AnnotationMap mappings;
             MapNameLinkType initial_name_to_current_name;
             MapNameLinkType current_name_to_initial_name;
+            // the lines from mappings (sorted) => the annotations from a range of lines are counted with two binary searches
+            std::vector<AnnoationLineNumberType> lines_index;
+
+            void index_line(AnnoationLineNumberType line)
+            {
+                // the annotations are usually added in order
+                if (lines_index.empty() || lines_index.back() < line) {
+                    lines_index.push_back(line);
+                    return;
+                }
+                lines_index.insert(std::lower_bound(lines_index.begin(), lines_index.end(), line), line);
+            }
 
             std::size_t size() const
             {
@@ -89,28 +101,38 @@ namespace View
 
             std::pair<iterator, bool> insert(const value_type& v)
             {
-                return mappings.insert(v);
+                auto result = mappings.insert(v);
+                if (result.second)
+                    index_line(result.first->first);
+                return result;
             }
 
             template <class P, std::enable_if_t<std::is_constructible_v<value_type, P&&>, int> = 0>
             std::pair<iterator, bool> insert(P&& v)
             {
-                return mappings.insert(std::forward<P>(v));
+                auto result = mappings.insert(std::forward<P>(v));
+                if (result.second)
+                    index_line(result.first->first);
+                return result;
             }
 
             template <class InputIt>
             void insert(InputIt first, InputIt last)
             {
-                mappings.insert(first, last);
+                for (; first != last; ++first)
+                    insert(*first);
             }
 
             mapped_type& operator[](const key_type& k)
             {
-                return mappings[k];
+                auto result = mappings.try_emplace(k);
+                if (result.second)
+                    index_line(k);
+                return result.first->second;
             }
             mapped_type& operator[](key_type&& k)
             {
-                return mappings[std::move(k)];
+                return (*this)[static_cast<const key_type&>(k)];
             }
 
             bool contains(const key_type& k) const
@@ -118,6 +140,16 @@ namespace View
                 return mappings.contains(k);
             }
 
+            // the number of annotations with firstLine <= line <= lastLine
+            uint32 count_in_range(AnnoationLineNumberType firstLine, AnnoationLineNumberType lastLine) const
+            {
+                if (firstLine > lastLine)
+                    return 0;
+                const auto first = std::lower_bound(lines_index.begin(), lines_index.end(), firstLine);
+                const auto last  = std::upper_bound(first, lines_index.end(), lastLine);
+                return static_cast<uint32>(last - first);
+            }
+
             iterator find(const key_type& k)
             {
                 return mappings.find(k);
@@ -173,7 +205,7 @@ namespace View
 
             void populate_annotations_from_other_storage(const AnnotationContainer& other)
             {
-                mappings.insert(other.mappings.begin(), other.mappings.end());
+                insert(other.mappings.begin(), other.mappings.end());
                 initial_name_to_current_name.insert(other.initial_name_to_current_name.begin(), other.initial_name_to_current_name.end());
                 current_name_to_initial_name.insert(other.current_name_to_initial_name.begin(), other.current_name_to_initial_name.end());
             }
@@ -19,4 +19,6 @@ cs_insn* GetCurrentInstructionByOffset(
       uint32& diffLines,
       GView::View::DissasmViewer::DrawLineInfo* dli = nullptr);
 
+GView::View::DissasmViewer::AsmOffsetLine SearchForClosestAsmOffsetLineByOffset(
+      const std::vector<GView::View::DissasmViewer::AsmOffsetLine>& values, uint64 searchedOffset);
 GView::View::DissasmViewer::AsmOffsetLine SearchForClosestAsmOffsetLineByLine(const std::vector<GView::View::DissasmViewer::AsmOffsetLine>& values, uint64 searchedLine, uint32* index = nullptr);
\ No newline at end of file
@@ -94,6 +94,8 @@ namespace View
         enum class DissasmParseZoneType : uint8 { StructureParseZone, DissasmCodeParseZone, CollapsibleAndTextZone };
 
         struct ParseZone {
+            virtual ~ParseZone() = default; // the zones are deleted through ParseZone (the code zones stop their scanner)
+
             uint32 startLineIndex;
             uint32 endingLineIndex;
             uint32 extendedSize;
@@ -604,6 +606,7 @@ namespace View
             [[nodiscard]] vector<ZoneLocation> GetZonesIndexesFromLinePosition(uint32 lineStart, uint32 lineEnd = 0) const;
 
             void AdjustZoneExtendedSize(ParseZone* zone, uint32 newExtendedSize);
+            void UpdateCodeZonesScan();
 
             void AnalyzeMousePosition(int x, int y, MousePositionInfo& mpInfo);
 
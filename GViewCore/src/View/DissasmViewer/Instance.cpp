@@ -397,6 +397,10 @@ void Instance::AddComment()
     startingLine -= 2;
 
     const auto convertedZone = static_cast<DissasmCodeZone*>(zone.get());
+    if (convertedZone->IsScanInProgress()) {
+        Dialogs::MessageBox::ShowNotification("Warning", "Please wait for the dissasm zone to be fully analyzed!");
+        return;
+    }
 
     std::string comment = {};
     convertedZone->GetComment(startingLine, comment);
@@ -435,6 +439,10 @@ void Instance::RemoveComment()
     startingLine -= 2;
 
     const auto convertedZone = static_cast<DissasmCodeZone*>(zone.get());
+    if (convertedZone->IsScanInProgress()) {
+        Dialogs::MessageBox::ShowNotification("Warning", "Please wait for the dissasm zone to be fully analyzed!");
+        return;
+    }
     convertedZone->RemoveComment(startingLine);
 }
 
@@ -463,7 +471,11 @@ void Instance::RenameLabel()
     startingLine--;
 
     const auto convertedZone = static_cast<DissasmCodeZone*>(zone.get());
-    startingLine             = startingLine - 1;
+    if (convertedZone->IsScanInProgress()) {
+        Dialogs::MessageBox::ShowNotification("Warning", "Please wait for the dissasm zone to be fully analyzed!");
+        return;
+    }
+    startingLine = startingLine - 1;
 
     DissasmInsnExtractLineParams lineParams = {};
     lineParams.obj                          = obj;
@@ -1278,6 +1290,24 @@ void GView::View::DissasmViewer::Instance::AdjustZoneExtendedSize(ParseZone* zon
     assert(foundZone);
 }
 
+void Instance::UpdateCodeZonesScan()
+{
+    // the code zones disassembled in background grow with the lines found so far
+    for (const auto& zone : settings->parseZones) {
+        if (zone->zoneType != DissasmParseZoneType::DissasmCodeParseZone)
+            continue;
+        const auto codeZone = static_cast<DissasmCodeZone*>(zone.get());
+        if (!codeZone->IsScanInProgress())
+            continue;
+        uint32 zoneSize = 0;
+        if (!codeZone->UpdateScanProgress(zoneSize))
+            continue;
+        AdjustZoneExtendedSize(codeZone, zoneSize);
+        if (codeZone->isScanCompleted)
+            codeZone->TryLoadDataFromCache(cacheData);
+    }
+}
+
 bool Instance::WriteTextLineToChars(DrawLineInfo& dli)
 {
     const uint64 textFileOffset = ((uint64) this->Layout.textSize) * dli.textLineToDraw;
@@ -1337,6 +1367,8 @@ void Instance::Paint(AppCUI::Graphics::Renderer& renderer)
     if (Layout.textSize == 0)
         return;
 
+    UpdateCodeZonesScan();
+
     if (Cursor.hasMovedView) {
         for (const auto& zone : asmData.zonesToClear)
             zone->asmPreCacheData.Clear();
@@ -1490,6 +1522,7 @@ void Instance::ChangeZoneCollapseState(ParseZone* zoneToChange, uint32 line)
 
 Instance::~Instance()
 {
+    settings->parseZones.clear(); // the code zones stop their scanners
     while (!settings->buffersToDelete.empty()) {
         char* bufferToDelete = settings->buffersToDelete.back();
         settings->buffersToDelete.pop_back();
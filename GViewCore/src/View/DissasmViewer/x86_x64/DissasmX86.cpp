@@ -374,18 +374,11 @@ std::optional<uint32> DissasmGetCurrentAsmLineAndPrepareCodeZone(DissasmCodeZone
     }
 
     DissasmCodeInternalType& currentType = zone->types.back();
-    // TODO: do a faster search using a binary search using the annotations and start from there
     // TODO: maybe use some caching here?
     if (reAdapt || levelNow < levelToReach && levelNow + 1 != levelToReach || levelNow > levelToReach && levelNow - 1 != levelToReach) {
-        currentType.textLinesPassed = 0;
-        currentType.asmLinesPassed  = 0;
-        for (uint32 i = currentType.indexZoneStart; i <= levelToReach; i++) {
-            if (currentType.annotations.contains(i)) {
-                currentType.textLinesPassed++;
-                continue;
-            }
-            currentType.asmLinesPassed++;
-        }
+        // the lines from [indexZoneStart, levelToReach] are either annotations or asm lines
+        currentType.textLinesPassed = currentType.annotations.count_in_range(currentType.indexZoneStart, levelToReach);
+        currentType.asmLinesPassed  = levelToReach - currentType.indexZoneStart + 1 - currentType.textLinesPassed;
     } else {
         if (currentType.annotations.contains(levelToReach))
             currentType.textLinesPassed++;
@@ -739,7 +732,8 @@ bool Instance::DrawDissasmX86AndX64CodeZone(DrawLineInfo& dli, DissasmCodeZone*
                     return false;
                 if (initData.hasAdjustedSize)
                     AdjustZoneExtendedSize(zone, initData.adjustedZoneSize);
-                if (!zone->TryLoadDataFromCache(cacheData)) {
+                // the lines from the cache are valid only after all the zone was analyzed (see UpdateCodeZonesScan)
+                if (zone->isScanCompleted && !zone->TryLoadDataFromCache(cacheData)) {
                     // TODO: will enable errors in the next version
                     // dli.WriteErrorToScreen("ERROR: failed to load data from cache!");
                     // return false;
@@ -1100,6 +1094,10 @@ void Instance::CommandExecuteCollapsibleZoneOperation(CollapsibleZoneOperation o
     }
 
     auto zone = static_cast<DissasmCodeZone*>(parseZone.get());
+    if (zone->IsScanInProgress()) {
+        Dialogs::MessageBox::ShowNotification("Warning", "Please wait for the dissasm zone to be fully analyzed!");
+        return;
+    }
 
     const uint32 zoneLineStart  = zonesFound[0].startingLine - 2; // 2 for title and menu -- need to be adjusted
     const uint32 zoneLinesCount = lineEnd - lineStart + 1u;
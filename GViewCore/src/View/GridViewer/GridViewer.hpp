@@ -2,6 +2,9 @@
 
 #include "Internal.hpp"
 #include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
 namespace GView
 {
 namespace View
@@ -17,6 +20,7 @@ namespace View
             constexpr uint32 COMMAND_ID_VIEW_CELL_CONTENT           = 0x1003;
             constexpr uint32 COMMAND_ID_EXPORT_CELL_CONTENT         = 0x1004;
             constexpr uint32 COMMAND_ID_EXPORT_COLUMN_CONTENT       = 0x1005;
+            constexpr uint32 COMMAND_ID_SORT_BY_COLUMN              = 0x1006;
 
             static KeyboardControl ReplaceHeader = { Key::Space, "ReplaceHeader", "Replace header with first row", COMMAND_ID_REPLACE_HEADER_WITH_1ST_ROW };
 
@@ -34,15 +38,45 @@ namespace View
                 Key::Ctrl | Key::Alt | Key::S, "ExportColumnContent", "Export the content of the current column", COMMAND_ID_EXPORT_COLUMN_CONTENT
             };
 
-            static std::array AllGridCommands = { &ReplaceHeader, &ToggleHorizontalLines, &ToggleVerticalLines, &ViewCellContent, &ExportCellContent, &ExportColumnContent };
+            static KeyboardControl SortByColumn = { Key::S, "SortByColumn", "Sort the rows by the current column", COMMAND_ID_SORT_BY_COLUMN };
+
+            static std::array AllGridCommands = { &ReplaceHeader,     &ToggleHorizontalLines, &ToggleVerticalLines, &ViewCellContent,
+                                                  &ExportCellContent, &ExportColumnContent,   &SortByColumn };
         }
 
 
+        // the fields of a CSV / TSV content, stored as flat arrays of offsets
+        class TokenIndex
+        {
+            std::vector<uint64> rowStarts;     // offset of the first byte of every row (+ the end of the last one)
+            std::vector<uint64> rowFirstField; // index (in fieldEnds) of the first field of every row (+ the total number of fields)
+            std::vector<uint64> fieldEnds;     // offset of the separator / new line that ends every field
+            uint64 columnsCount = 0;
+            std::mutex lock;
+
+            bool ReadChunk(Reference<GView::Object> object, AppCUI::OS::File* file, uint64 offset, uint32 length, Buffer& buffer);
+            bool ForEachChunk(Reference<GView::Object> object, uint64 size, const std::function<void(uint32 chunk, BufferView data)>& process);
+
+          public:
+            static constexpr uint32 MAX_FIELD_SIZE = 0x100000;
+
+            bool Build(Reference<GView::Object> object, char separator);
+            void Clear();
+
+            uint64 GetRowsCount() const;
+            inline uint64 GetColumnsCount() const
+            {
+                return columnsCount;
+            }
+            uint32 GetFieldsCount(uint64 row) const;
+            bool GetField(uint64 row, uint32 column, uint64& start, uint64& end) const;
+            bool GetFieldText(Reference<GView::Object> object, uint64 row, uint32 column, std::string& text, uint32 maxSize = MAX_FIELD_SIZE) const;
+        };
+
         struct SettingsData
         {
             String name;
-            std::map<uint64, std::pair<uint64, uint64>> lines;
-            std::map<uint64, std::vector<std::pair<uint64, uint64>>> tokens;
+            TokenIndex tokens;
             char separator[2]{ "," };
             uint64 rows           = 0;
             uint64 cols           = 0;
@@ -122,9 +156,31 @@ namespace View
         {
           private:
             Reference<GView::Object> obj;
-            Reference<AppCUI::Controls::Grid> grid;
             Pointer<SettingsData> settings;
 
+            // cells are never stored => the visible ones are read from the token index when painted
+            std::vector<uint64> rowsOrder;    // the data rows (the header excluded) in the order they are shown
+            std::vector<uint64> filteredRows; // the rows from rowsOrder that match the filter
+            bool filtered = false;
+            std::vector<std::string> header;
+            std::vector<uint32> columnsWidth;
+            std::string cellText;
+
+            struct
+            {
+                uint64 row;
+                uint32 column;
+            } cursor{ 0, 0 }, viewStart{ 0, 0 }, anchor{ 0, 0 }; // anchor = the corner of the selection opposite to the cursor
+            bool selecting = false;
+            struct
+            {
+                uint32 column;
+                bool ascending;
+                bool active;
+            } sort{ 0, true, false };
+            bool showHorizontalLines = false;
+            bool showVerticalLines   = true;
+
             static Config config;
             FindDialog findDialog;
             std::string exportedPathUTF8;
@@ -139,8 +195,14 @@ namespace View
             virtual bool ShowCopyDialog() override;
             void PaintCursorInformation(AppCUI::Graphics::Renderer& renderer, unsigned int width, unsigned int height) override;
 
+            virtual void Paint(Graphics::Renderer& renderer) override;
             virtual bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
+            virtual bool OnKeyEvent(AppCUI::Input::Key keyCode, char16 characterCode) override;
             virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+            virtual void OnMousePressed(int x, int y, AppCUI::Input::MouseButton button, Input::Key) override;
+            virtual bool OnMouseDrag(int x, int y, AppCUI::Input::MouseButton button, Input::Key) override;
+            virtual bool OnMouseWheel(int x, int y, AppCUI::Input::MouseWheel direction, Input::Key) override;
+            virtual void OnUpdateScrollBars() override;
 
             virtual void OnStart() override;
 
@@ -163,10 +225,32 @@ namespace View
           private:
             void PopulateGrid();
             void ProcessContent();
+            void ComputeColumnsWidth();
+
+            inline uint64 GetVisibleRowsCount() const
+            {
+                return filtered ? filteredRows.size() : rowsOrder.size();
+            }
+            inline uint64 GetDataRow(uint64 row) const
+            {
+                return filtered ? filteredRows[row] : rowsOrder[row];
+            }
+            uint32 GetRowHeight() const;
+            uint32 GetPageRowsCount() const;
+            bool GetCellText(uint64 row, uint32 column, std::string& text, uint32 maxSize = TokenIndex::MAX_FIELD_SIZE) const;
+            void MoveTo(uint64 row, uint32 column, bool select = false);
+            bool GetCellAt(int x, int y, uint64& row, uint32& column) const;
+            bool IsSelected(uint64 row, uint32 column) const;
+            void SortByColumn(uint32 column, bool ascending);
+            void FilterByColumn(uint32 column, std::string_view value);
+
+            void PaintHeader(Graphics::Renderer& renderer);
+            void PaintRow(Graphics::Renderer& renderer, uint64 row, int y);
             void PaintCursorInformationWidth(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
             void PaintCursorInformationHeight(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
             void PaintCursorInformationCells(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
             void PaintCursorInformationCurrentLocation(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
+            void PaintCursorInformationSort(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
             void PaintCursorInformationSelection(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
             void PaintCursorInformationSeparator(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
         };
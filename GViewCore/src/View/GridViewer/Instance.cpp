@@ -1,6 +1,11 @@
 #include "GridViewer.hpp"
 #include <fstream>
 #include <filesystem>
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <numeric>
 
 using namespace GView::View::GridViewer;
 using namespace GView::View::GridViewer::Commands;
@@ -10,10 +15,74 @@ constexpr uint32 PROP_ID_REPLACE_HEADER_WITH_1ST_ROW = 0;
 constexpr uint32 PROP_ID_TOGGLE_HORIZONTAL_LINES     = 1;
 constexpr uint32 PROP_ID_TOGGLE_VERTICAL_LINES       = 2;
 
+constexpr uint32 MIN_COLUMN_WIDTH     = 3;
+constexpr uint32 MAX_COLUMN_WIDTH     = 40;
+constexpr uint32 MAX_DISPLAYED_SIZE   = MAX_COLUMN_WIDTH * 4; // UTF-8 => up to 4 bytes per character
+constexpr uint32 COLUMN_WIDTH_SAMPLES = 256;                  // rows used to compute the width of the columns
+constexpr uint32 MAX_SORT_KEY_SIZE    = 64;
+constexpr uint64 MAX_COPY_SIZE        = 0x4000000; // the text of a selection that can be copied to clipboard
+
 Config Instance::config;
 
+namespace
+{
+// quoted fields can contain new lines / tabs => they are shown as spaces
+void MakePrintable(std::string& text)
+{
+    for (auto& c : text) {
+        if (static_cast<uint8>(c) < ' ') {
+            c = ' ';
+        }
+    }
+}
+
+uint32 GetCharactersCount(std::string_view text)
+{
+    uint32 count = 0;
+    for (const auto c : text) {
+        count += (static_cast<uint8>(c) & 0xC0) != 0x80;
+    }
+    return count;
+}
+
+// A, B, ..., Z, AA, AB, ...
+std::string GetDefaultColumnName(uint32 column)
+{
+    std::string name;
+    for (auto value = static_cast<uint64>(column) + 1; value > 0; value = (value - 1) / 26) {
+        name.insert(name.begin(), static_cast<char>('A' + (value - 1) % 26));
+    }
+    return name;
+}
+
+bool ParseNumber(std::string_view text, double& value)
+{
+    while (!text.empty() && (text.front() == ' ')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ')) {
+        text.remove_suffix(1);
+    }
+    if (!text.empty() && (text.front() == '+')) {
+        text.remove_prefix(1);
+    }
+    CHECK(!text.empty(), false, "");
+    const auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    // nan / inf are parsed as well, but nan can not be ordered => such a column is sorted as text
+    return (result.ec == std::errc()) && (result.ptr == text.data() + text.size()) && std::isfinite(value);
+}
+
+bool ContainsIgnoreCase(std::string_view text, std::string_view value)
+{
+    const auto it = std::search(text.begin(), text.end(), value.begin(), value.end(), [](char a, char b) {
+        return std::tolower(static_cast<uint8>(a)) == std::tolower(static_cast<uint8>(b));
+    });
+    return it != text.end();
+}
+} // namespace
+
 Instance::Instance(Reference<GView::Object> obj, Settings* _settings)
-    : settings(nullptr), ViewControl("Grid View")
+    : settings(nullptr), ViewControl("Grid View", UserControlFlags::ShowVerticalScrollBar | UserControlFlags::ScrollBarOutsideControl)
 {
     this->obj = obj;
     // settings
@@ -25,16 +94,6 @@ Instance::Instance(Reference<GView::Object> obj, Settings* _settings)
         // default setup
         settings.reset(new SettingsData());
     }
-    if (settings) {
-        grid = AppCUI::Controls::Factory::Grid::Create(
-              this,
-              "d:c,w:100%,h:100%",
-              static_cast<uint32>(settings->cols),
-              static_cast<uint32>(settings->rows),
-              AppCUI::Controls::GridFlags::Sort | AppCUI::Controls::GridFlags::Filter | GridFlags::DisableDuplicates);
-
-        grid->SetSeparator(settings->separator);
-    }
 
     if (config.loaded == false)
         config.Initialize();
@@ -76,16 +135,44 @@ bool Instance::ShowFindDialog()
 {
     CHECK(findDialog.Show() == Dialogs::Result::Ok, true, "");
 
-    auto filterValue = findDialog.GetFilterValue();
-    grid->SetFilterOnCurrentColumn(filterValue);
-    grid->Filter();
+    UnicodeStringBuilder usb{};
+    usb.Set(findDialog.GetFilterValue());
+    std::string filterValue;
+    usb.ToString(filterValue);
+    FilterByColumn(cursor.column, filterValue);
 
     return true;
 }
 
 bool Instance::ShowCopyDialog()
 {
-    grid->OnKeyEvent(Key::Ctrl | Key::C, 0);
+    // the selected cells (or the current one): the columns are separated by tabs and the rows by new lines
+    const auto firstRow    = selecting ? std::min<uint64>(anchor.row, cursor.row) : cursor.row;
+    const auto lastRow     = selecting ? std::max<uint64>(anchor.row, cursor.row) : cursor.row;
+    const auto firstColumn = selecting ? std::min<uint32>(anchor.column, cursor.column) : cursor.column;
+    const auto lastColumn  = selecting ? std::max<uint32>(anchor.column, cursor.column) : cursor.column;
+
+    std::string text;
+    for (auto row = firstRow; row <= lastRow; row++) {
+        for (auto column = firstColumn; column <= lastColumn; column++) {
+            CHECK(GetCellText(row, column, cellText), false, "");
+            text.append(cellText);
+            if (column < lastColumn) {
+                text.push_back('\t');
+            }
+        }
+        if (row < lastRow) {
+            text.push_back('\n');
+        }
+        if (text.size() > MAX_COPY_SIZE) {
+            Dialogs::MessageBox::ShowError("Error", "The selection is too large to be copied to clipboard!");
+            return false;
+        }
+    }
+    if (AppCUI::OS::Clipboard::SetText(text) == false) {
+        Dialogs::MessageBox::ShowError("Error", "Failed to copy the cell content to clipboard!");
+        return false;
+    }
     return true;
 }
 
@@ -108,7 +195,9 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& renderer, unsi
         PaintCursorInformationSeparator(renderer, x4 - 1, y);
         PaintCursorInformationCurrentLocation(renderer, x4, y);
         PaintCursorInformationSeparator(renderer, x5 - 1, y);
-        PaintCursorInformationSelection(renderer, x5, y);
+        PaintCursorInformationSort(renderer, x5, y);
+        PaintCursorInformationSeparator(renderer, x6 - 1, y);
+        PaintCursorInformationSelection(renderer, x6, y);
     } else if (height > 1) {
         const uint32 x1 = 1;
         const uint32 x2 = 1;
@@ -125,7 +214,248 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& renderer, unsi
         PaintCursorInformationCells(renderer, x3, y1);
         PaintCursorInformationCurrentLocation(renderer, x4, y2);
         PaintCursorInformationSeparator(renderer, x4 - 1, y1);
-        PaintCursorInformationSelection(renderer, x5, y1);
+        PaintCursorInformationSort(renderer, x5, y1);
+        PaintCursorInformationSelection(renderer, x6, y2);
+    }
+}
+
+uint32 Instance::GetRowHeight() const
+{
+    return showHorizontalLines ? 2 : 1;
+}
+
+uint32 Instance::GetPageRowsCount() const
+{
+    // the header (and the line below it) is always visible
+    const auto firstY = static_cast<int32>(GetRowHeight());
+    return static_cast<uint32>(std::max<int32>((this->GetHeight() - firstY + static_cast<int32>(GetRowHeight()) - 1) / static_cast<int32>(GetRowHeight()), 1));
+}
+
+bool Instance::GetCellText(uint64 row, uint32 column, std::string& text, uint32 maxSize) const
+{
+    text.clear();
+    CHECK(row < GetVisibleRowsCount(), false, "");
+    const auto dataRow = GetDataRow(row);
+    if (column >= settings->tokens.GetFieldsCount(dataRow)) {
+        return true; // a row with fewer fields => the rest of its cells are empty
+    }
+    return settings->tokens.GetFieldText(obj, dataRow, column, text, maxSize);
+}
+
+void Instance::MoveTo(uint64 row, uint32 column, bool select)
+{
+    if (select && !selecting) {
+        anchor.row    = cursor.row;
+        anchor.column = cursor.column;
+    }
+    selecting = select;
+
+    const auto rowsCount = GetVisibleRowsCount();
+    cursor.row           = rowsCount == 0 ? 0 : std::min<uint64>(row, rowsCount - 1);
+    cursor.column        = columnsWidth.empty() ? 0 : std::min<uint32>(column, static_cast<uint32>(columnsWidth.size() - 1));
+
+    const auto pageRows = GetPageRowsCount();
+    if (cursor.row < viewStart.row) {
+        viewStart.row = cursor.row;
+    } else if (cursor.row >= viewStart.row + pageRows) {
+        viewStart.row = cursor.row - pageRows + 1;
+    }
+
+    if (cursor.column < viewStart.column) {
+        viewStart.column = cursor.column;
+    } else {
+        // the first column is moved to the right until the current one fits
+        while (viewStart.column < cursor.column) {
+            int32 width = 0;
+            for (auto idx = viewStart.column; idx <= cursor.column; idx++) {
+                width += columnsWidth[idx] + 1;
+            }
+            if (width <= this->GetWidth()) {
+                break;
+            }
+            viewStart.column++;
+        }
+    }
+}
+
+bool Instance::GetCellAt(int x, int y, uint64& row, uint32& column) const
+{
+    column = viewStart.column;
+    for (auto right = static_cast<int32>(columnsWidth.empty() ? 0 : columnsWidth[column]); (right < x) && (column + 1 < columnsWidth.size());) {
+        column++;
+        right += columnsWidth[column] + 1;
+    }
+    if (y < static_cast<int32>(GetRowHeight())) {
+        return false; // the header
+    }
+    row = viewStart.row + (y - GetRowHeight()) / GetRowHeight();
+    return true;
+}
+
+bool Instance::IsSelected(uint64 row, uint32 column) const
+{
+    return selecting && (row >= std::min<uint64>(anchor.row, cursor.row)) && (row <= std::max<uint64>(anchor.row, cursor.row)) &&
+           (column >= std::min<uint32>(anchor.column, cursor.column)) && (column <= std::max<uint32>(anchor.column, cursor.column));
+}
+
+void Instance::ComputeColumnsWidth()
+{
+    columnsWidth.assign(settings->cols, MIN_COLUMN_WIDTH);
+    const auto samples = std::min<uint64>(GetVisibleRowsCount(), COLUMN_WIDTH_SAMPLES);
+    for (uint32 column = 0; column < columnsWidth.size(); column++) {
+        auto width = GetCharactersCount(header[column]) + 2; // + the sort direction
+        for (uint64 row = 0; row < samples; row++) {
+            if (GetCellText(row, column, cellText, MAX_DISPLAYED_SIZE)) {
+                width = std::max<uint32>(width, GetCharactersCount(cellText));
+            }
+        }
+        columnsWidth[column] = std::clamp<uint32>(width, MIN_COLUMN_WIDTH, MAX_COLUMN_WIDTH);
+    }
+}
+
+/*
+    Only the keys of the sorted column are read (one pass over the rows) and they are released after the sort:
+    - if every non-empty cell is a number the rows are sorted by value (empty cells first)
+    - otherwise the first MAX_SORT_KEY_SIZE bytes of the cells are compared
+*/
+void Instance::SortByColumn(uint32 column, bool ascending)
+{
+    CHECKRET(column < columnsWidth.size(), "");
+    const auto firstRow = settings->tokens.GetRowsCount() - rowsOrder.size();
+
+    std::string keys;
+    std::vector<uint64> keysOffsets(rowsOrder.size() + 1, 0);
+    std::vector<double> numbers(rowsOrder.size(), -HUGE_VAL);
+    auto numeric = true;
+    std::string text;
+    for (uint64 idx = 0; idx < rowsOrder.size(); idx++) {
+        const auto dataRow = firstRow + idx;
+        if ((column < settings->tokens.GetFieldsCount(dataRow)) && settings->tokens.GetFieldText(obj, dataRow, column, text, MAX_SORT_KEY_SIZE)) {
+            keys.append(text);
+            if (numeric && !text.empty()) {
+                numeric = ParseNumber(text, numbers[idx]);
+            }
+        }
+        keysOffsets[idx + 1] = keys.size();
+    }
+
+    const auto Less = [&](uint64 a, uint64 b) {
+        a -= firstRow;
+        b -= firstRow;
+        if (numeric) {
+            return numbers[a] < numbers[b];
+        }
+        const std::string_view keyA{ keys.data() + keysOffsets[a], keysOffsets[a + 1] - keysOffsets[a] };
+        const std::string_view keyB{ keys.data() + keysOffsets[b], keysOffsets[b + 1] - keysOffsets[b] };
+        return keyA < keyB;
+    };
+    if (ascending) {
+        std::stable_sort(rowsOrder.begin(), rowsOrder.end(), Less);
+    } else {
+        std::stable_sort(rowsOrder.begin(), rowsOrder.end(), [&](uint64 a, uint64 b) { return Less(b, a); });
+    }
+
+    if (filtered) {
+        // the rows that match the filter are kept, in the new order
+        std::vector<bool> matches(rowsOrder.size(), false);
+        for (const auto row : filteredRows) {
+            matches[row - firstRow] = true;
+        }
+        filteredRows.clear();
+        for (const auto row : rowsOrder) {
+            if (matches[row - firstRow]) {
+                filteredRows.push_back(row);
+            }
+        }
+    }
+
+    sort = { column, ascending, true };
+    MoveTo(0, column);
+}
+
+void Instance::FilterByColumn(uint32 column, std::string_view value)
+{
+    filteredRows.clear();
+    filtered = !value.empty();
+    if (filtered) {
+        std::string text;
+        for (const auto row : rowsOrder) {
+            if ((column < settings->tokens.GetFieldsCount(row)) && settings->tokens.GetFieldText(obj, row, column, text) && ContainsIgnoreCase(text, value)) {
+                filteredRows.push_back(row);
+            }
+        }
+    }
+    viewStart.row = 0;
+    MoveTo(0, column);
+}
+
+void Instance::PaintHeader(Graphics::Renderer& renderer)
+{
+    const auto color = this->HasFocus() ? Cfg.Header.Text.Focused : Cfg.Header.Text.Normal;
+    renderer.FillHorizontalLine(0, 0, this->GetWidth(), ' ', color);
+
+    int32 x = 0;
+    for (auto column = viewStart.column; (column < columnsWidth.size()) && (x < this->GetWidth()); column++) {
+        const auto width = static_cast<int32>(columnsWidth[column]);
+        renderer.WriteSingleLineText(
+              x, 0, width, std::u8string_view{ reinterpret_cast<const char8_t*>(header[column].data()), header[column].size() }, color);
+        if (sort.active && (sort.column == column)) {
+            renderer.WriteSpecialCharacter(x + width - 1, 0, sort.ascending ? SpecialChars::TriangleUp : SpecialChars::TriangleDown, color);
+        }
+        x += width;
+        if (showVerticalLines) {
+            renderer.WriteSpecialCharacter(x, 0, SpecialChars::BoxVerticalSingleLine, Cfg.Lines.Normal);
+        }
+        x++;
+    }
+    if (showHorizontalLines) {
+        renderer.FillHorizontalLineWithSpecialChar(0, 1, this->GetWidth(), SpecialChars::BoxHorizontalSingleLine, Cfg.Lines.Normal);
+    }
+}
+
+void Instance::PaintRow(Graphics::Renderer& renderer, uint64 row, int y)
+{
+    const auto textColor = this->HasFocus() ? Cfg.Text.Normal : Cfg.Text.Inactive;
+
+    int32 x = 0;
+    for (auto column = viewStart.column; (column < columnsWidth.size()) && (x < this->GetWidth()); column++) {
+        const auto width = static_cast<int32>(columnsWidth[column]);
+        auto color       = IsSelected(row, column) ? Cfg.Selection.Editor : textColor;
+        if ((row == cursor.row) && (column == cursor.column)) {
+            color = Cfg.Cursor.Normal;
+        }
+        if (color != textColor) {
+            renderer.FillHorizontalLine(x, y, x + width - 1, ' ', color);
+        }
+        if (GetCellText(row, column, cellText, MAX_DISPLAYED_SIZE)) {
+            MakePrintable(cellText);
+            renderer.WriteSingleLineText(x, y, width, std::u8string_view{ reinterpret_cast<const char8_t*>(cellText.data()), cellText.size() }, color);
+        }
+        x += width;
+        if (showVerticalLines) {
+            renderer.WriteSpecialCharacter(x, y, SpecialChars::BoxVerticalSingleLine, Cfg.Lines.Normal);
+            if (showHorizontalLines) {
+                renderer.WriteSpecialCharacter(x, y + 1, SpecialChars::BoxVerticalSingleLine, Cfg.Lines.Normal);
+            }
+        }
+        x++;
+    }
+    if (showHorizontalLines) {
+        renderer.FillHorizontalLineWithSpecialChar(0, y + 1, this->GetWidth(), SpecialChars::BoxHorizontalSingleLine, Cfg.Lines.Normal);
+    }
+}
+
+void Instance::Paint(Graphics::Renderer& renderer)
+{
+    renderer.Clear(' ', this->HasFocus() ? Cfg.Text.Normal : Cfg.Text.Inactive);
+    PaintHeader(renderer);
+
+    // only the rows from the view port are read
+    const auto rowHeight = static_cast<int32>(GetRowHeight());
+    const auto lastRow   = std::min<uint64>(GetVisibleRowsCount(), viewStart.row + GetPageRowsCount());
+    auto y               = rowHeight;
+    for (auto row = viewStart.row; row < lastRow; row++, y += rowHeight) {
+        PaintRow(renderer, row, y);
     }
 }
 
@@ -137,6 +467,105 @@ bool Instance::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
     return false;
 }
 
+bool Instance::OnKeyEvent(AppCUI::Input::Key keyCode, char16 characterCode)
+{
+    const auto page = static_cast<uint64>(GetPageRowsCount());
+    // with Shift => a rectangular selection between the cell where it started and the cursor
+    const auto select = (static_cast<uint32>(keyCode) & static_cast<uint32>(Key::Shift)) != 0;
+    switch (keyCode) {
+    case Key::Up:
+    case Key::Up | Key::Shift:
+        MoveTo(cursor.row > 0 ? cursor.row - 1 : 0, cursor.column, select);
+        return true;
+    case Key::Down:
+    case Key::Down | Key::Shift:
+        MoveTo(cursor.row + 1, cursor.column, select);
+        return true;
+    case Key::Left:
+    case Key::Left | Key::Shift:
+        MoveTo(cursor.row, cursor.column > 0 ? cursor.column - 1 : 0, select);
+        return true;
+    case Key::Right:
+    case Key::Right | Key::Shift:
+        MoveTo(cursor.row, cursor.column + 1, select);
+        return true;
+    case Key::PageUp:
+    case Key::PageUp | Key::Shift:
+        MoveTo(cursor.row > page ? cursor.row - page : 0, cursor.column, select);
+        return true;
+    case Key::PageDown:
+    case Key::PageDown | Key::Shift:
+        MoveTo(cursor.row + page, cursor.column, select);
+        return true;
+    case Key::Home:
+    case Key::Home | Key::Shift:
+        MoveTo(cursor.row, 0, select);
+        return true;
+    case Key::End:
+    case Key::End | Key::Shift:
+        MoveTo(cursor.row, static_cast<uint32>(columnsWidth.size()), select);
+        return true;
+    case Key::Ctrl | Key::Home:
+    case Key::Ctrl | Key::Home | Key::Shift:
+        MoveTo(0, cursor.column, select);
+        return true;
+    case Key::Ctrl | Key::End:
+    case Key::Ctrl | Key::End | Key::Shift:
+        MoveTo(GetVisibleRowsCount(), cursor.column, select);
+        return true;
+    case Key::Escape:
+        if (selecting) {
+            MoveTo(cursor.row, cursor.column);
+            return true;
+        }
+        if (filtered) {
+            FilterByColumn(cursor.column, "");
+            return true;
+        }
+        break;
+    }
+
+    return ViewControl::OnKeyEvent(keyCode, characterCode);
+}
+
+void Instance::OnMousePressed(int x, int y, AppCUI::Input::MouseButton button, Input::Key)
+{
+    uint64 row;
+    uint32 column;
+    if (GetCellAt(x, y, row, column)) {
+        MoveTo(row, column);
+    } else if (y == 0) {
+        // a click on the header sorts the rows (a second click reverses the order)
+        SortByColumn(column, !(sort.active && (sort.column == column) && sort.ascending));
+    }
+}
+
+bool Instance::OnMouseDrag(int x, int y, AppCUI::Input::MouseButton button, Input::Key)
+{
+    uint64 row;
+    uint32 column;
+    CHECK(GetCellAt(x, y, row, column), false, "");
+    MoveTo(row, column, true);
+    return true;
+}
+
+bool Instance::OnMouseWheel(int x, int y, AppCUI::Input::MouseWheel direction, Input::Key)
+{
+    switch (direction) {
+    case MouseWheel::Up:
+        return OnKeyEvent(Key::Up, false);
+    case MouseWheel::Down:
+        return OnKeyEvent(Key::Down, false);
+    }
+
+    return false;
+}
+
+void Instance::OnUpdateScrollBars()
+{
+    this->UpdateVScrollBar(cursor.row, GetVisibleRowsCount() > 0 ? GetVisibleRowsCount() - 1 : 0);
+}
+
 bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
 {
     if (eventType == Event::Command) {
@@ -145,29 +574,30 @@ bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
             PopulateGrid();
             return true;
         } else if (ID == COMMAND_ID_TOGGLE_HORIZONTAL_LINES) {
-            grid->ToggleHorizontalLines();
+            showHorizontalLines = !showHorizontalLines;
+            MoveTo(cursor.row, cursor.column);
             return true;
         } else if (ID == COMMAND_ID_TOGGLE_VERTICAL_LINES) {
-            grid->ToggleVerticalLines();
+            showVerticalLines = !showVerticalLines;
+            return true;
+        } else if (ID == COMMAND_ID_SORT_BY_COLUMN) {
+            SortByColumn(cursor.column, !(sort.active && (sort.column == cursor.column) && sort.ascending));
             return true;
         } else if (ID == COMMAND_ID_VIEW_CELL_CONTENT) {
-            auto content = grid->GetSelectedCellContent();
-            if (content.has_value()) {
-                BufferView buffer(*content);
+            if (GetCellText(cursor.row, cursor.column, cellText)) {
+                BufferView buffer(reinterpret_cast<const uint8*>(cellText.data()), cellText.size());
                 GView::App::OpenBuffer(buffer, "Cell Content", "", GView::App::OpenMethod::Select, "");
             } else {
                 AppCUI::Dialogs::MessageBox::ShowError("Error", "Failed to view cell content!");
             }
 
         } else if (ID == COMMAND_ID_EXPORT_CELL_CONTENT) {
-            auto content = grid->GetSelectedCellContent();
-
-            if (content.has_value()) {
+            if (GetCellText(cursor.row, cursor.column, cellText)) {
                 std::time_t t      = std::time(0);
                 auto timestampPath = this->exportedPathUTF8 + "_" + std::to_string(t);
 
                 std::ofstream file(timestampPath.c_str(), std::ios::binary); // Open the file in binary mode
-                file.write(reinterpret_cast<const char*>((*content).data()), (*content).size());
+                file.write(cellText.data(), cellText.size());
                 file.close();
 
                 AppCUI::Dialogs::MessageBox::ShowNotification("File Export Result", std::string("File exported successfully at: ") + timestampPath);
@@ -175,11 +605,8 @@ bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
                 AppCUI::Dialogs::MessageBox::ShowError("Error", "Failed to export cell content!");
             }
         } else if (ID == COMMAND_ID_EXPORT_COLUMN_CONTENT) {
-            auto data = grid->GetSelectedColumnContent();
-            if (data.has_value()) {
-                auto index = 0;
-
-                auto folderPath = this->exportedFolderPath + data.value().first + "_";
+            if (cursor.column < header.size()) {
+                auto folderPath = this->exportedFolderPath + header[cursor.column] + "_";
                 std::time_t t   = std::time(0);
                 folderPath += std::to_string(t);
 
@@ -187,18 +614,16 @@ bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
                     std::filesystem::create_directory(folderPath);
                 }
 
-                for (auto& content : data.value().second) {
+                // the cells are read one by one => the column is never entirely in memory
+                for (uint64 index = 0; index < GetVisibleRowsCount(); index++) {
+                    GetCellText(index, cursor.column, cellText);
                     std::string newName = folderPath + "\\row_" + std::to_string(index);
                     std::ofstream file(newName.c_str(), std::ios::binary); // Open the file in binary mode
 
-                    file.write(reinterpret_cast<const char*>(content.data()), content.size());
+                    file.write(cellText.data(), cellText.size());
                     file.close();
-
-                    index++;
                 }
 
-                folderPath.pop_back();
-                folderPath.pop_back();
                 AppCUI::Dialogs::MessageBox::ShowNotification("Files Export Result", std::string("Files exported successfully at folder: ") + folderPath);
             } else {
                 AppCUI::Dialogs::MessageBox::ShowError("Error", "Failed to export column content!");
@@ -212,128 +637,43 @@ bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
 void Instance::OnStart()
 {
     ProcessContent();
-    grid->SetGridDimensions({ static_cast<uint32>(settings->cols), static_cast<uint32>(settings->rows) });
     PopulateGrid();
 }
 
 void Instance::PopulateGrid()
 {
-    const auto& content = settings->tokens;
-    auto it             = content.begin();
-
-    if (settings->firstRowAsHeader) {
-        const auto& header = it->second;
-        std::vector<AppCUI::Utils::ConstString> headerCS;
-        for (const auto& [start, end] : header) {
-            const auto token = obj->GetData().Get(start, static_cast<uint32>(end - start), false);
-            headerCS.push_back(token);
+    const auto& tokens  = settings->tokens;
+    const auto firstRow = (settings->firstRowAsHeader && tokens.GetRowsCount() > 0) ? 1ULL : 0ULL;
+
+    header.assign(settings->cols, "");
+    for (uint32 column = 0; column < header.size(); column++) {
+        if (firstRow > 0 && column < tokens.GetFieldsCount(0)) {
+            tokens.GetFieldText(obj, 0, column, header[column], MAX_DISPLAYED_SIZE);
+            MakePrintable(header[column]);
+        } else {
+            header[column] = GetDefaultColumnName(column);
         }
-        std::advance(it, 1);
-        grid->UpdateHeaderValues(headerCS);
-    } else {
-        grid->SetDefaultHeaderValues();
-    }
-
-    const auto dimensions = grid->GetGridDimensions();
-    if (static_cast<uint32>(settings->rows - settings->firstRowAsHeader) != dimensions.Height) {
-        grid->SetGridDimensions({ static_cast<uint32>(settings->cols), static_cast<uint32>(settings->rows - settings->firstRowAsHeader) });
     }
 
-    while (it != content.end()) {
-        const auto i    = it->first;
-        const auto& row = it->second;
-        for (auto itRow = row.begin(); itRow != row.end(); itRow++) {
-            const auto j     = row.size() - std::abs(std::distance(row.end(), itRow));
-            const auto token = obj->GetData().Get(itRow->first, static_cast<uint32>(itRow->second - itRow->first), false);
-            const ConstString value{ token };
-            grid->UpdateCell(static_cast<uint32>(j), static_cast<uint32>(i - settings->firstRowAsHeader), value);
-        }
-        std::advance(it, 1);
-    }
+    // the rows are shown in the order from the file until they are sorted
+    rowsOrder.resize(settings->rows - firstRow);
+    std::iota(rowsOrder.begin(), rowsOrder.end(), firstRow);
+    filteredRows.clear();
+    filtered    = false;
+    sort.active = false;
+    viewStart   = { 0, 0 };
 
-    grid->Sort();
+    ComputeColumnsWidth();
+    MoveTo(0, 0);
 }
 
 void GView::View::GridViewer::Instance::ProcessContent()
 {
-    // TODO: this function should be a state machine with using cache as a stream-like structure!
-    // the implementation below is wrong if a "row" contains more bytes than the cache size!
-
-    std::map<uint64, std::pair<uint64, uint64>> lines;
-    std::map<uint64, std::vector<std::pair<uint64, uint64>>> tokens;
-
-    const auto oSize = obj->GetData().GetSize();
-    const auto cSize = static_cast<uint64>(obj->GetData().GetCacheSize());
-
-    auto oSizeProcessed = 0ULL;
-    auto lineStart      = 0ULL;
-    auto currentLine    = 0ULL;
-
-    do {
-        const auto dataSize = oSizeProcessed >= oSize ? 0 : std::min<uint64>(oSize - oSizeProcessed, cSize);
-        const auto buf      = obj->GetData().Get(oSizeProcessed, static_cast<uint32>(dataSize), false);
-        const std::string_view data{ reinterpret_cast<const char*>(buf.GetData()), buf.GetLength() };
-
-        auto nPos       = data.find_first_of('\n', 0);
-        const auto rPos = data.find_first_of('\r', 0);
-
-        const auto oldOSizeProcessed = oSizeProcessed;
-
-        if (nPos < rPos) {
-            if (nPos + 1 < data.size() && data[nPos + 1] == '\r') {
-                oSizeProcessed += nPos + 2;
-            } else {
-                oSizeProcessed += nPos + 1;
-            }
-        } else if (nPos > rPos) {
-            if (rPos + 1 < data.size() && data[rPos + 1] == '\n') {
-                oSizeProcessed += rPos + 2;
-            } else {
-                oSizeProcessed += rPos + 1;
-            }
-        } else if (nPos == rPos && nPos == std::string::npos) {
-            nPos = data.size();
-            oSizeProcessed += nPos + 1;
-        }
-
-        lines.insert({ currentLine, { lineStart + oldOSizeProcessed, nPos + oldOSizeProcessed } });
-        const std::string_view line{ reinterpret_cast<const char*>(buf.GetData() + lineStart), nPos };
-
-        std::vector<uint64> separators;
-        {
-            size_t pos = line.find(settings->separator[0]);
-            while (pos != std::string::npos) {
-                separators.push_back(pos + oldOSizeProcessed);
-                pos = line.find(settings->separator[0], pos + 1);
-            }
-        }
-
-        std::vector<std::pair<uint64, uint64>> lTokens;
-        if (separators.empty()) {
-            lTokens.push_back({ lineStart + oldOSizeProcessed, nPos + oldOSizeProcessed });
-        }
-
-        {
-            auto tStart = oldOSizeProcessed;
-            auto tEnd   = oldOSizeProcessed;
-            for (const auto& i : separators) {
-                tEnd = i;
-                lTokens.push_back({ tStart, tEnd });
-                tStart = tEnd + 1;
-            }
-            lTokens.push_back({ tEnd + 1, oSizeProcessed });
-        }
-
-        tokens.insert({ currentLine, std::move(lTokens) });
-
-        currentLine++;
-
-    } while (oSizeProcessed < oSize);
-
-    settings->rows   = lines.size();
-    settings->cols   = tokens.size() > 0 ? tokens.begin()->second.size() : 0;
-    settings->lines  = std::move(lines);
-    settings->tokens = std::move(tokens);
+    if (!settings->tokens.Build(obj, settings->separator[0])) {
+        AppCUI::Dialogs::MessageBox::ShowError("Error", "Failed to tokenize the content!");
+    }
+    settings->rows = settings->tokens.GetRowsCount();
+    settings->cols = settings->tokens.GetColumnsCount();
 }
 
 void GView::View::GridViewer::Instance::PaintCursorInformationWidth(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y)
@@ -347,11 +687,11 @@ void GView::View::GridViewer::Instance::PaintCursorInformationWidth(AppCUI::Grap
 
     LocalString<256> ls;
 
-    const auto width = grid->GetWidth();
+    const auto width = columnsWidth.size();
     renderer.WriteText("Width:", params);
     params.Color = config.color.cursorInformation.value;
     params.X += 6;
-    ls.Format("%d", width);
+    ls.Format("%llu", static_cast<uint64>(width));
     renderer.WriteText(ls, params);
 }
 
@@ -366,11 +706,11 @@ void GView::View::GridViewer::Instance::PaintCursorInformationHeight(AppCUI::Gra
 
     LocalString<256> ls;
 
-    const auto height = grid->GetHeight();
+    const auto height = GetVisibleRowsCount();
     renderer.WriteText("Height:", params);
     params.Color = config.color.cursorInformation.value;
     params.X += 7;
-    ls.Format("%d", height);
+    ls.Format("%llu", height);
     renderer.WriteText(ls, params);
 }
 
@@ -385,11 +725,11 @@ void GView::View::GridViewer::Instance::PaintCursorInformationCells(AppCUI::Grap
 
     LocalString<256> ls;
 
-    const auto cells = grid->GetCellsCount();
+    const auto cells = GetVisibleRowsCount() * columnsWidth.size();
     renderer.WriteText("Cells:", params);
     params.Color = config.color.cursorInformation.value;
     params.X += 6;
-    ls.Format("%d", cells);
+    ls.Format("%llu", static_cast<uint64>(cells));
     renderer.WriteText(ls, params);
 }
 
@@ -404,14 +744,35 @@ void GView::View::GridViewer::Instance::PaintCursorInformationCurrentLocation(Ap
 
     LocalString<256> ls;
 
-    const auto location = grid->GetHoveredLocation();
-    renderer.WriteText("Hovered:", params);
+    renderer.WriteText("Current:", params);
     params.Color = config.color.cursorInformation.value;
     params.X += 9;
-    if (location == Point{ -1, -1 }) {
+    if (GetVisibleRowsCount() == 0) {
         ls.Format("- | -");
     } else {
-        ls.Format("%d | %d", location.X, location.Y);
+        ls.Format("%u | %llu", cursor.column, cursor.row);
+    }
+    renderer.WriteText(ls, params);
+}
+
+void GView::View::GridViewer::Instance::PaintCursorInformationSort(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y)
+{
+    WriteTextParams params{ WriteTextFlags::SingleLine };
+    params.Color = config.color.cursorInformation.name;
+    params.X     = x;
+    params.Y     = y;
+    params.Width = config.cursorInformationCellSpace;
+    params.Align = TextAlignament::Left;
+
+    LocalString<256> ls;
+
+    renderer.WriteText("Sorted:", params);
+    params.Color = config.color.cursorInformation.value;
+    params.X += 8;
+    if (!sort.active || sort.column >= header.size()) {
+        ls.Format("-");
+    } else {
+        ls.Format("%s (%s)", header[sort.column].c_str(), sort.ascending ? "asc" : "desc");
     }
     renderer.WriteText(ls, params);
 }
@@ -427,15 +788,13 @@ void GView::View::GridViewer::Instance::PaintCursorInformationSelection(AppCUI::
 
     LocalString<256> ls;
 
-    const auto start = grid->GetSelectionLocationsStart();
-    const auto end   = grid->GetSelectionLocationsEnd();
     renderer.WriteText("Selection:", params);
     params.Color = config.color.cursorInformation.value;
     params.X += 10;
-    if (start == Point{ -1, -1 } || end == Point{ -1, -1 }) {
+    if (!selecting) {
         ls.Format("- & - -> - & -");
     } else {
-        ls.Format("%d & %d -> %d & %d", start.X, start.Y, end.X, end.Y);
+        ls.Format("%u & %llu -> %u & %llu", anchor.column, anchor.row, cursor.column, cursor.row);
     }
     renderer.WriteText(ls, params);
 }
@@ -0,0 +1,282 @@
+#include "GridViewer.hpp"
+
+#include <bit>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define GRID_TOKENIZER_SSE2
+#    include <emmintrin.h>
+#endif
+
+using namespace GView::View::GridViewer;
+
+constexpr uint32 TOKENIZER_CHUNK_SIZE = 0x400000;
+
+constexpr uint64 EVENT_SEPARATOR = 0;
+constexpr uint64 EVENT_LF        = 1;
+constexpr uint64 EVENT_CR        = 2;
+
+namespace
+{
+uint64 CountQuotes(const uint8* p, uint32 size)
+{
+    uint64 count = 0;
+    uint32 idx   = 0;
+#ifdef GRID_TOKENIZER_SSE2
+    const auto quote = _mm_set1_epi8('"');
+    for (; idx + 16 <= size; idx += 16) {
+        const auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + idx));
+        count += std::popcount(static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, quote))));
+    }
+#endif
+    for (; idx < size; idx++) {
+        count += p[idx] == '"';
+    }
+    return count;
+}
+
+// every separator / new line outside of the quotes is stored as (offset << 2) | kind
+// a quote always toggles the state => an escaped quote ("") toggles it twice (RFC 4180)
+void ScanChunk(const uint8* p, uint32 size, uint64 offset, bool inQuotes, char separator, std::vector<uint64>& events)
+{
+    const auto AddEvent = [&](uint32 idx) {
+        const auto c = p[idx];
+        if (c == '"') {
+            inQuotes = !inQuotes;
+        } else if (!inQuotes) {
+            const auto kind = c == '\n' ? EVENT_LF : (c == '\r' ? EVENT_CR : EVENT_SEPARATOR);
+            events.push_back(((offset + idx) << 2) | kind);
+        }
+    };
+
+    uint32 idx = 0;
+#ifdef GRID_TOKENIZER_SSE2
+    const auto quote = _mm_set1_epi8('"');
+    const auto sep   = _mm_set1_epi8(separator);
+    const auto lf    = _mm_set1_epi8('\n');
+    const auto cr    = _mm_set1_epi8('\r');
+    for (; idx + 16 <= size; idx += 16) {
+        const auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + idx));
+        const auto any  = _mm_or_si128(
+              _mm_or_si128(_mm_cmpeq_epi8(data, quote), _mm_cmpeq_epi8(data, sep)), _mm_or_si128(_mm_cmpeq_epi8(data, lf), _mm_cmpeq_epi8(data, cr)));
+        for (auto mask = static_cast<uint32>(_mm_movemask_epi8(any)); mask; mask &= mask - 1) {
+            AddEvent(idx + std::countr_zero(mask));
+        }
+    }
+#endif
+    for (; idx < size; idx++) {
+        const auto c = p[idx];
+        if ((c == '"') || (c == static_cast<uint8>(separator)) || (c == '\n') || (c == '\r')) {
+            AddEvent(idx);
+        }
+    }
+}
+} // namespace
+
+bool TokenIndex::ReadChunk(Reference<GView::Object> object, AppCUI::OS::File* file, uint64 offset, uint32 length, Buffer& buffer)
+{
+    if (file) {
+        buffer.Resize(length);
+        CHECK(file->SetCurrentPos(offset), false, "");
+        CHECK(file->Read(buffer.GetData(), length), false, "Fail to read %u bytes from %llu", length, offset);
+        return true;
+    }
+    // the cache of the object is not thread safe
+    std::lock_guard<std::mutex> guard(lock);
+    buffer = object->GetData().CopyToBuffer(offset, length, true);
+    return buffer.GetLength() == length;
+}
+
+bool TokenIndex::ForEachChunk(Reference<GView::Object> object, uint64 size, const std::function<void(uint32 chunk, BufferView data)>& process)
+{
+    const auto chunksCount  = static_cast<uint32>((size + TOKENIZER_CHUNK_SIZE - 1) / TOKENIZER_CHUNK_SIZE);
+    const auto threadsCount = std::min<uint32>(std::max<uint32>(std::thread::hardware_concurrency(), 1), chunksCount);
+    std::atomic<uint32> nextChunk{ 0 };
+    std::atomic<bool> failed{ false };
+
+    const auto worker = [&]() {
+        // every worker has its own handle => reads do not wait for each other
+        std::unique_ptr<AppCUI::OS::File> file;
+        if (object->GetObjectType() == Object::Type::File) {
+            file = std::make_unique<AppCUI::OS::File>();
+            if (!file->OpenRead(std::filesystem::path(object->GetPath()))) {
+                file.reset();
+            }
+        }
+        Buffer buffer;
+        while (!failed) {
+            const auto chunk = nextChunk++;
+            if (chunk >= chunksCount) {
+                break;
+            }
+            const auto offset = static_cast<uint64>(chunk) * TOKENIZER_CHUNK_SIZE;
+            const auto length = static_cast<uint32>(std::min<uint64>(TOKENIZER_CHUNK_SIZE, size - offset));
+            if (!ReadChunk(object, file.get(), offset, length, buffer)) {
+                failed = true;
+                break;
+            }
+            process(chunk, BufferView(buffer.GetData(), length));
+        }
+        if (file) {
+            file->Close();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (uint32 idx = 1; idx < threadsCount; idx++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : workers) {
+        t.join();
+    }
+    return !failed;
+}
+
+/*
+    The content is split in chunks that are tokenized in parallel:
+    - a first pass counts the quotes from every chunk => the parity of the quotes before a chunk tells if the chunk starts
+      inside a quoted field (separators and new lines from a quoted field are part of the field)
+    - a second pass finds the separators / new lines outside of the quotes from every chunk
+    - the results are merged in order in the flat arrays (a CR followed by a LF is a single new line)
+*/
+bool TokenIndex::Build(Reference<GView::Object> object, char separator)
+{
+    Clear();
+    CHECK(object.IsValid(), false, "");
+    const auto size = object->GetData().GetSize();
+    if (size == 0) {
+        return true;
+    }
+
+    const auto chunksCount = static_cast<uint32>((size + TOKENIZER_CHUNK_SIZE - 1) / TOKENIZER_CHUNK_SIZE);
+    std::vector<uint64> quotes(chunksCount, 0);
+    CHECK(ForEachChunk(object, size, [&](uint32 chunk, BufferView data) { quotes[chunk] = CountQuotes(data.GetData(), static_cast<uint32>(data.GetLength())); }),
+          false,
+          "Fail to read the content");
+
+    std::vector<bool> startsInQuotes(chunksCount, false);
+    for (uint32 idx = 1; idx < chunksCount; idx++) {
+        startsInQuotes[idx] = startsInQuotes[idx - 1] ^ ((quotes[idx - 1] & 1) != 0);
+    }
+
+    std::vector<std::vector<uint64>> events(chunksCount);
+    CHECK(ForEachChunk(
+                object,
+                size,
+                [&](uint32 chunk, BufferView data) {
+                    ScanChunk(
+                          data.GetData(),
+                          static_cast<uint32>(data.GetLength()),
+                          static_cast<uint64>(chunk) * TOKENIZER_CHUNK_SIZE,
+                          startsInQuotes[chunk],
+                          separator,
+                          events[chunk]);
+                }),
+          false,
+          "Fail to read the content");
+
+    uint64 eventsCount = 0;
+    for (const auto& e : events) {
+        eventsCount += e.size();
+    }
+    fieldEnds.reserve(eventsCount + 1);
+
+    uint64 afterCR = UINT64_MAX;
+    rowStarts.push_back(0);
+    rowFirstField.push_back(0);
+    for (auto& chunkEvents : events) {
+        for (const auto event : chunkEvents) {
+            const auto offset = event >> 2;
+            const auto kind   = event & 3;
+            if (kind == EVENT_SEPARATOR) {
+                fieldEnds.push_back(offset);
+                continue;
+            }
+            if ((kind == EVENT_LF) && (afterCR == offset)) {
+                // CR LF => the row was already closed by CR
+                rowStarts.back() = offset + 1;
+                continue;
+            }
+            afterCR = kind == EVENT_CR ? offset + 1 : UINT64_MAX;
+            fieldEnds.push_back(offset);
+            columnsCount = std::max<uint64>(columnsCount, fieldEnds.size() - rowFirstField.back());
+            rowStarts.push_back(offset + 1);
+            rowFirstField.push_back(fieldEnds.size());
+        }
+        std::vector<uint64>().swap(chunkEvents);
+    }
+
+    // the last row is not followed by a new line (if the content ends with a new line there is no other row)
+    if (rowStarts.back() < size) {
+        fieldEnds.push_back(size);
+        columnsCount = std::max<uint64>(columnsCount, fieldEnds.size() - rowFirstField.back());
+        rowStarts.push_back(size);
+        rowFirstField.push_back(fieldEnds.size());
+    }
+    fieldEnds.shrink_to_fit();
+    rowStarts.shrink_to_fit();
+    rowFirstField.shrink_to_fit();
+
+    return true;
+}
+
+void TokenIndex::Clear()
+{
+    rowStarts.clear();
+    rowFirstField.clear();
+    fieldEnds.clear();
+    columnsCount = 0;
+}
+
+uint64 TokenIndex::GetRowsCount() const
+{
+    return rowStarts.empty() ? 0 : rowStarts.size() - 1;
+}
+
+uint32 TokenIndex::GetFieldsCount(uint64 row) const
+{
+    CHECK(row < GetRowsCount(), 0, "");
+    return static_cast<uint32>(rowFirstField[row + 1] - rowFirstField[row]);
+}
+
+bool TokenIndex::GetField(uint64 row, uint32 column, uint64& start, uint64& end) const
+{
+    CHECK(row < GetRowsCount(), false, "");
+    const auto field = rowFirstField[row] + column;
+    CHECK(field < rowFirstField[row + 1], false, "");
+
+    start = column == 0 ? rowStarts[row] : fieldEnds[field - 1] + 1;
+    end   = fieldEnds[field];
+    return true;
+}
+
+bool TokenIndex::GetFieldText(Reference<GView::Object> object, uint64 row, uint32 column, std::string& text, uint32 maxSize) const
+{
+    text.clear();
+    uint64 start, end;
+    CHECK(GetField(row, column, start, end), false, "");
+    if (start == end) {
+        return true;
+    }
+
+    const auto truncated = end - start > maxSize;
+    const auto buffer    = object->GetData().CopyToBuffer(start, static_cast<uint32>(truncated ? maxSize : end - start), true);
+    CHECK(buffer.IsValid(), false, "");
+    const std::string_view raw{ reinterpret_cast<const char*>(buffer.GetData()), buffer.GetLength() };
+
+    // "a ""quoted"" value" => a "quoted" value (a truncated field does not have its closing quote)
+    if ((raw.front() == '"') && (truncated || ((raw.size() >= 2) && (raw.back() == '"')))) {
+        const auto contentEnd = truncated ? raw.size() : raw.size() - 1;
+        text.reserve(contentEnd);
+        for (size_t idx = 1; idx < contentEnd; idx++) {
+            text.push_back(raw[idx]);
+            if ((raw[idx] == '"') && (idx + 1 < contentEnd) && (raw[idx + 1] == '"')) {
+                idx++;
+            }
+        }
+    } else {
+        text.assign(raw);
+    }
+    return true;
+}
\ No newline at end of file
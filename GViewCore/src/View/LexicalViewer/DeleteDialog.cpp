@@ -7,11 +7,11 @@ constexpr int32 BTN_ID_OK      = 1;
 constexpr int32 BTN_ID_CANCEL  = 2;
 constexpr int32 APPLY_GROUP_ID = 1;
 
-DeleteDialog::DeleteDialog(TokenObject& tok, const char16* text, bool hasSelection, bool belongsToABlock)
+DeleteDialog::DeleteDialog(u16string_view tokenText, bool hasSelection, bool belongsToABlock)
     : Window("Delete", "d:c,w:70,h:12", WindowFlags::ProcessReturn)
 {
     Factory::Label::Create(this, "Delete the following token (or block/selection) ?", "x:1,y:1,w:60");
-    Factory::TextField::Create(this, tok.GetText(text), "x:1,y:2,w:65", TextFieldFlags::Readonly);
+    Factory::TextField::Create(this, tokenText, "x:1,y:2,w:65", TextFieldFlags::Readonly);
 
     // apply methods
     this->rbApplyOnCurrent = Factory::RadioBox::Create(this, "Delete &current token alone", "x:1,y:4,w:60", APPLY_GROUP_ID);
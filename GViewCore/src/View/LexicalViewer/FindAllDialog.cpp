@@ -9,7 +9,7 @@ constexpr int32 BTN_ID_OK             = 1;
 constexpr int32 BTN_ID_CANCEL         = 2;
 constexpr uint32 INVALID_TOKEN_NUMBER = 0xFFFFFFFF;
 
-FindAllDialog::FindAllDialog(const TokenObject& currentToken, const std::vector<TokenObject>& tokens, const char16* txt)
+FindAllDialog::FindAllDialog(const TokenObject& currentToken, const Instance& instance)
     : Window("All apearences", "d:c,w:80,h:20", WindowFlags::ProcessReturn)
 {
     LocalString<128> tmp;
@@ -18,17 +18,16 @@ FindAllDialog::FindAllDialog(const TokenObject& currentToken, const std::vector<
 
     lst = Factory::ListView::Create(this, "l:1,t:0,r:1,b:3", { "n:Line,a:l,w:6", "n:Content,a:l,w:200" }, ListViewFlags::HideSearchBar);
     // add all lines
-    auto len      = static_cast<uint32>(tokens.size());
-    auto lastLine = 0xFFFFFFFFU;
-    auto ctokSize = static_cast<uint32>(currentToken.GetText(txt).size());
+    const auto& tokens = instance.tokens;
+    auto lastLine      = 0xFFFFFFFFU;
+    auto ctokSize      = static_cast<uint32>(instance.GetTokenText(currentToken).size());
     uint32 indexes[64];
     uint32 indexesCount;
 
-    for (auto idx = 0U; idx < len; idx++)
+    // only the similar tokens (in order)
+    for (auto idx : instance.GetSimilarTokens(currentToken.hash))
     {
         const auto& tok = tokens[idx];
-        if (tok.hash != currentToken.hash)
-            continue;
         if (tok.lineNo == lastLine)
             continue;
         auto item = lst->AddItem(tmp.Format("%d", tok.lineNo));
@@ -63,7 +62,7 @@ FindAllDialog::FindAllDialog(const TokenObject& currentToken, const std::vector<
                 indexes[indexesCount++] = content.Len();
             }
 
-            content.Add(tokens[start].GetText(txt));
+            content.Add(instance.GetTokenText(tokens[start]));
             lastX = tokens[start].end;
             start++;
         }
@@ -120,11 +120,56 @@ void Instance::UpdateTokensInformation()
     - height
     - hashing
     */
-    for (auto& tok : this->tokens)
+    UpdateTokensInformation(0, static_cast<uint32>(this->tokens.size()));
+}
+void Instance::UpdateTokensInformation(uint32 start, uint32 end)
+{
+    for (; start < end; start++)
+    {
+        auto& tok          = this->tokens[start];
+        const auto content = GetTokenText(tok);
+        const auto oldHash = tok.hash;
+        tok.UpdateSizes(content);
+        tok.UpdateHash(content, this->settings->ignoreCase);
+        this->similarTokens.Update(start, oldHash, tok.hash);
+    }
+}
+u16string_view Instance::GetTokenText(const TokenObject& tok) const
+{
+    const auto value = GetTokenValue(tok);
+    if (value.empty())
+        return { this->text.text + tok.start, (size_t) (tok.end - tok.start) };
+    return value;
+}
+u16string_view Instance::GetTokenValue(const TokenObject& tok) const
+{
+    if (!tok.HasExtraData())
+        return {};
+    return this->tokensExtraData[tok.extraDataID].value.ToStringView();
+}
+u16string_view Instance::GetTokenError(const TokenObject& tok) const
+{
+    if (!tok.HasExtraData())
+        return {};
+    return this->tokensExtraData[tok.extraDataID].error.ToStringView();
+}
+bool Instance::SetTokenValue(TokenObject& tok, const ConstString& value)
+{
+    if (!tok.HasExtraData())
     {
-        tok.UpdateSizes(this->text.text);
-        tok.UpdateHash(this->text.text, this->settings->ignoreCase);
+        tok.extraDataID = static_cast<uint32>(this->tokensExtraData.size());
+        this->tokensExtraData.emplace_back();
     }
+    return this->tokensExtraData[tok.extraDataID].value.Set(value);
+}
+bool Instance::SetTokenError(TokenObject& tok, const ConstString& error)
+{
+    if (!tok.HasExtraData())
+    {
+        tok.extraDataID = static_cast<uint32>(this->tokensExtraData.size());
+        this->tokensExtraData.emplace_back();
+    }
+    return this->tokensExtraData[tok.extraDataID].error.Set(error);
 }
 void Instance::MoveToClosestVisibleToken(uint32 startIndex, bool selected)
 {
@@ -654,13 +699,7 @@ uint32 Instance::CountSimilarTokens(uint32 start, uint32 end, uint64 hash)
 {
     if ((size_t) end > this->tokens.size())
         return 0;
-    uint32 count = 0;
-    for (; start < end; start++)
-    {
-        if (tokens[start].hash == hash)
-            count++;
-    }
-    return count;
+    return static_cast<uint32>(this->similarTokens.Get(hash, start, end).size());
 }
 
 void Instance::MakeTokenVisible(uint32 index)
@@ -724,6 +763,8 @@ void Instance::Parse()
     this->showMetaData      = true; // has to be true at this point to proper compute line numbers
 
     this->tokens.clear();
+    this->tokensExtraData.clear();
+    this->similarTokens.Clear();
     this->blocks.clear();
     this->selection.Clear();
 
@@ -746,32 +787,36 @@ void Instance::Parse()
 
         // step 3 (recompute line numbers)
         // the list of tokens and blocks has been cleared so we know for sure that everything is expanded
-        auto lastY  = -1;
-        auto lineNo = 0;
-        for (auto& tok : this->tokens)
+        RecomputeLineNumbers();
+    }
+}
+void Instance::RecomputeLineNumbers()
+{
+    auto lastY  = -1;
+    auto lineNo = 0;
+    for (auto& tok : this->tokens)
+    {
+        if (tok.pos.y != lastY)
         {
-            if (tok.pos.y != lastY)
-            {
-                lineNo++;
-                lastY = tok.pos.y;
-            }
-            tok.lineNo = lineNo;
-        }
-        // at the end --> lineNo is the highest line number
-        this->lineNrWidth    = 0;
-        this->lastLineNumber = lineNo;
-
-        if (lastLineNumber < 100)
-            this->lineNrWidth = 4;
-        else if (lastLineNumber < 1000)
-            this->lineNrWidth = 5;
-        else if (lastLineNumber < 10000)
-            this->lineNrWidth = 6;
-        else if (lastLineNumber < 100000)
-            this->lineNrWidth = 7;
-        else
-            this->lineNrWidth = 8;
+            lineNo++;
+            lastY = tok.pos.y;
+        }
+        tok.lineNo = lineNo;
     }
+    // at the end --> lineNo is the highest line number
+    this->lineNrWidth    = 0;
+    this->lastLineNumber = lineNo;
+
+    if (lastLineNumber < 100)
+        this->lineNrWidth = 4;
+    else if (lastLineNumber < 1000)
+        this->lineNrWidth = 5;
+    else if (lastLineNumber < 10000)
+        this->lineNrWidth = 6;
+    else if (lastLineNumber < 100000)
+        this->lineNrWidth = 7;
+    else
+        this->lineNrWidth = 8;
 }
 void Instance::Reparse(bool openInNewWindow)
 {
@@ -781,36 +826,52 @@ void Instance::Reparse(bool openInNewWindow)
     }
     else
     {
-        TextEditorBuilder ted(this->text);
-        auto res   = RebuildTextFromTokens(ted);
-        this->text = ted.Release();
+        std::vector<TextEditor::EditedRegion> regions;
+        TextEditorBuilder ted(nullptr, 0);
+        auto res     = RebuildTextFromTokens(ted, regions);
+        auto newText = ted.Release();
         if (!res)
         {
+            newText.Destroy();
             this->noItemsVisible = true; // hide all text
             AppCUI::Dialogs::MessageBox::ShowError("Error", "Fail to reparse current text !");
+            this->Parse();
+            return;
         }
-        this->Parse();
+        ReparseEditedRegions(newText, regions);
     }
 }
-bool Instance::RebuildTextFromTokens(TextEditor& editor)
+bool Instance::RebuildTextFromTokens(TextEditor& editor, std::vector<TextEditor::EditedRegion>& regions)
 {
-    auto it  = this->tokens.crbegin();
-    auto end = this->tokens.crend();
-    for (; it != end; it++)
+    // the text is built in one pass (replacing every token in place would move the rest of the text each time)
+    regions.clear();
+    if (!editor.Reserve(this->text.size))
+        return false;
+    uint32 offset = 0;
+    for (const auto& tok : this->tokens)
     {
-        if (it->IsMarkForDeletion())
-        {
-            editor.Delete(it->start, it->end - it->start);
+        const auto deleted = tok.IsMarkForDeletion();
+        const auto value   = GetTokenValue(tok);
+        if ((!deleted) && (value.empty()))
             continue;
+        if (!editor.Add(u16string_view{ this->text.text + offset, (size_t) (tok.start - offset) }))
+            return false;
+        const auto start = editor.Len();
+        if ((!deleted) && (!editor.Add(value)))
+            return false;
+        if ((!regions.empty()) && (regions.back().start + regions.back().size == start) && (offset == tok.start))
+        {
+            // consecutive tokens => one region
+            regions.back().size += editor.Len() - start;
+            regions.back().originalSize += tok.end - tok.start;
         }
-        if (it->value.Len() > 0)
+        else
         {
-            if (!editor.Replace(it->start, it->end - it->start, it->value.ToStringView()))
-                return false;
-            continue;
+            regions.push_back({ start, editor.Len() - start, tok.end - tok.start });
         }
+        offset = tok.end;
     }
-    return true;
+    return editor.Add(u16string_view{ this->text.text + offset, (size_t) (this->text.size - offset) });
 }
 void Instance::BakupTokensPositions()
 {
@@ -872,7 +933,7 @@ void Instance::FillBlockSpace(Graphics::Renderer& renderer, const BlockObject& b
 
 void Instance::PaintToken(Graphics::Renderer& renderer, const TokenObject& tok, uint32 index)
 {
-    u16string_view txt = tok.GetText(this->text.text);
+    u16string_view txt = GetTokenText(tok);
     ColorPair col;
     bool onCursor    = index == this->currentTokenIndex;
     bool onSelection = this->selection.Contains(index);
@@ -1273,28 +1334,13 @@ void Instance::MoveToNextSimilarToken(int32 direction)
     if (noItemsVisible)
         return;
     const auto& tok = this->tokens[this->currentTokenIndex];
-    auto index      = this->currentTokenIndex;
     if (tok.hash == 0)
     {
         AppCUI::Dialogs::MessageBox::ShowError("Error", "This type of token has similarity search disabled !");
+        return;
     }
-    do
-    {
-        if (direction == 1)
-        {
-            index++;
-            if (index >= this->tokens.size())
-                index = 0;
-        }
-        else
-        {
-            if (index == 0)
-                index = static_cast<uint32>(this->tokens.size() - 1);
-            else
-                index--;
-        }
-    } while ((index != this->currentTokenIndex) && (this->tokens[index].hash != tok.hash));
-    if (index == this->currentTokenIndex)
+    const auto index = this->similarTokens.GetNext(tok.hash, this->currentTokenIndex, direction == 1);
+    if (index == SimilarTokensIndex::NOT_FOUND)
     {
         AppCUI::Dialogs::MessageBox::ShowNotification("Similar tokens", "There aren't any similar tokens to this one !");
     }
@@ -1372,7 +1418,7 @@ void Instance::FoldAll()
 }
 void Instance::ShowStringOpDialog(TokenObject& tok)
 {
-    StringOpDialog dlg(tok, this->text.text, settings->parser);
+    StringOpDialog dlg(tok, *this, settings->parser);
     if (dlg.Show() != Dialogs::Result::Ok)
         return;
     if (dlg.ShouldOpenANewWindow())
@@ -1410,7 +1456,8 @@ void Instance::ShowStringOpDialog(TokenObject& tok)
     else
     {
         // update value
-        UpdateTokensInformation();
+        const auto index = static_cast<uint32>(&tok - this->tokens.data());
+        UpdateTokensInformation(index, index + 1);
         RecomputeTokenPositions();
     }
 }
@@ -1424,7 +1471,7 @@ void Instance::ShowRefactorDialog(TokenObject& tok)
 
     // all good -> edit the token
     auto containerBlock = TokenToBlock(this->currentTokenIndex);
-    NameRefactorDialog dlg(tok, this->text.text, selection.HasSelection(0), containerBlock != BlockObject::INVALID_ID);
+    NameRefactorDialog dlg(tok, this->text.text, GetTokenValue(tok), selection.HasSelection(0), containerBlock != BlockObject::INVALID_ID);
     if (dlg.Show() == Dialogs::Result::Ok)
     {
         auto method = dlg.GetApplyMethod();
@@ -1459,20 +1506,23 @@ void Instance::ShowRefactorDialog(TokenObject& tok)
             if (AppCUI::Dialogs::MessageBox::ShowOkCancel("Rename", tmp.Format("Rename %u tokens ?", count)) != AppCUI::Dialogs::Result::Ok)
                 return;
         }
-        for (auto idx = start; idx < end; idx++)
-        {
-            if (tokens[idx].hash == tok.hash)
-                tokens[idx].value = dlg.GetNewValue();
-        }
+        UnicodeStringBuilder newValue;
+        newValue = dlg.GetNewValue();
+        // only the similar tokens are changed (their hash changes as well => the list is copied from the index)
+        const auto similar = this->similarTokens.Get(tok.hash, start, end);
+        std::vector<uint32> renamed(similar.begin(), similar.end());
         // Update the original as well
-        tok.value = dlg.GetNewValue();
+        renamed.push_back(static_cast<uint32>(&tok - this->tokens.data()));
+        for (auto idx : renamed)
+            SetTokenValue(tokens[idx], newValue.ToStringView());
         if (dlg.ShouldReparse())
         {
             this->Reparse(false);
         }
         else
         {
-            UpdateTokensInformation();
+            for (auto idx : renamed)
+                UpdateTokensInformation(idx, idx + 1);
             RecomputeTokenPositions();
         }
     }
@@ -1487,9 +1537,9 @@ void Instance::EditCurrentToken()
     auto& tok = this->tokens[this->currentTokenIndex];
     if (!tok.IsVisible())
         return;
-    if (tok.error.Len() > 0)
+    if (!GetTokenError(tok).empty())
     {
-        AppCUI::Dialogs::MessageBox::ShowError("Error", tok.error);
+        AppCUI::Dialogs::MessageBox::ShowError("Error", GetTokenError(tok));
     }
     if (tok.dataType == TokenDataType::String)
         ShowStringOpDialog(tok);
@@ -1507,7 +1557,7 @@ void Instance::DeleteTokens()
 
     // all good -> edit the token
     auto containerBlock = TokenToBlock(this->currentTokenIndex);
-    DeleteDialog dlg(tok, this->text.text, selection.HasSelection(0), containerBlock != BlockObject::INVALID_ID);
+    DeleteDialog dlg(GetTokenText(tok), selection.HasSelection(0), containerBlock != BlockObject::INVALID_ID);
     if (dlg.Show() == Dialogs::Result::Ok)
     {
         auto method = dlg.GetApplyMethod();
@@ -1823,9 +1873,7 @@ void Instance::ShowPlugins()
         RecomputeTokenPositions();
         break;
     case PluginAfterActionRequest::Rescan:
-        this->text.Destroy();
-        this->text = textClone;
-        this->Parse();
+        ReparseEditedRegions(textClone, ted.GetEditedRegions());
         break;
     default:
         textClone.Destroy();
@@ -1907,7 +1955,7 @@ void Instance::ShowSaveAsDialog()
             b.AddMultipleTimes(" ", tok.pos.x - x);
             x = tok.pos.x;
         }
-        auto txt    = tok.GetText(this->text.text);
+        auto txt    = GetTokenText(tok);
         auto lastCH = static_cast<char16>(0);
         for (auto ch : txt)
         {
@@ -1977,7 +2025,7 @@ void Instance::ShowFindAllDialog()
         return;
     }
 
-    FindAllDialog dlg(tok, this->tokens, this->text.text);
+    FindAllDialog dlg(tok, *this);
 
     if (dlg.Show() == Dialogs::Result::Ok)
     {
@@ -2138,8 +2186,8 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 16, "Line:", tmp.Format("%d/%d", tok.lineNo, this->lastLineNumber));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 9, "Col:", tmp.Format("%d", tok.pos.x + 1));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 18, "Char ofs:", tmp.Format("%u", tok.start));
-        if (tok.error.Len() > 0)
-            xPoz = PrintError(tok.error, xPoz, 0, 50, r);
+        if (!GetTokenError(tok).empty())
+            xPoz = PrintError(GetTokenError(tok), xPoz, 0, 50, r);
         else
             xPoz = this->PrintTokenTypeInfo(tok.type, xPoz, 0, 30, r);
         break;
@@ -2152,9 +2200,9 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
         xPoz = this->WriteCursorInfo(r, xPoz, 1, 16, "Col : ", tmp.Format("%d", tok.pos.x + 1));
         this->WriteCursorInfo(r, xPoz, 0, 18, "Char ofs: ", tmp.Format("%u", tok.start));
         xPoz = this->WriteCursorInfo(r, xPoz, 1, 18, "Tokens  : ", tmp.Format("%u", (size_t) tokens.size()));
-        this->WriteCursorInfo(r, xPoz, 0, 35, "Token     : ", tok.GetText(this->text.text));
-        if (tok.error.Len() > 0)
-            xPoz = PrintError(tok.error, xPoz, 1, 35, r);
+        this->WriteCursorInfo(r, xPoz, 0, 35, "Token     : ", GetTokenText(tok));
+        if (!GetTokenError(tok).empty())
+            xPoz = PrintError(GetTokenError(tok), xPoz, 1, 35, r);
         else
             xPoz = this->PrintTokenTypeInfo(tok.type, xPoz, 1, 35, r);
         break;
@@ -2165,10 +2213,10 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
         PrintSelectionInfo(3, xPoz, 0, 16, r);
         this->WriteCursorInfo(r, xPoz, 1, 16, "Line: ", tmp.Format("%d/%d", tok.lineNo, this->lastLineNumber));
         xPoz = this->WriteCursorInfo(r, xPoz, 2, 16, "Col : ", tmp.Format("%d", tok.pos.x + 1));
-        this->WriteCursorInfo(r, xPoz, 0, 35, "Token     : ", tok.GetText(this->text.text));
+        this->WriteCursorInfo(r, xPoz, 0, 35, "Token     : ", GetTokenText(tok));
         this->PrintTokenTypeInfo(tok.type, xPoz, 1, 35, r);
-        if (tok.error.Len() > 0)
-            xPoz = PrintError(tok.error, xPoz, 2, 35, r);
+        if (!GetTokenError(tok).empty())
+            xPoz = PrintError(GetTokenError(tok), xPoz, 2, 35, r);
         else
             xPoz = this->PrintDataTypeInfo(tok.dataType, xPoz, 2, 35, r);
         break;
@@ -2185,11 +2233,11 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
         xPoz = this->WriteCursorInfo(r, xPoz, 3, 20, "Tokens  : ", tmp.Format("%u", (size_t) tokens.size()));
 
         // Third column
-        this->WriteCursorInfo(r, xPoz, 0, 40, "Token     : ", tok.GetText(this->text.text));
+        this->WriteCursorInfo(r, xPoz, 0, 40, "Token     : ", GetTokenText(tok));
         this->WriteCursorInfo(r, xPoz, 1, 40, "Original  : ", tok.GetOriginalText(this->text.text));
         this->PrintTokenTypeInfo(tok.type, xPoz, 2, 40, r);
-        if (tok.error.Len() > 0)
-            xPoz = PrintError(tok.error, xPoz, 3, 40, r);
+        if (!GetTokenError(tok).empty())
+            xPoz = PrintError(GetTokenError(tok), xPoz, 3, 40, r);
         else
             xPoz = this->PrintDataTypeInfo(tok.dataType, xPoz, 3, 40, r);
 
@@ -130,20 +130,32 @@ namespace View
             uint32 width, height;
             TokenStatus status;
         };
-        struct TokenObject
+        // rarely used data of a token (a value set by a plugin / a refactor or an error) => it is kept outside of TokenObject
+        struct TokenExtraData
         {
             UnicodeStringBuilder value;
             UnicodeStringBuilder error;
+        };
+        // the text of a token is a span of Instance::text (unless it has a new value in its extra data)
+        struct TokenObject
+        {
+            static constexpr uint32 NO_EXTRA_DATA = 0xFFFFFFFF;
+
             uint64 hash;
             uint32 start, end, type;
             uint32 blockID; // for blocks
             uint32 lineNo;
             uint32 contentWidth, contentHeight;
+            uint32 extraDataID; // index in Instance::tokensExtraData (or NO_EXTRA_DATA)
             TokenPosition pos;
             TokenAlignament align;
             TokenColor color;
             TokenDataType dataType;
 
+            inline bool HasExtraData() const
+            {
+                return extraDataID != NO_EXTRA_DATA;
+            }
             inline bool IsVisible() const
             {
                 return (static_cast<uint8>(pos.status) & static_cast<uint8>(TokenStatus::Visible)) != 0;
@@ -203,30 +215,39 @@ namespace View
                 pos.status = static_cast<TokenStatus>(
                       static_cast<uint8>(pos.status) | static_cast<uint8>(TokenStatus::DisableSimilarityHighlight));
             }
-            void UpdateSizes(const char16* text);
-            inline void UpdateHash(const char16* text, bool ignoreCase)
+            void UpdateSizes(u16string_view content);
+            inline void UpdateHash(u16string_view content, bool ignoreCase)
             {
                 if ((static_cast<uint8>(pos.status) & static_cast<uint8>(TokenStatus::DisableSimilarityHighlight)) != 0)
                 {
                     this->hash = 0;
                     return;
                 }
-                if (this->value.Len() == 0)
-                    this->hash = TextParser::ComputeHash64({ text + start, (size_t) (end - start) }, ignoreCase);
-                else
-                    this->hash = TextParser::ComputeHash64(this->value.ToStringView(), ignoreCase);
+                this->hash = TextParser::ComputeHash64(content, ignoreCase);
             }
             inline u16string_view GetOriginalText(const char16* text) const
             {
                 return { text + start, (size_t) (end - start) };
             }
-            inline u16string_view GetText(const char16* text) const
-            {
-                if (this->value.Len() == 0)
-                    return { text + start, (size_t) (end - start) };
-                else
-                    return this->value.ToStringView();
-            }
+        };
+
+        // hash => sorted indexes of the tokens with that hash (tokens with hash 0 have the similarity search disabled and are not indexed)
+        class SimilarTokensIndex
+        {
+            std::unordered_map<uint64, std::vector<uint32>> groups;
+
+          public:
+            static constexpr uint32 NOT_FOUND = 0xFFFFFFFF;
+
+            void Clear();
+            void Add(uint32 index, uint64 hash);
+            void Remove(uint32 index, uint64 hash);
+            void Update(uint32 index, uint64 oldHash, uint64 newHash);
+            void Remap(const std::function<uint32(uint32)>& newIndex);
+
+            std::span<const uint32> Get(uint64 hash) const;
+            std::span<const uint32> Get(uint64 hash, uint32 start, uint32 end) const;
+            uint32 GetNext(uint64 hash, uint32 index, bool forward) const;
         };
 
         struct SettingsData
@@ -312,6 +333,8 @@ namespace View
             bool highlightSimilarTokens;
 
             std::vector<TokenPosition> backupedTokenPositionList;
+            std::vector<TokenExtraData> tokensExtraData;
+            SimilarTokensIndex similarTokens;
 
             struct
             {
@@ -332,6 +355,7 @@ namespace View
             void RecomputeTokenPositions();
             void UpdateVisibilityStatus(uint32 start, uint32 end, bool visible);
             void UpdateTokensInformation();
+            void UpdateTokensInformation(uint32 start, uint32 end);
             void MoveToClosestVisibleToken(uint32 startIndex, bool selected);
 
             void FillBlockSpace(Graphics::Renderer& renderer, const BlockObject& block);
@@ -364,9 +388,12 @@ namespace View
             void ShowRefactorDialog(TokenObject& tok);
             void ShowStringOpDialog(TokenObject& tok);
 
-            bool RebuildTextFromTokens(TextEditor& edidor);
+            bool RebuildTextFromTokens(TextEditor& editor, std::vector<TextEditor::EditedRegion>& regions);
             void Parse();
             void Reparse(bool openInNewWindow);
+            void RecomputeLineNumbers();
+            void ReparseEditedRegions(UnicodeString& newText, const std::vector<TextEditor::EditedRegion>& regions);
+            bool ReparseEditedRegionsOnly(UnicodeString& newText, const std::vector<TextEditor::EditedRegion>& regions);
 
             int PrintSelectionInfo(uint32 selectionID, int x, int y, uint32 width, Renderer& r);
             int PrintTokenTypeInfo(uint32 tokenTypeID, int x, int y, uint32 width, Renderer& r);
@@ -384,6 +411,15 @@ namespace View
             {
                 return text.size;
             }
+            u16string_view GetTokenText(const TokenObject& tok) const;
+            u16string_view GetTokenValue(const TokenObject& tok) const;
+            u16string_view GetTokenError(const TokenObject& tok) const;
+            bool SetTokenValue(TokenObject& tok, const ConstString& value);
+            bool SetTokenError(TokenObject& tok, const ConstString& error);
+            inline std::span<const uint32> GetSimilarTokens(uint64 hash) const
+            {
+                return similarTokens.Get(hash);
+            }
             inline char16* GetUnicodeText() const
             {
                 return text.text;
@@ -443,7 +479,7 @@ namespace View
             Reference<CheckBox> cbReparse;
 
           public:
-            NameRefactorDialog(TokenObject& tok, const char16* text, bool hasSelection, bool belongsToABlock);
+            NameRefactorDialog(TokenObject& tok, const char16* text, u16string_view currentValue, bool hasSelection, bool belongsToABlock);
             virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
 
             inline bool ShouldReparse()
@@ -478,17 +514,17 @@ namespace View
         class StringOpDialog : public Window
         {
             TokenObject& tok;
+            Instance& instance;
             Reference<TextArea> txValue;
             Reference<ParseInterface> parser;
             TextEditorBuilder editor;
-            const char16* text;
             bool openInANewWindow;
             
             void UpdateValue(bool original);
             void UpdateTokenValue();
             void RunStringOperation(uint32 commandID);
           public:
-            StringOpDialog(TokenObject& tok, const char16* text, Reference<ParseInterface> parser);
+            StringOpDialog(TokenObject& tok, Instance& instance, Reference<ParseInterface> parser);
             virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
             inline bool ShouldOpenANewWindow() const
             {
@@ -504,7 +540,7 @@ namespace View
             Reference<RadioBox> rbApplyOnCurrent, rbApplyOnBlock, rbApplyOnSelection;
 
           public:
-            DeleteDialog(TokenObject& tok, const char16* text, bool hasSelection, bool belongsToABlock);
+            DeleteDialog(u16string_view tokenText, bool hasSelection, bool belongsToABlock);
             virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
             inline ApplyMethod GetApplyMethod()
             {
@@ -568,7 +604,7 @@ namespace View
             void Validate();
 
           public:
-            FindAllDialog(const TokenObject& currentToken,const std::vector<TokenObject>& tokens, const char16* txt);
+            FindAllDialog(const TokenObject& currentToken, const Instance& instance);
 
             virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
             inline uint32 GetSelectedTokenIndex() const
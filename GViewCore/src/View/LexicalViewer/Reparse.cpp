@@ -0,0 +1,422 @@
+#include "LexicalViewer.hpp"
+
+namespace GView::View::LexicalViewer
+{
+namespace
+{
+    // a part of the tokens list that is analyzed again (old tokens [tokenStart, tokenEnd) are replaced)
+    struct ReparseWindow
+    {
+        uint32 tokenStart, tokenEnd;
+        uint32 textStart, textEnd;       // in the old text
+        uint32 newTextStart, newTextEnd; // in the edited text
+        uint32 newTokenStart, newBlockStart;
+        UnicodeString text; // the (preprocessed) content of the window
+        std::vector<TokenObject> tokens;
+        std::vector<BlockObject> blocks;
+        std::vector<TokenExtraData> extraData;
+    };
+
+    // the innermost block that contains a token (without the block started by that token)
+    std::vector<uint32> ComputeParentBlocks(const std::vector<TokenObject>& tokens, const std::vector<BlockObject>& blocks)
+    {
+        std::vector<uint32> parents(tokens.size(), BlockObject::INVALID_ID);
+        std::vector<uint32> openedBlocks;
+        const auto tokensCount = static_cast<uint32>(tokens.size());
+        const auto blocksCount = static_cast<uint32>(blocks.size());
+        for (uint32 idx = 0; idx < tokensCount; idx++)
+        {
+            while ((!openedBlocks.empty()) && (blocks[openedBlocks.back()].tokenEnd < idx))
+                openedBlocks.pop_back();
+            parents[idx] = openedBlocks.empty() ? BlockObject::INVALID_ID : openedBlocks.back();
+            if ((tokens[idx].IsBlockStarter()) && (tokens[idx].blockID < blocksCount))
+                openedBlocks.push_back(tokens[idx].blockID);
+        }
+        return parents;
+    }
+
+    // extends [start, end) so that every block is either completely inside or completely outside of it
+    void ExtendToBlockBoundaries(
+          uint32& start, uint32& end, const std::vector<TokenObject>& tokens, const std::vector<BlockObject>& blocks, const std::vector<uint32>& parents)
+    {
+        const auto blocksCount = static_cast<uint32>(blocks.size());
+        const auto innermost   = [&](uint32 index) {
+            const auto& tok = tokens[index];
+            return ((tok.IsBlockStarter()) && (tok.blockID < blocksCount)) ? tok.blockID : parents[index];
+        };
+
+        // the innermost block that keeps its first and last token outside of [start, end)
+        auto parent = parents[start];
+        while ((parent != BlockObject::INVALID_ID) && (end > blocks[parent].tokenEnd))
+            parent = parents[blocks[parent].tokenStart];
+
+        for (auto blockID = innermost(start); (blockID != parent) && (blockID != BlockObject::INVALID_ID); blockID = parents[start])
+            start = blocks[blockID].tokenStart;
+        auto last = end - 1;
+        for (auto blockID = innermost(last); (blockID != parent) && (blockID != BlockObject::INVALID_ID); blockID = parents[blocks[blockID].tokenStart])
+            last = std::max<>(last, blocks[blockID].tokenEnd);
+        end = last + 1;
+    }
+
+    // the types of the tokens that start or end a block (adding or removing one of them changes the blocks outside of a window)
+    std::vector<uint32> GetBlockTokenTypes(const std::vector<TokenObject>& tokens, const std::vector<BlockObject>& blocks)
+    {
+        // there are only a few such types => a linear search is enough
+        std::vector<uint32> types;
+        const auto AddType = [&types](uint32 type) {
+            if (std::find(types.begin(), types.end(), type) == types.end())
+                types.push_back(type);
+        };
+        for (const auto& block : blocks)
+        {
+            AddType(tokens[block.tokenStart].type);
+            if (block.HasEndMarker())
+                AddType(tokens[block.tokenEnd].type);
+        }
+        std::sort(types.begin(), types.end());
+        return types;
+    }
+    std::vector<uint32> CountTokensWithType(const TokenObject* start, const TokenObject* end, const std::vector<uint32>& types)
+    {
+        std::vector<uint32> count(types.size(), 0);
+        for (; start < end; start++)
+        {
+            const auto it = std::lower_bound(types.begin(), types.end(), start->type);
+            if ((it != types.end()) && (*it == start->type))
+                count[it - types.begin()]++;
+        }
+        return count;
+    }
+    uint32 CountErrors(const std::vector<TokenExtraData>& extraData)
+    {
+        uint32 count = 0;
+        for (const auto& e : extraData)
+            count += e.error.Len() > 0 ? 1 : 0;
+        return count;
+    }
+} // namespace
+
+/*
+    Only the parts of the text that were changed are analyzed again:
+    - every edited region is extended with one untouched token on each side and then to the closest block boundaries
+      (a block is either completely re-analyzed or not at all)
+    - the content of each window is preprocessed and analyzed on its own (the text, tokens and blocks of the instance are
+      temporarily replaced with the ones from the window)
+    - if the first / last token from a window are not the same as before (e.g. a string that is not closed) the
+      changes leaked outside of the window => the whole text is analyzed again
+    - the new tokens and blocks are spliced in place of the old ones
+*/
+bool Instance::ReparseEditedRegionsOnly(UnicodeString& newText, const std::vector<TextEditor::EditedRegion>& regions)
+{
+    if ((!this->settings->parser) || (this->tokens.empty()) || (regions.empty()))
+        return false;
+
+    const auto tokensCount = static_cast<uint32>(this->tokens.size());
+    const auto parents     = ComputeParentBlocks(this->tokens, this->blocks);
+    auto blockTypes        = GetBlockTokenTypes(this->tokens, this->blocks);
+
+    // step 1 (find the windows from the old text)
+    std::vector<ReparseWindow> windows;
+    int64 delta = 0;
+    for (const auto& region : regions)
+    {
+        const auto oldStart = static_cast<uint32>(region.start - delta);
+        const auto oldEnd   = oldStart + region.originalSize;
+        delta += static_cast<int64>(region.size) - static_cast<int64>(region.originalSize);
+
+        auto first = static_cast<uint32>(
+              std::lower_bound(this->tokens.begin(), this->tokens.end(), oldStart, [](const TokenObject& tok, uint32 ofs) { return tok.end < ofs; }) -
+              this->tokens.begin());
+        auto last = static_cast<uint32>(
+              std::upper_bound(this->tokens.begin(), this->tokens.end(), oldEnd, [](uint32 ofs, const TokenObject& tok) { return ofs < tok.start; }) -
+              this->tokens.begin());
+        first = first > 0 ? first - 1 : 0;
+        last  = std::min<>(last + 1, tokensCount);
+        if (first >= last)
+            first = last - 1;
+
+        auto& w      = windows.emplace_back();
+        w.tokenStart = first;
+        w.tokenEnd   = last;
+    }
+    // merging two windows might require a larger block => repeat until they are all separated
+    for (auto merged = true; merged;)
+    {
+        merged = false;
+        for (auto& w : windows)
+            ExtendToBlockBoundaries(w.tokenStart, w.tokenEnd, this->tokens, this->blocks, parents);
+        std::sort(windows.begin(), windows.end(), [](const ReparseWindow& a, const ReparseWindow& b) { return a.tokenStart < b.tokenStart; });
+        auto count = static_cast<size_t>(0);
+        for (size_t idx = 1; idx < windows.size(); idx++)
+        {
+            if (windows[idx].tokenStart < windows[count].tokenEnd)
+            {
+                windows[count].tokenEnd = std::max<>(windows[count].tokenEnd, windows[idx].tokenEnd);
+                merged                  = true;
+            }
+            else
+            {
+                count++;
+                windows[count].tokenStart = windows[idx].tokenStart;
+                windows[count].tokenEnd   = windows[idx].tokenEnd;
+            }
+        }
+        windows.resize(count + 1);
+    }
+    uint32 tokensToReparse = 0;
+    for (const auto& w : windows)
+        tokensToReparse += w.tokenEnd - w.tokenStart;
+    if (tokensToReparse > tokensCount / 2)
+        return false; // it is faster to analyze everything again
+
+    // step 2 (find the content of every window in the edited text)
+    size_t regionIndex = 0;
+    delta              = 0;
+    for (auto& w : windows)
+    {
+        w.textStart = w.tokenStart == 0 ? 0 : this->tokens[w.tokenStart].start;
+        w.textEnd   = w.tokenEnd == tokensCount ? this->text.size : this->tokens[w.tokenEnd - 1].end;
+        // the regions are either before or inside a window
+        while ((regionIndex < regions.size()) && (regions[regionIndex].start - delta < w.textStart))
+        {
+            delta += static_cast<int64>(regions[regionIndex].size) - static_cast<int64>(regions[regionIndex].originalSize);
+            regionIndex++;
+        }
+        w.newTextStart = static_cast<uint32>(w.textStart + delta);
+        while ((regionIndex < regions.size()) && (regions[regionIndex].start - delta <= w.textEnd))
+        {
+            delta += static_cast<int64>(regions[regionIndex].size) - static_cast<int64>(regions[regionIndex].originalSize);
+            regionIndex++;
+        }
+        w.newTextEnd    = static_cast<uint32>(w.textEnd + delta);
+        const auto size = w.newTextEnd - w.newTextStart;
+        w.text          = UnicodeString(new char16[std::max<>(size, 1U)], size, std::max<>(size, 1U));
+        memcpy(w.text.text, newText.text + w.newTextStart, size * sizeof(char16));
+    }
+
+    // step 3 (analyze every window)
+    const auto DestroyWindows = [&windows]() {
+        for (auto& w : windows)
+            w.text.Destroy();
+    };
+    for (auto& w : windows)
+    {
+        TextEditorBuilder ted(w.text);
+        this->settings->parser->PreprocessText(ted);
+        w.text = ted.Release();
+
+        std::swap(this->text, w.text);
+        std::swap(this->tokens, w.tokens);
+        std::swap(this->blocks, w.blocks);
+        std::swap(this->tokensExtraData, w.extraData);
+        {
+            TokensListBuilder tokensList(this);
+            BlocksListBuilder blockList(this);
+            TextParser textParser(this->text.text, this->text.size);
+            SyntaxManager syntax(textParser, tokensList, blockList);
+            this->settings->parser->AnalyzeText(syntax);
+        }
+        std::swap(this->text, w.text);
+        std::swap(this->tokens, w.tokens);
+        std::swap(this->blocks, w.blocks);
+        std::swap(this->tokensExtraData, w.extraData);
+
+        // the tokens around the edited regions must be the same (otherwise the changes go beyond the window)
+        auto valid = !w.tokens.empty();
+        if ((valid) && (w.tokenStart > 0))
+        {
+            const auto& original = this->tokens[w.tokenStart];
+            const auto& tok      = w.tokens.front();
+            valid = (tok.start == 0) && (tok.end - tok.start == original.end - original.start) && (tok.type == original.type);
+        }
+        if ((valid) && (w.tokenEnd < tokensCount))
+        {
+            const auto& original = this->tokens[w.tokenEnd - 1];
+            const auto& tok      = w.tokens.back();
+            valid = (tok.end == w.text.size) && (tok.end - tok.start == original.end - original.start) && (tok.type == original.type);
+        }
+        // the same blocks structure (a new bracket could close a block from outside of the window)
+        if (valid)
+        {
+            const auto windowBlockTypes = GetBlockTokenTypes(w.tokens, w.blocks);
+            blockTypes.insert(blockTypes.end(), windowBlockTypes.begin(), windowBlockTypes.end());
+            std::sort(blockTypes.begin(), blockTypes.end());
+            blockTypes.erase(std::unique(blockTypes.begin(), blockTypes.end()), blockTypes.end());
+
+            // no blocks at all => any type of token could be a bracket
+            auto types = blockTypes;
+            if (types.empty())
+            {
+                for (auto idx = w.tokenStart; idx < w.tokenEnd; idx++)
+                    types.push_back(this->tokens[idx].type);
+                for (const auto& tok : w.tokens)
+                    types.push_back(tok.type);
+                std::sort(types.begin(), types.end());
+                types.erase(std::unique(types.begin(), types.end()), types.end());
+            }
+            uint32 oldBlocks = 0;
+            for (auto idx = w.tokenStart; idx < w.tokenEnd; idx++)
+                oldBlocks += this->tokens[idx].IsBlockStarter() ? 1 : 0;
+            const auto* oldTokens = this->tokens.data();
+            valid                 = (oldBlocks == w.blocks.size()) &&
+                    (CountTokensWithType(oldTokens + w.tokenStart, oldTokens + w.tokenEnd, types) ==
+                     CountTokensWithType(w.tokens.data(), w.tokens.data() + w.tokens.size(), types));
+        }
+        // a part of a file analyzed on its own might not be valid (e.g. the content of a JSON object without the object)
+        if ((valid) && (CountErrors(w.extraData) > 0))
+        {
+            uint32 errors = 0;
+            for (auto idx = w.tokenStart; idx < w.tokenEnd; idx++)
+                errors += GetTokenError(this->tokens[idx]).empty() ? 0 : 1;
+            valid = errors >= CountErrors(w.extraData);
+        }
+        if (!valid)
+        {
+            DestroyWindows();
+            return false;
+        }
+    }
+
+    // step 4 (positions of the windows in the new lists)
+    int64 tokensDelta = 0;
+    for (auto& w : windows)
+    {
+        w.newTokenStart = static_cast<uint32>(w.tokenStart + tokensDelta);
+        tokensDelta += static_cast<int64>(w.tokens.size()) - static_cast<int64>(w.tokenEnd - w.tokenStart);
+    }
+    // the index of an old token in the new list (or INVALID_ID if it was replaced)
+    const auto MapTokenIndex = [&](uint32 index) -> uint32 {
+        auto it = std::upper_bound(windows.begin(), windows.end(), index, [](uint32 idx, const ReparseWindow& w) { return idx < w.tokenStart; });
+        if (it == windows.begin())
+            return index;
+        it--;
+        if (index < it->tokenEnd)
+            return BlockObject::INVALID_ID;
+        return static_cast<uint32>(index + it->newTokenStart + it->tokens.size() - it->tokenEnd);
+    };
+
+    // step 5 (blocks)
+    std::vector<BlockObject> newBlocks;
+    std::vector<uint32> blockIDs(this->blocks.size(), BlockObject::INVALID_ID);
+    newBlocks.reserve(this->blocks.size());
+    for (size_t idx = 0; idx < this->blocks.size(); idx++)
+    {
+        const auto tokenStart = MapTokenIndex(this->blocks[idx].tokenStart);
+        if (tokenStart == BlockObject::INVALID_ID)
+            continue;
+        const auto tokenEnd = MapTokenIndex(this->blocks[idx].tokenEnd);
+        if (tokenEnd == BlockObject::INVALID_ID)
+        {
+            // a block that is not completely inside or outside of a window (should not happen)
+            DestroyWindows();
+            return false;
+        }
+        blockIDs[idx]    = static_cast<uint32>(newBlocks.size());
+        auto& block      = newBlocks.emplace_back(this->blocks[idx]);
+        block.tokenStart = tokenStart;
+        block.tokenEnd   = tokenEnd;
+    }
+    for (auto& w : windows)
+    {
+        w.newBlockStart = static_cast<uint32>(newBlocks.size());
+        for (auto& b : w.blocks)
+        {
+            auto& block = newBlocks.emplace_back(std::move(b));
+            block.tokenStart += w.newTokenStart;
+            block.tokenEnd += w.newTokenStart;
+        }
+    }
+
+    // step 6 (tokens and text)
+    std::vector<TokenObject> newTokens;
+    std::vector<TokenExtraData> newExtraData;
+    newTokens.reserve(static_cast<size_t>(tokensCount + tokensDelta));
+    auto textSize = newText.size;
+    for (const auto& w : windows)
+        textSize = textSize - (w.newTextEnd - w.newTextStart) + w.text.size;
+    auto finalText  = UnicodeString(new char16[std::max<>(textSize, 1U)], 0, std::max<>(textSize, 1U));
+    int64 textDelta = 0;
+
+    const auto AddTokens = [&](TokenObject* start, TokenObject* end, int64 offset, std::vector<TokenExtraData>& extraData, const uint32* ids, uint32 blockOffset) {
+        for (; start < end; start++)
+        {
+            auto& tok = newTokens.emplace_back(*start);
+            tok.start = static_cast<uint32>(tok.start + offset);
+            tok.end   = static_cast<uint32>(tok.end + offset);
+            if (tok.blockID != BlockObject::INVALID_ID)
+                tok.blockID = ids ? ids[tok.blockID] : tok.blockID + blockOffset;
+            if (tok.HasExtraData())
+            {
+                newExtraData.emplace_back(std::move(extraData[tok.extraDataID]));
+                tok.extraDataID = static_cast<uint32>(newExtraData.size() - 1);
+            }
+        }
+    };
+    uint32 oldToken = 0, newTextOffset = 0;
+    for (auto& w : windows)
+    {
+        AddTokens(this->tokens.data() + oldToken, this->tokens.data() + w.tokenStart, textDelta, this->tokensExtraData, blockIDs.data(), 0);
+        memcpy(finalText.text + finalText.size, newText.text + newTextOffset, (w.newTextStart - newTextOffset) * sizeof(char16));
+        finalText.size += w.newTextStart - newTextOffset;
+
+        AddTokens(w.tokens.data(), w.tokens.data() + w.tokens.size(), finalText.size, w.extraData, nullptr, w.newBlockStart);
+        memcpy(finalText.text + finalText.size, w.text.text, w.text.size * sizeof(char16));
+        finalText.size += w.text.size;
+
+        newTextOffset = w.newTextEnd;
+        oldToken      = w.tokenEnd;
+        textDelta     = static_cast<int64>(finalText.size) - w.textEnd;
+    }
+    AddTokens(this->tokens.data() + oldToken, this->tokens.data() + tokensCount, textDelta, this->tokensExtraData, blockIDs.data(), 0);
+    memcpy(finalText.text + finalText.size, newText.text + newTextOffset, (newText.size - newTextOffset) * sizeof(char16));
+    finalText.size += newText.size - newTextOffset;
+
+    // all good => the new content replaces the old one
+    // (the replaced tokens leave the similarity index, the new ones are added by UpdateTokensInformation)
+    auto sameTokensCount = true;
+    for (const auto& w : windows)
+    {
+        for (auto idx = w.tokenStart; idx < w.tokenEnd; idx++)
+            this->similarTokens.Remove(idx, this->tokens[idx].hash);
+        sameTokensCount &= w.tokens.size() == w.tokenEnd - w.tokenStart;
+    }
+    if (!sameTokensCount)
+        this->similarTokens.Remap(MapTokenIndex);
+    const auto currentToken = MapTokenIndex(this->currentTokenIndex);
+    this->tokens            = std::move(newTokens);
+    this->blocks            = std::move(newBlocks);
+    this->tokensExtraData   = std::move(newExtraData);
+    this->text.Destroy();
+    this->text = finalText;
+    newText.Destroy();
+    for (auto& w : windows)
+        UpdateTokensInformation(w.newTokenStart, static_cast<uint32>(w.newTokenStart + w.tokens.size()));
+    DestroyWindows();
+
+    // same state as after Parse(), but the scroll and the current token are kept
+    this->currentTokenIndex = currentToken == BlockObject::INVALID_ID ? 0 : currentToken;
+    this->currentHash       = 0;
+    this->showMetaData      = true; // has to be true at this point to proper compute line numbers
+    this->selection.Clear();
+    for (auto& block : this->blocks)
+        this->tokens[block.tokenStart].SetFolded(false);
+    RecomputeTokenPositions();
+    MoveToClosestVisibleToken(this->currentTokenIndex, false);
+    RecomputeLineNumbers();
+    return true;
+}
+void Instance::ReparseEditedRegions(UnicodeString& newText, const std::vector<TextEditor::EditedRegion>& regions)
+{
+    if (regions.empty())
+    {
+        // nothing was changed
+        newText.Destroy();
+        return;
+    }
+    if (ReparseEditedRegionsOnly(newText, regions))
+        return;
+    this->text.Destroy();
+    this->text = newText;
+    this->Parse();
+}
+} // namespace GView::View::LexicalViewer
@@ -0,0 +1,90 @@
+#include "LexicalViewer.hpp"
+
+namespace GView::View::LexicalViewer
+{
+void SimilarTokensIndex::Clear()
+{
+    groups.clear();
+}
+void SimilarTokensIndex::Add(uint32 index, uint64 hash)
+{
+    if (hash == 0)
+        return;
+    auto& group = groups[hash];
+    // tokens are usually added in order (after a parse)
+    if ((group.empty()) || (group.back() < index))
+    {
+        group.push_back(index);
+        return;
+    }
+    auto it = std::lower_bound(group.begin(), group.end(), index);
+    if ((it == group.end()) || (*it != index))
+        group.insert(it, index);
+}
+void SimilarTokensIndex::Remove(uint32 index, uint64 hash)
+{
+    if (hash == 0)
+        return;
+    auto git = groups.find(hash);
+    if (git == groups.end())
+        return;
+    auto& group = git->second;
+    auto it     = std::lower_bound(group.begin(), group.end(), index);
+    if ((it == group.end()) || (*it != index))
+        return;
+    group.erase(it);
+    if (group.empty())
+        groups.erase(git);
+}
+void SimilarTokensIndex::Update(uint32 index, uint64 oldHash, uint64 newHash)
+{
+    if (oldHash == newHash)
+        return;
+    Remove(index, oldHash);
+    Add(index, newHash);
+}
+void SimilarTokensIndex::Remap(const std::function<uint32(uint32)>& newIndex)
+{
+    // the mapping keeps the order of the tokens => every group remains sorted
+    for (auto& [hash, group] : groups)
+    {
+        for (auto& index : group)
+            index = newIndex(index);
+    }
+}
+std::span<const uint32> SimilarTokensIndex::Get(uint64 hash) const
+{
+    if (hash == 0)
+        return {};
+    auto it = groups.find(hash);
+    if (it == groups.end())
+        return {};
+    return std::span<const uint32>(it->second.data(), it->second.size());
+}
+std::span<const uint32> SimilarTokensIndex::Get(uint64 hash, uint32 start, uint32 end) const
+{
+    const auto group = Get(hash);
+    const auto first = std::lower_bound(group.begin(), group.end(), start);
+    const auto last  = std::lower_bound(first, group.end(), end);
+    return group.subspan(static_cast<size_t>(first - group.begin()), static_cast<size_t>(last - first));
+}
+uint32 SimilarTokensIndex::GetNext(uint64 hash, uint32 index, bool forward) const
+{
+    const auto group = Get(hash);
+    if (group.empty())
+        return NOT_FOUND;
+    uint32 result;
+    if (forward)
+    {
+        auto it = std::upper_bound(group.begin(), group.end(), index);
+        result  = it == group.end() ? group.front() : *it;
+    }
+    else
+    {
+        auto it = std::lower_bound(group.begin(), group.end(), index);
+        result  = it == group.begin() ? group.back() : *(it - 1);
+    }
+    // the only similar token is the token itself
+    return result == index ? NOT_FOUND : result;
+}
+} // namespace GView::View::LexicalViewer
@@ -23,9 +23,9 @@ struct
              { "Un&escape characters", StringOperationsPlugins::UnescapedCharacters },
              { "Esc&ape non-ASCII Characters", StringOperationsPlugins::EscapeNonAsciiCharacters } };
 
-StringOpDialog::StringOpDialog(TokenObject& _tok, const char16* _text, Reference<ParseInterface> _parser)
-    : Window("String Operations", "d:c,w:80,h:20", WindowFlags::ProcessReturn | WindowFlags::Menu), tok(_tok), parser(_parser),
-      editor(nullptr, 0), text(_text), openInANewWindow(false)
+StringOpDialog::StringOpDialog(TokenObject& _tok, Instance& _instance, Reference<ParseInterface> _parser)
+    : Window("String Operations", "d:c,w:80,h:20", WindowFlags::ProcessReturn | WindowFlags::Menu), tok(_tok), instance(_instance), parser(_parser),
+      editor(nullptr, 0), openInANewWindow(false)
 {
     auto tokMnu = this->AddMenu("&Token");
     tokMnu->AddCommandItem("Restore &original value", CMD_ID_RELOAD_ORIGINAL);
@@ -53,7 +53,7 @@ StringOpDialog::StringOpDialog(TokenObject& _tok, const char16* _text, Reference
 void StringOpDialog::UpdateValue(bool original)
 {
     LocalUnicodeStringBuilder<512> tmp;
-    auto val = original ? tok.GetOriginalText(text) : tok.GetText(text);
+    auto val = original ? tok.GetOriginalText(instance.GetUnicodeText()) : instance.GetTokenText(tok);
     if (parser->StringToContent(val, tmp) == false)
     {
         AppCUI::Dialogs::MessageBox::ShowError(
@@ -115,8 +115,8 @@ void StringOpDialog::UpdateTokenValue()
         return;
     }
     // all good --> set value to token
-    tok.value.Set(output);
-    tok.error.Clear();
+    instance.SetTokenValue(tok, output);
+    instance.SetTokenError(tok, "");
     Exit(Dialogs::Result::Ok);
 }
 bool StringOpDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
@@ -18,14 +18,14 @@ void Reverse(TextEditor& editor, uint32 start, uint32 end)
 void UpperCase(TextEditor& editor, uint32 start, uint32 end)
 {
     for (auto index = start; index < end; index++)
-        if ((editor[index] >= 'a') && (editor[index] <= 'z'))
+        if ((editor.GetChar(index) >= 'a') && (editor.GetChar(index) <= 'z'))
             editor[index] -= 32;
 }
 
 void LowerCase(TextEditor& editor, uint32 start, uint32 end)
 {
     for (auto index = start; index < end; index++)
-        if ((editor[index] >= 'A') && (editor[index] <= 'Z'))
+        if ((editor.GetChar(index) >= 'A') && (editor.GetChar(index) <= 'Z'))
             editor[index] |= 0x20;
 }
 
@@ -35,11 +35,11 @@ void RemoveUnnecesaryWhiteSpaces(TextEditor& editor, uint32 start, uint32 end)
     auto pos = 0u;
     while (pos < len)
     {
-        if ((editor[pos] == ' ') || (editor[pos] == '\t'))
+        if ((editor.GetChar(pos) == ' ') || (editor.GetChar(pos) == '\t'))
         {
             // check to see if there are multiple ones
             auto next = pos;
-            while ((next < len) && ((editor[next] == ' ') || (editor[next] == '\t')))
+            while ((next < len) && ((editor.GetChar(next) == ' ') || (editor.GetChar(next) == '\t')))
                 next++;
             if (next - pos >= 2)
             {
@@ -47,11 +47,11 @@ void RemoveUnnecesaryWhiteSpaces(TextEditor& editor, uint32 start, uint32 end)
                 len = editor.Len();
             }
         }
-        if ((editor[pos] == '\n') || (editor[pos] == '\r'))
+        if ((editor.GetChar(pos) == '\n') || (editor.GetChar(pos) == '\r'))
         {
             // check to see if there are multiple ones
             auto next = pos;
-            while ((next < len) && ((editor[next] == '\n') || (editor[next] == '\r')))
+            while ((next < len) && ((editor.GetChar(next) == '\n') || (editor.GetChar(next) == '\r')))
                 next++;
             if (next - pos >= 2)
             {
@@ -95,18 +95,19 @@ void UnescapedCharacters(TextEditor& editor, uint32 start, uint32 end)
 
     for (auto i = 0u; i < editor.Len(); i++)
     {
-        if (editor[i] != '\\')
+        if (editor.GetChar(i) != '\\')
             continue;
-        if (editor[i + 1] == 'x' && IsHex(editor[i + 2]) && IsHex(editor[i + 3]))
+        if (editor.GetChar(i + 1) == 'x' && IsHex(editor.GetChar(i + 2)) && IsHex(editor.GetChar(i + 3)))
         {
-            editor[i] = HexCharToValue(editor[i + 2]) * 0x10 + HexCharToValue(editor[i + 3]);
+            editor[i] = HexCharToValue(editor.GetChar(i + 2)) * 0x10 + HexCharToValue(editor.GetChar(i + 3));
             editor.Delete(i + 1, 3);
             continue;
         }
-        if (editor[i + 1] == 'u' && IsHex(editor[i + 2]) && IsHex(editor[i + 3]) && IsHex(editor[i + 4]) && IsHex(editor[i + 5]))
+        if (editor.GetChar(i + 1) == 'u' && IsHex(editor.GetChar(i + 2)) && IsHex(editor.GetChar(i + 3)) && IsHex(editor.GetChar(i + 4)) &&
+            IsHex(editor.GetChar(i + 5)))
         {
-            editor[i] = HexCharToValue(editor[i + 2]) * 0x1000 + HexCharToValue(editor[i + 3]) * 0x100 + HexCharToValue(editor[i + 4]) * 0x10 +
-                        HexCharToValue(editor[i + 5]);
+            editor[i] = HexCharToValue(editor.GetChar(i + 2)) * 0x1000 + HexCharToValue(editor.GetChar(i + 3)) * 0x100 +
+                        HexCharToValue(editor.GetChar(i + 4)) * 0x10 + HexCharToValue(editor.GetChar(i + 5));
             editor.Delete(i + 1, 5);
             continue;
         }
@@ -118,10 +119,10 @@ void EscapeNonAsciiCharacters(TextEditor& editor, uint32 start, uint32 end)
     AppCUI::Utils::NumericFormatter fmt;
 
     for (auto i = 0u; i < editor.Len(); i++) {
-        if ((int) editor[i] <= 127)
+        if ((int) editor.GetChar(i) <= 127)
             continue;
 
-        auto code = fmt.ToHex(editor[i]);
+        auto code = fmt.ToHex(editor.GetChar(i));
 
         editor.Replace(i, 1, u"\\u");
         editor.Insert(i + 2, code);
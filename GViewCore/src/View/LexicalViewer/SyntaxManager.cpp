@@ -167,13 +167,13 @@ bool Token::DisableSimilartyHighlight()
 bool Token::SetText(const ConstString& text)
 {
     CREATE_TOKENREF(false);
-    return tok.value.Set(text);
+    return INSTANCE->SetTokenValue(tok, text);
 }
 bool Token::SetError(const ConstString& error)
 {
     CREATE_TOKENREF(false);
     tok.color = TokenColor::Error;
-    return tok.error.Set(error);
+    return INSTANCE->SetTokenError(tok, error);
 }
 bool Token::Delete()
 {
@@ -192,15 +192,10 @@ std::optional<uint32> Token::GetTokenEndOffset() const
     return tok.end;
 }
 // Token Object
-void TokenObject::UpdateSizes(const char16* text)
+void TokenObject::UpdateSizes(u16string_view content)
 {
-    const char16* p = text + start;
-    const char16* e = text + end;
-    if (this->value.Len() > 0)
-    {
-        p = this->value.GetString();
-        e = this->value.GetString() + this->value.Len();
-    }
+    const char16* p = content.data();
+    const char16* e = p + content.size();
     auto nrLines = 1U;
     auto w       = 0U;
     auto maxW    = 0U;
@@ -301,6 +296,7 @@ Token TokensList::Add(
     cToken.type          = typeID;
     cToken.start         = start;
     cToken.end           = end;
+    cToken.hash          = 0; // not indexed yet
     cToken.pos.status    = TokenStatus::Visible;
     cToken.pos.x         = 0;
     cToken.pos.y         = 0;
@@ -311,6 +307,7 @@ Token TokensList::Add(
     cToken.lineNo        = 0;
     cToken.color         = color;
     cToken.blockID       = BlockObject::INVALID_ID;
+    cToken.extraDataID   = TokenObject::NO_EXTRA_DATA;
     cToken.align         = align;
     cToken.dataType      = dataType;
 
@@ -67,10 +67,48 @@ bool TextEditor::Grow(size_t newSize)
         return false;
     }
 }
+/*
+    Keeps track of the parts of the text that were changed, so that only those parts need to be analyzed again:
+    - the regions that touch [offset, offset + removedCount] are merged into one region
+    - the regions after it are moved with the difference between the inserted and the removed characters
+*/
+void TextEditor::MarkAsEdited(uint32 offset, uint32 removedCount, uint32 insertedCount)
+{
+    if ((removedCount == 0) && (insertedCount == 0))
+        return;
+    const auto count = editedRegions.size();
+    size_t first     = 0;
+    while ((first < count) && (editedRegions[first].start + editedRegions[first].size < offset))
+        first++;
+
+    auto start              = offset;
+    auto end                = offset + removedCount;
+    uint32 sizeInRegions    = 0;
+    uint32 originalInRegion = 0;
+    auto last               = first;
+    for (; (last < count) && (editedRegions[last].start <= offset + removedCount); last++)
+    {
+        start = std::min<>(start, editedRegions[last].start);
+        end   = std::max<>(end, editedRegions[last].start + editedRegions[last].size);
+        sizeInRegions += editedRegions[last].size;
+        originalInRegion += editedRegions[last].originalSize;
+    }
+    for (auto idx = last; idx < count; idx++)
+        editedRegions[idx].start = editedRegions[idx].start + insertedCount - removedCount;
+
+    // the characters between the merged regions are still the original ones
+    const EditedRegion region = { start, end - start - removedCount + insertedCount, originalInRegion + (end - start - sizeInRegions) };
+    editedRegions.erase(editedRegions.begin() + first, editedRegions.begin() + last);
+    editedRegions.insert(editedRegions.begin() + first, region);
+}
 char16& TextEditor::operator[](uint32 index)
 {
     if (index < size)
+    {
+        // the character can be changed through the reference
+        MarkAsEdited(index, 1, 1);
         return text[index];
+    }
     else
     {
         indexOperatorTempChar = 0;
@@ -144,6 +182,7 @@ bool TextEditor::Insert(uint32 offset, std::string_view newText)
     memmove(this->text + offset + newText.size(), this->text + offset, (this->size - offset) * sizeof(char16));
     COPY_ASCII(offset, newText.data(), newText.size());
     size += static_cast<uint32>(newText.size());
+    MarkAsEdited(offset, 0, static_cast<uint32>(newText.size()));
     return true;
 }
 bool TextEditor::Insert(uint32 offset, std::u16string_view newText)
@@ -158,6 +197,7 @@ bool TextEditor::Insert(uint32 offset, std::u16string_view newText)
     memmove(this->text + offset + newText.size(), this->text + offset, (this->size - offset) * sizeof(char16));
     COPY_UNICODE16(offset, newText.data(), newText.size());
     size += static_cast<uint32>(newText.size());
+    MarkAsEdited(offset, 0, static_cast<uint32>(newText.size()));
     return true;
 }
 bool TextEditor::InsertChar(uint32 offset, char16 ch)
@@ -171,6 +211,7 @@ bool TextEditor::InsertChar(uint32 offset, char16 ch)
     }
     text[offset] = ch;
     size++;
+    MarkAsEdited(offset, 0, 1);
     return true;
 }
 bool TextEditor::Replace(uint32 offset, uint32 count, std::string_view newText)
@@ -179,6 +220,7 @@ bool TextEditor::Replace(uint32 offset, uint32 count, std::string_view newText)
         return false;
     if (offset + count >= size)
     {
+        MarkAsEdited(offset, size - offset, 0);
         this->size = offset;
         return Add(newText);
     }
@@ -194,6 +236,7 @@ bool TextEditor::Replace(uint32 offset, uint32 count, std::string_view newText)
         this->size -= (uint32) ((size_t) count - newText.size());
     }
     COPY_ASCII(offset, newText.data(), newText.size());
+    MarkAsEdited(offset, count, static_cast<uint32>(newText.size()));
     return true;
 }
 bool TextEditor::Replace(uint32 offset, uint32 count, std::u16string_view newText)
@@ -202,6 +245,7 @@ bool TextEditor::Replace(uint32 offset, uint32 count, std::u16string_view newTex
         return false;
     if (offset + count >= size)
     {
+        MarkAsEdited(offset, size - offset, 0);
         this->size = offset;
         return Add(newText);
     }
@@ -217,6 +261,7 @@ bool TextEditor::Replace(uint32 offset, uint32 count, std::u16string_view newTex
         this->size -= (uint32) ((size_t) count - newText.size());
     }
     COPY_UNICODE16(offset, newText.data(), newText.size());
+    MarkAsEdited(offset, count, static_cast<uint32>(newText.size()));
     return true;
 }
 bool TextEditor::ReplaceAll(std::string_view textToSearch, std::string_view textToReplaceWith, bool ignoreCase)
@@ -247,6 +292,7 @@ bool TextEditor::DeleteChar(uint32 offset)
         memmove(this->text + offset, this->text + offset + 1, (this->size - (offset + 1)) * sizeof(char16));
     }
     size--;
+    MarkAsEdited(offset, 1, 0);
     return true;
 }
 bool TextEditor::Delete(uint32 offset, uint32 charactersCount)
@@ -256,17 +302,20 @@ bool TextEditor::Delete(uint32 offset, uint32 charactersCount)
     if ((offset + charactersCount) >= size)
     {
         // last characters to delete
+        MarkAsEdited(offset, size - offset, 0);
         size = offset;
         return true;
     }
     memmove(this->text + offset, this->text + offset + charactersCount, (this->size - (offset + charactersCount)) * sizeof(char16));
     size -= charactersCount;
+    MarkAsEdited(offset, charactersCount, 0);
     return true;
 }
 bool TextEditor::Add(std::string_view newText)
 {
     GROW_TO(newText.size() + size);
     COPY_ASCII(size, newText.data(), newText.size());
+    MarkAsEdited(size, 0, static_cast<uint32>(newText.size()));
     size += static_cast<uint32>(newText.size());
     return true;
 }
@@ -274,6 +323,7 @@ bool TextEditor::Add(std::u16string_view newText)
 {
     GROW_TO(newText.size() + size);
     COPY_UNICODE16(size, newText.data(), newText.size());
+    MarkAsEdited(size, 0, static_cast<uint32>(newText.size()));
     size += static_cast<uint32>(newText.size());
     return true;
 }
@@ -281,6 +331,7 @@ bool TextEditor::Set(std::string_view newText)
 {
     GROW_TO(newText.size());
     COPY_ASCII(0, newText.data(), newText.size());
+    MarkAsEdited(0, this->size, static_cast<uint32>(newText.size()));
     this->size = static_cast<uint32>(newText.size());
     return true;
 }
@@ -288,6 +339,7 @@ bool TextEditor::Set(std::u16string_view newText)
 {
     GROW_TO(newText.size());
     COPY_UNICODE16(0, newText.data(), newText.size());
+    MarkAsEdited(0, this->size, static_cast<uint32>(newText.size()));
     this->size = static_cast<uint32>(newText.size());
     return true;
 }
@@ -297,6 +349,7 @@ bool TextEditor::Resize(uint32 newSize, char16 fillChar)
         return true;
     if (newSize < size)
     {
+        MarkAsEdited(newSize, size - newSize, 0);
         size = newSize;
         return true;
     }
@@ -305,11 +358,13 @@ bool TextEditor::Resize(uint32 newSize, char16 fillChar)
     auto* e = this->text + newSize;
     for (; p < e; p++)
         (*p) = fillChar;
+    MarkAsEdited(size, 0, newSize - size);
     size = newSize;
     return true;
 }
 void TextEditor::Clear()
 {
+    MarkAsEdited(0, this->size, 0);
     this->size = 0;
 }
 bool TextEditor::Reserve(uint32 newSize)
@@ -337,6 +392,7 @@ bool TextEditorBuilder::Set(const CharacterBuffer& chars)
         p++;
         ch++;
     }
+    MarkAsEdited(0, this->size, chars.Len());
     this->size = chars.Len();
     return true;
 }
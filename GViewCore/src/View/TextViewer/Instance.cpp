@@ -8,6 +8,7 @@ Config Instance::config;
 
 constexpr int32 CMD_ID_WORD_WRAP     = 0xBF00;
 constexpr uint32 INVALID_LINE_NUMBER = 0xFFFFFFFF;
+constexpr uint32 WRAP_CACHE_MARGIN   = 64; // lines before and after the view port
 
 enum class BulletParserState : uint8
 {
@@ -197,7 +198,7 @@ uint8 GetCharGroup(char16 ch)
 class DataCharacterStream
 {
     GView::Utils::DataCache& dataCache;
-    std::vector<LineInfo>& lines;
+    LineIndex& lines;
     Reference<SettingsData> settings;
     uint32 linesCount;
     uint32 charIndex;
@@ -206,17 +207,19 @@ class DataCharacterStream
     bool ConvertLine(uint32 lineNo)
     {
         CHECK(lineNo < linesCount, false, "");
-        auto buf = dataCache.Get(lines[lineNo].offset, lines[lineNo].size, false);
+        LineInfo li;
+        CHECK(lines.GetLine(lineNo, li), false, "");
+        auto buf = dataCache.Get(li.offset, li.size, false);
         CHECK(tempLine.Create(buf, settings), false, "");
         currentLine = lineNo;
         return true;
     }
 
   public:
-    DataCharacterStream(std::vector<LineInfo>& li, Reference<SettingsData> _settings, GView::Utils::DataCache& cache)
+    DataCharacterStream(LineIndex& li, Reference<SettingsData> _settings, GView::Utils::DataCache& cache)
         : settings(_settings), dataCache(cache), lines(li)
     {
-        linesCount  = static_cast<uint32>(li.size());
+        linesCount  = li.GetLinesCount();
         currentLine = 0;
         charIndex   = 0;
     }
@@ -324,107 +327,27 @@ void Instance::OpenCurrentSelection()
 }
 void Instance::RecomputeLineIndexes()
 {
-    // first --> simple estimation
-    auto buf        = this->obj->GetData().Get(0, 4096, false);
-    auto sz         = this->obj->GetData().GetSize();
-    auto csz        = this->obj->GetData().GetCacheSize() & 0xFFFFFFF0; // make sure that csz is odd
-    auto crlf_count = (uint64) 1;
-
-    for (auto ch : buf)
-        if ((ch == '\n') || (ch == '\r'))
-            crlf_count++;
-
-    auto estimated_count = ((crlf_count * sz) / buf.GetLength()) + 16;
-
-    this->lines.clear();
-    this->lines.reserve(estimated_count);
-
-    uint64 offset    = this->sizeOfBOM;
-    uint64 start     = this->sizeOfBOM;
-    uint32 charCount = 0;
-    char16 lastChar  = 0;
-
-    CharacterEncoding::ExpandedCharacter ch;
-
-    while (offset < sz)
-    {
-        buf = this->obj->GetData().Get(offset, csz, false);
-        if (buf.Empty())
-            return;
-        // process the buffer
-        auto* p       = buf.begin();
-        auto* e       = buf.end();
-        auto* loopEnd = buf.end();
-        if (((offset + buf.GetLength()) < sz) && (buf.GetLength() > 16))
-        {
-            // if this is a partial part of the file and it has more then 16 bytes, deduct 8 bytes to make sure that any possible conversion
-            // will be made
-            loopEnd -= 8;
-        }
-        while (p < loopEnd)
-        {
-            if (ch.FromEncoding(this->settings->encoding, p, e))
-            {
-                p += ch.Length();
-                auto chr = ch.GetChar();
-                if (((chr == '\n') && (lastChar != '\r')) || ((chr == '\r') && (lastChar != '\n')))
-                {
-                    // end of the current line
-                    lines.emplace_back(start, charCount, (uint32) (offset - start));
-                    offset += ch.Length();
-                    start     = offset;
-                    charCount = 0;
-                    lastChar  = chr;
-                    continue;
-                }
-
-                // combined CRLF or LFCR
-                if (((chr == '\n') && (lastChar == '\r')) || ((chr == '\r') && (lastChar == '\n')))
-                {
-                    // just advanced one extra char (no new line found)
-                    offset += ch.Length();
-                    start     = offset;
-                    charCount = 0;
-                    lastChar  = 0; // important as the CRLF or LFCR has ended
-                    continue;
-                }
-
-                // other character
-                lastChar = 0; // don't care
-                charCount++;
-                offset += ch.Length();
-                if (charCount > 2000)
-                {
-                    // limit line to 2000 characters
-                    lines.emplace_back(start, charCount, (uint32) (offset - start));
-                    start     = offset;
-                    charCount = 0;
-                }
-            }
-            else
-            {
-                // need to treat conversion error
-                // consider one character (binary format)
-                charCount++;
-                offset++;
-                p++;
-                if (charCount > 2000)
-                {
-                    // limit line to 2000 characters
-                    lines.emplace_back(start, charCount, (uint32) (offset - start));
-                    start     = offset;
-                    charCount = 0;
-                }
-            }
-        }
-        if (charCount > 0)
-        {
-            // last line
-            lines.emplace_back(start, charCount, (uint32) (offset - start));
-        }
-    }
-
-    auto linesCount = this->lines.size() + 1;
+    // the first part of the file is indexed right away, the rest (for files) in background
+    this->lines.Start(this->obj, this->settings->encoding, this->sizeOfBOM, this->settings->linesPerCheckpoint);
+    this->InvalidateWrapCache(true);
+    this->UpdateLineNumberWidth();
+}
+bool Instance::UpdateLineIndexes()
+{
+    // moves the lines found in background (if any)
+    if (!this->lines.Update())
+        return false;
+    this->UpdateLineNumberWidth();
+    // the view port might not be full yet
+    this->ComputeViewPort(this->ViewPort.Start.lineNo, this->ViewPort.Start.subLineNo, Direction::TopToBottom);
+    this->UpdateViewPort();
+    return true;
+}
+void Instance::UpdateLineNumberWidth()
+{
+    const auto oldWidth = this->lineNumberWidth;
+    // while indexing, the estimated count is used so that the width does not change with every update
+    auto linesCount = static_cast<uint64>(this->lines.GetEstimatedLinesCount()) + 1;
     if (linesCount < 10)
         this->lineNumberWidth = 2;
     else if (linesCount < 100)
@@ -439,22 +362,22 @@ void Instance::RecomputeLineIndexes()
         this->lineNumberWidth = 7;
     else
         this->lineNumberWidth = 8;
+    if (oldWidth != this->lineNumberWidth)
+        this->InvalidateWrapCache(false); // the width available for the text has changed
 }
 bool Instance::GetLineInfo(uint32 lineNo, LineInfo& li)
 {
-    if (lineNo >= this->lines.size())
-        return false;
-    li = this->lines[lineNo];
-    return true;
+    return this->lines.GetLine(lineNo, li);
 }
 LineInfo Instance::GetLineInfo(uint32 lineNo)
 {
-    const auto sz = this->lines.size();
-    if (lineNo < sz)
-        return this->lines[lineNo];
+    LineInfo li;
+    const auto sz = this->lines.GetLinesCount();
+    if (this->lines.GetLine(lineNo, li))
+        return li;
     // if its outside --> always return the last line
-    if (sz > 0)
-        return this->lines[sz - 1];
+    if ((sz > 0) && (this->lines.GetLine(sz - 1, li)))
+        return li;
     // otherwise return an empty line
     return LineInfo(0, 0, 0);
 }
@@ -464,7 +387,7 @@ void Instance::ComputeSubLineIndexes(uint32 lineNo, BufferView& buf, uint64& sta
         return; // we've already computed this --> no need to computed again
 
     LineInfo li            = GetLineInfo(lineNo);
-    uint32 w               = this->GetWidth();
+    uint32 w               = GetWrapWidth();
     uint32 bufPos          = 0;
     uint32 charIndex       = 0;
     bool computeAlignament = true;
@@ -479,10 +402,6 @@ void Instance::ComputeSubLineIndexes(uint32 lineNo, BufferView& buf, uint64& sta
     this->SubLines.lineNo         = lineNo;
     this->SubLines.leftAlignament = 0;
 
-    if ((this->lineNumberWidth + 2) >= w)
-        w = 1;
-    else
-        w -= (this->lineNumberWidth + 2);
     buf = this->obj->GetData().Get(li.offset, li.size, false);
     CharacterStream cs(buf, 0, this->settings.ToReference());
     // process
@@ -562,6 +481,15 @@ void Instance::ComputeSubLineIndexes(uint32 lineNo, BufferView& buf, uint64& sta
             this->SubLines.entries.emplace_back(0, 0, 0, 0);
             this->SubLines.lineNo = INVALID_LINE_NUMBER; // need to recompute
         }
+        else
+        {
+            auto& wl          = this->wrapCache[lineNo];
+            wl.entries        = this->SubLines.entries;
+            wl.leftAlignament = this->SubLines.leftAlignament;
+            wl.width          = w;
+            wl.lineWidth      = wl.entries.size() == 1 ? cs.GetNextXOffset() : 0xFFFFFFFF;
+            wl.wrapMethod     = this->settings->wrapMethod;
+        }
     }
     else
     {
@@ -576,10 +504,47 @@ void Instance::ComputeSubLineIndexes(uint32 lineNo)
 {
     if (lineNo == this->SubLines.lineNo)
         return; // we've already computed this --> no need to computed again
+    if (this->HasWordWrap())
+    {
+        // lines around the view port are kept in the wrap cache
+        const auto it = this->wrapCache.find(lineNo);
+        if ((it != this->wrapCache.end()) && (it->second.IsValidFor(GetWrapWidth(), this->settings->wrapMethod)))
+        {
+            this->SubLines.entries        = it->second.entries;
+            this->SubLines.leftAlignament = it->second.leftAlignament;
+            this->SubLines.lineNo         = lineNo;
+            return;
+        }
+    }
     uint64 startOffset;
     BufferView buf;
     ComputeSubLineIndexes(lineNo, buf, startOffset);
 }
+uint32 Instance::GetWrapWidth()
+{
+    uint32 w = this->GetWidth();
+    if ((this->lineNumberWidth + 2) >= w)
+        return 1;
+    return w - (this->lineNumberWidth + 2);
+}
+void Instance::InvalidateWrapCache(bool all)
+{
+    this->SubLines.lineNo = INVALID_LINE_NUMBER;
+    if (all)
+    {
+        this->wrapCache.clear();
+        return;
+    }
+    // only the lines that would be wrapped differently with the current width are removed
+    const auto w = GetWrapWidth();
+    for (auto it = this->wrapCache.begin(); it != this->wrapCache.end();)
+    {
+        if (it->second.IsValidFor(w, this->settings->wrapMethod))
+            it++;
+        else
+            it = this->wrapCache.erase(it);
+    }
+}
 uint32 Instance::CharacterIndexToSubLineNo(uint32 charIndex)
 {
     // binary search
@@ -631,10 +596,10 @@ void Instance::CommputeViewPort_NoWrap(uint32 lineNo, Direction dir)
     }
 
     ViewPort.Reset();
-    if (this->lines.empty())
+    if (this->lines.GetLinesCount() == 0)
         return;
 
-    uint32 lastLineNo = static_cast<uint32>(this->lines.size() - 1); // lines.size() will alway be bigger than 1
+    uint32 lastLineNo = this->lines.GetLinesCount() - 1; // lines count will alway be bigger than 1
 
     // sets the view port
     ViewPort.Start.lineNo    = start;
@@ -662,7 +627,7 @@ void Instance::CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction
     auto h = (std::min<>(static_cast<uint32>(std::max<>(this->GetHeight(), 1)), MAX_LINES_TO_VIEW));
 
     ViewPort.Reset();
-    if (this->lines.empty())
+    if (this->lines.GetLinesCount() == 0)
         return;
     if (dir == Direction::TopToBottom)
     {
@@ -675,7 +640,7 @@ void Instance::CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction
         auto* l                  = ViewPort.Lines;
         const auto* l_max        = l + h;
 
-        while ((l < l_max) && (start < this->lines.size()))
+        while ((l < l_max) && (start < this->lines.GetLinesCount()))
         {
             auto lineInfo = GetLineInfo(start);
             ComputeSubLineIndexes(start);
@@ -741,6 +706,12 @@ void Instance::CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction
             memmove(ViewPort.Lines, l, ViewPort.linesCount * sizeof(ViewPort.Lines[0]));
         }
     }
+
+    // keep in the wrap cache only the lines from the view port and a margin around it
+    const auto firstLine = ViewPort.Start.lineNo > WRAP_CACHE_MARGIN ? ViewPort.Start.lineNo - WRAP_CACHE_MARGIN : 0U;
+    const auto lastLine  = ViewPort.End.lineNo + std::min<>(WRAP_CACHE_MARGIN, INVALID_LINE_NUMBER - ViewPort.End.lineNo);
+    this->wrapCache.erase(this->wrapCache.begin(), this->wrapCache.lower_bound(firstLine));
+    this->wrapCache.erase(this->wrapCache.upper_bound(lastLine), this->wrapCache.end());
 }
 void Instance::ComputeViewPort(uint32 lineNo, uint32 subLineNo, Direction dir)
 {
@@ -755,14 +726,14 @@ void Instance::MoveTo(uint32 lineNo, uint32 charIndex, bool select)
     if (select)
         sidx = this->selection.BeginSelection(this->Cursor.pos);
     // sanity checks
-    if (this->lines.size() == 0)
+    if (this->lines.GetLinesCount() == 0)
     {
         lineNo = 0;
     }
     else
     {
-        if (lineNo >= static_cast<uint32>(this->lines.size()))
-            lineNo = static_cast<uint32>(this->lines.size() - 1);
+        if (lineNo >= this->lines.GetLinesCount())
+            lineNo = this->lines.GetLinesCount() - 1;
     }
     LineInfo li = GetLineInfo(lineNo);
     if (charIndex >= li.charsCount)
@@ -792,8 +763,8 @@ void Instance::MoveTo(uint32 lineNo, uint32 charIndex, bool select)
 }
 void Instance::MoveToStartOfLine(uint32 lineNo, bool select)
 {
-    if (lineNo >= this->lines.size())
-        MoveToEndOfLine(static_cast<uint32>(this->lines.size() - 1), select); // last position
+    if (lineNo >= this->lines.GetLinesCount())
+        MoveToEndOfLine(this->lines.GetLinesCount() - 1, select); // last position
     else
         MoveTo(lineNo, 0, select);
 }
@@ -807,9 +778,9 @@ void Instance::MoveToEndOfLine(uint32 lineNo, bool select)
 }
 void Instance::MoveToEndOfFile(bool select)
 {
-    if (this->lines.empty())
+    if (this->lines.GetLinesCount() == 0)
         return;
-    MoveTo(static_cast<uint32>(this->lines.size() - 1), 0xFFFFFFFF, select);
+    MoveTo(this->lines.GetLinesCount() - 1, 0xFFFFFFFF, select);
 }
 void Instance::MoveLeft(bool select)
 {
@@ -847,9 +818,9 @@ void Instance::MoveToNextWord(bool select)
 }
 void Instance::MoveDown(uint32 noOfTimes, bool select)
 {
-    if (this->lines.size() == 0)
+    if (this->lines.GetLinesCount() == 0)
         return; // safety check
-    uint32 lastLine = static_cast<uint32>(this->lines.size() - 1);
+    uint32 lastLine = this->lines.GetLinesCount() - 1;
     if (HasWordWrap())
     {
         auto lineNo = this->Cursor.lineNo;
@@ -1255,6 +1226,9 @@ void Instance::Paint(Graphics::Renderer& renderer)
     auto lineNo      = INVALID_LINE_NUMBER;
     const auto focus = this->HasFocus();
 
+    // only while this view is still indexing => the lines found since the last repaint are added
+    if (!this->lines.IsCompleted())
+        this->UpdateLineIndexes();
     if (this->ViewPort.linesCount == 0)
     {
         this->ComputeViewPort(0, 0, Direction::TopToBottom);
@@ -1386,6 +1360,7 @@ void Instance::OnStart()
 }
 void Instance::OnAfterResize(int newWidth, int newHeight)
 {
+    this->InvalidateWrapCache(false);
     this->ComputeViewPort(this->ViewPort.Start.lineNo, this->ViewPort.Start.subLineNo, Direction::TopToBottom);
     this->UpdateViewPort();
 }
@@ -1420,12 +1395,16 @@ bool Instance::OnEvent(Reference<Control>, Event eventType, int ID)
 }
 void Instance::OnUpdateScrollBars()
 {
-    if (this->lines.size() > 0)
+    if (this->lines.GetLinesCount() > 0)
     {
-        const auto& fistLine = this->lines[0];
-        const auto& lastLine = this->lines[this->lines.size() - 1];
-        const auto maxOfs    = lastLine.offset + lastLine.size;
-        auto pos             = std::max<>(this->Cursor.pos, fistLine.offset);
+        // the first line starts after the BOM; while indexing, the scroll bar refers to the whole file
+        auto maxOfs = this->obj->GetData().GetSize();
+        if (this->lines.IsCompleted())
+        {
+            const auto lastLine = GetLineInfo(this->lines.GetLinesCount() - 1);
+            maxOfs              = lastLine.offset + lastLine.size;
+        }
+        auto pos = std::max<>(this->Cursor.pos, static_cast<uint64>(this->sizeOfBOM));
         this->UpdateVScrollBar(std::min<>(pos, maxOfs), maxOfs);
     }
     else
@@ -1437,21 +1416,14 @@ void Instance::SetWrapMethod(WrapMethod method)
 {
     this->settings->wrapMethod = method;
     this->ViewPort.scrollX     = 0;
-    this->SubLines.lineNo      = INVALID_LINE_NUMBER;
+    this->InvalidateWrapCache(true);
     this->ViewPort.Reset();
     this->ComputeViewPort(this->ViewPort.Start.lineNo, this->ViewPort.Start.subLineNo, Direction::TopToBottom);
     this->UpdateViewPort();
 }
 bool Instance::GoTo(uint64 offset)
 {
-    auto lineNo = 0U;
-    for (lineNo = 0U; lineNo < this->lines.size(); lineNo++)
-    {
-        if (offset < this->lines[lineNo].offset)
-            break;
-    }
-    if (lineNo > 0)
-        lineNo--;
+    auto lineNo = this->lines.FindLine(offset);
     auto li     = GetLineInfo(lineNo);
     auto cIndex = 0U;
     CharacterStream cs(this->obj->GetData().Get(li.offset, li.size, false), 0, this->settings.ToReference());
@@ -1470,7 +1442,7 @@ bool Instance::Select(uint64 offset, uint64 size)
 }
 bool Instance::ShowGoToDialog()
 {
-    GoToDialog dlg(this->Cursor.pos, this->obj->GetData().GetSize(), this->Cursor.lineNo + 1U, static_cast<uint32>(this->lines.size()));
+    GoToDialog dlg(this->Cursor.pos, this->obj->GetData().GetSize(), this->Cursor.lineNo + 1U, this->lines.GetLinesCount());
     if (dlg.Show() == Dialogs::Result::Ok)
     {
         if (dlg.ShouldGoToLine())
@@ -1648,6 +1620,12 @@ bool Instance::OnMouseWheel(int x, int y, AppCUI::Input::MouseWheel direction, I
     return false;
 }
 //======================================================================[Cursor information]==================
+std::string_view FormatLinesCount(LocalString<128>& tmp, uint32 lineNo, const LineIndex& lines)
+{
+    if (lines.IsCompleted())
+        return tmp.Format("%d/%d", lineNo, lines.GetLinesCount());
+    return tmp.Format("%d/~%d", lineNo, lines.GetEstimatedLinesCount()); // still indexing
+}
 int Instance::PrintSelectionInfo(uint32 selectionID, int x, int y, uint32 width, Renderer& r)
 {
     uint64 start, end;
@@ -1681,7 +1659,7 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
             xPoz = PrintSelectionInfo(2, xPoz, 0, 16, r);
             xPoz = PrintSelectionInfo(3, xPoz, 0, 16, r);
         }
-        xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", tmp.Format("%d/%d", Cursor.lineNo + 1, (uint32) lines.size()));
+        xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", FormatLinesCount(tmp, Cursor.lineNo + 1, lines));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 10, "Col:", tmp.Format("%d", Cursor.charIndex + 1));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "File ofs: ", tmp.Format("%llu", Cursor.pos));
     }
@@ -1691,7 +1669,7 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
         xPoz = PrintSelectionInfo(2, 0, 1, 16, r);
         PrintSelectionInfo(1, xPoz, 0, 16, r);
         xPoz = PrintSelectionInfo(3, xPoz, 1, 16, r);
-        this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", tmp.Format("%d/%d", Cursor.lineNo + 1, (uint32) lines.size()));
+        this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", FormatLinesCount(tmp, Cursor.lineNo + 1, lines));
         xPoz = this->WriteCursorInfo(r, xPoz, 1, 20, "Col:", tmp.Format("%d", Cursor.charIndex + 1));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "File ofs: ", tmp.Format("%llu", Cursor.pos));
     }
@@ -1707,6 +1685,7 @@ enum class PropertyID : uint32
     HighlightCurrentLine,
     TabSize,
     ShowTabCharacter,
+    LinesPerCheckpoint,
     WrapMethodKey,
 };
 #define BT(t) static_cast<uint32>(t)
@@ -1733,6 +1712,9 @@ bool Instance::GetPropertyValue(uint32 id, PropertyValue& value)
     case PropertyID::ShowTabCharacter:
         value = this->settings->showTabCharacter;
         return true;
+    case PropertyID::LinesPerCheckpoint:
+        value = this->settings->linesPerCheckpoint;
+        return true;
     case PropertyID::WrapMethodKey:
         value = this->config.Keys.WordWrap;
         return true;
@@ -1763,11 +1745,25 @@ bool Instance::SetPropertyValue(uint32 id, const PropertyValue& value, String& e
             return false;
         }
         this->settings->tabSize = uint32Temp;
+        this->InvalidateWrapCache(true);
+        this->ComputeViewPort(this->ViewPort.Start.lineNo, this->ViewPort.Start.subLineNo, Direction::TopToBottom);
         this->UpdateViewPort();
         return true;
     case PropertyID::ShowTabCharacter:
         this->settings->showTabCharacter = std::get<bool>(value);
         return true;
+    case PropertyID::LinesPerCheckpoint:
+        uint32Temp = std::get<uint32>(value);
+        if ((uint32Temp < 1) || (uint32Temp > MAX_LINES_PER_CHECKPOINT))
+        {
+            error.SetFormat("Lines per checkpoint should be between 1 and %u", MAX_LINES_PER_CHECKPOINT);
+            return false;
+        }
+        this->settings->linesPerCheckpoint = uint32Temp;
+        this->RecomputeLineIndexes();
+        this->ViewPort.Reset();
+        this->MoveTo(this->Cursor.lineNo, this->Cursor.charIndex, false);
+        return true;
     case PropertyID::WrapMethodKey:
         config.Keys.WordWrap = std::get<AppCUI::Input::Key>(value);
         return true;
@@ -1796,6 +1792,7 @@ const vector<Property> Instance::GetPropertiesList()
         { BT(PropertyID::HighlightCurrentLine), "General", "Highlight Current line", PropertyType::Boolean },
         { BT(PropertyID::TabSize), "Tabs", "Size", PropertyType::UInt32 },
         { BT(PropertyID::ShowTabCharacter), "Tabs", "Show tab character", PropertyType::Boolean },
+        { BT(PropertyID::LinesPerCheckpoint), "Index", "Lines per checkpoint", PropertyType::UInt32 },
         { BT(PropertyID::Encoding), "Encoding", "Format", PropertyType::List, false, "Binary=0,Ascii=1,UTF-8=2,UTF-16(LE)=3,UTF-16(BE)=4" },
         { BT(PropertyID::HasBOM), "Encoding", "HasBom", PropertyType::Boolean },
         // shortcuts
@@ -0,0 +1,404 @@
+#include "TextViewer.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define TEXT_VIEWER_SSE2
+#    include <emmintrin.h>
+#endif
+
+using namespace GView::View::TextViewer;
+
+constexpr uint32 MAX_LINE_CHARACTERS = 2000;      // longer lines are split
+constexpr uint64 FIRST_SCAN_SIZE     = 0x40000;   // indexed right away (enough for the first screen)
+constexpr uint32 WORKER_CHUNK_SIZE   = 0x100000;
+constexpr uint32 RESCAN_CHUNK_SIZE   = 0x10000;
+
+namespace
+{
+// position of the first byte that is CR, LF or (for UTF-8) the start of a multi-byte character
+size_t FindSpecialCharacter8(const uint8* p, size_t size, bool stopOnNonAscii)
+{
+    size_t i = 0;
+#ifdef TEXT_VIEWER_SSE2
+    const auto lf = _mm_set1_epi8('\n');
+    const auto cr = _mm_set1_epi8('\r');
+    for (; i + 16 <= size; i += 16)
+    {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        auto mask    = static_cast<uint32>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr))));
+        if (stopOnNonAscii)
+            mask |= static_cast<uint32>(_mm_movemask_epi8(v));
+        if (mask != 0)
+            return i + std::countr_zero(mask);
+    }
+#endif
+    for (; i < size; i++)
+    {
+        if ((p[i] == '\n') || (p[i] == '\r') || (stopOnNonAscii && (p[i] >= 0x80)))
+            return i;
+    }
+    return size;
+}
+// same as above for UTF-16 (the result is always even)
+size_t FindSpecialCharacter16(const uint8* p, size_t size, bool bigEndian)
+{
+    size_t i = 0;
+    size &= ~static_cast<size_t>(1);
+#ifdef TEXT_VIEWER_SSE2
+    const auto lf = _mm_set1_epi16(bigEndian ? 0x0A00 : 0x000A);
+    const auto cr = _mm_set1_epi16(bigEndian ? 0x0D00 : 0x000D);
+    for (; i + 16 <= size; i += 16)
+    {
+        const auto v    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const auto mask = static_cast<uint32>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi16(v, lf), _mm_cmpeq_epi16(v, cr))));
+        if (mask != 0)
+            return i + std::countr_zero(mask);
+    }
+#endif
+    for (; i < size; i += 2)
+    {
+        const auto ch = bigEndian ? p[i + 1] | (p[i] << 8) : p[i] | (p[i + 1] << 8);
+        if ((ch == '\n') || (ch == '\r'))
+            return i;
+    }
+    return size;
+}
+} // namespace
+
+//======================================================================[LineScanner]==================
+void LineScanner::Init(CharacterEncoding::Encoding _encoding, LineCheckpoint from)
+{
+    this->encoding           = _encoding;
+    this->offset             = from.GetOffset();
+    this->start              = this->offset;
+    this->linesCount         = 0;
+    this->charCount          = 0;
+    this->lastChar           = from.GetLastChar();
+    this->linesPerCheckpoint = 0;
+    this->linesLimit         = 0xFFFFFFFFFFFFFFFFULL;
+    this->lines              = nullptr;
+    this->checkpoints        = nullptr;
+}
+void LineScanner::SetOutput(std::vector<LineInfo>* _lines, std::vector<LineCheckpoint>* _checkpoints, uint32 _linesPerCheckpoint)
+{
+    this->lines              = _lines;
+    this->checkpoints        = _checkpoints;
+    this->linesPerCheckpoint = std::max<>(1U, _linesPerCheckpoint);
+}
+void LineScanner::EndLine(uint32 separatorSize, char16 newLastChar)
+{
+    if (this->lines)
+        this->lines->emplace_back(this->start, this->charCount, (uint32) (this->offset - this->start));
+    this->offset += separatorSize;
+    this->start     = this->offset;
+    this->charCount = 0;
+    this->lastChar  = newLastChar;
+    this->linesCount++;
+    if ((this->checkpoints) && ((this->linesCount % this->linesPerCheckpoint) == 0))
+        this->checkpoints->emplace_back(this->offset, this->lastChar);
+}
+void LineScanner::AddCharacters(size_t count, uint32 unitSize)
+{
+    // characters that are not CR or LF (one unit each)
+    this->lastChar = 0;
+    while (count > 0)
+    {
+        const auto n = std::min<size_t>(count, MAX_LINE_CHARACTERS + 1 - this->charCount);
+        this->charCount += static_cast<uint32>(n);
+        this->offset += n * unitSize;
+        count -= n;
+        if (this->charCount > MAX_LINE_CHARACTERS)
+            EndLine(0, 0);
+    }
+}
+size_t LineScanner::Scan(const uint8* data, size_t size, bool lastChunk)
+{
+    const auto unicode16 = (encoding == CharacterEncoding::Encoding::Unicode16LE) || (encoding == CharacterEncoding::Encoding::Unicode16BE);
+    const auto unitSize  = unicode16 ? 2U : 1U;
+    const auto* p        = data;
+    const auto* e        = data + size;
+    const auto* loopEnd  = e;
+    if ((!lastChunk) && (size > 16))
+    {
+        // deduct 8 bytes to make sure that the last character is not split between two chunks
+        loopEnd -= 8;
+    }
+
+    CharacterEncoding::ExpandedCharacter ch;
+    while ((p < loopEnd) && (linesCount < linesLimit))
+    {
+        // plain characters are counted in bulk, only CR, LF and multi-byte characters are decoded
+        const auto left = static_cast<size_t>(loopEnd - p);
+        const auto run  = unicode16 ? FindSpecialCharacter16(p, left, encoding == CharacterEncoding::Encoding::Unicode16BE)
+                                    : FindSpecialCharacter8(p, left, encoding == CharacterEncoding::Encoding::UTF8);
+        if (run > 0)
+        {
+            AddCharacters(run / unitSize, unitSize);
+            p += run;
+            continue;
+        }
+
+        if (ch.FromEncoding(this->encoding, p, e))
+        {
+            p += ch.Length();
+            auto chr = ch.GetChar();
+            if (((chr == '\n') && (lastChar != '\r')) || ((chr == '\r') && (lastChar != '\n')))
+            {
+                // end of the current line
+                EndLine(ch.Length(), chr);
+                continue;
+            }
+
+            // combined CRLF or LFCR
+            if (((chr == '\n') && (lastChar == '\r')) || ((chr == '\r') && (lastChar == '\n')))
+            {
+                // just advanced one extra char (no new line found)
+                offset += ch.Length();
+                start     = offset;
+                charCount = 0;
+                lastChar  = 0; // important as the CRLF or LFCR has ended
+                continue;
+            }
+
+            // other character
+            lastChar = 0; // don't care
+            charCount++;
+            offset += ch.Length();
+        }
+        else
+        {
+            // need to treat conversion error
+            // consider one character (binary format)
+            charCount++;
+            offset++;
+            p++;
+        }
+        if (charCount > MAX_LINE_CHARACTERS)
+            EndLine(0, lastChar);
+    }
+    return static_cast<size_t>(p - data);
+}
+void LineScanner::Finish()
+{
+    if (charCount > 0)
+    {
+        // last line (there is no line after it => no checkpoint is needed)
+        const auto output = this->checkpoints;
+        this->checkpoints = nullptr;
+        EndLine(0, 0);
+        this->checkpoints = output;
+    }
+}
+
+//======================================================================[LineIndex]==================
+LineIndex::LineIndex()
+    : blocksUseCount(0), linesCount(0), linesPerCheckpoint(1), size(0), indexedSize(0), completed(true), foundLinesCount(0), foundSize(0),
+      foundCompleted(true)
+{
+    encoding = CharacterEncoding::Encoding::Binary;
+    for (auto& b : blocks)
+    {
+        b.index    = NO_BLOCK;
+        b.lastUsed = 0;
+    }
+}
+LineIndex::~LineIndex()
+{
+    Stop();
+}
+void LineIndex::Start(Reference<GView::Object> _obj, CharacterEncoding::Encoding _encoding, uint64 startOffset, uint32 _linesPerCheckpoint)
+{
+    Stop();
+
+    this->obj                = _obj;
+    this->encoding           = _encoding;
+    this->linesPerCheckpoint = std::max<>(1U, _linesPerCheckpoint);
+    this->linesCount         = 0;
+    this->completed          = false;
+    this->indexedSize        = 0;
+    this->checkpoints.clear();
+    this->checkpoints.emplace_back(startOffset, 0);
+    this->found.clear();
+    for (auto& b : blocks)
+    {
+        b.lines.clear();
+        b.index    = NO_BLOCK;
+        b.lastUsed = 0;
+    }
+
+    auto& cache    = obj->GetData();
+    const auto csz = cache.GetCacheSize() & 0xFFFFFFF0;
+    this->size     = cache.GetSize();
+    this->scanner.Init(encoding, this->checkpoints[0]);
+    this->scanner.SetOutput(nullptr, &this->checkpoints, this->linesPerCheckpoint);
+
+    // the caches of the objects are used by the views => only files (that can be opened again) are indexed in the background
+    const auto background = obj->GetObjectType() == Object::Type::File;
+
+    // the first part is indexed right away so that the first screen can be drawn
+    while (scanner.GetOffset() < this->size)
+    {
+        if ((background) && (scanner.GetOffset() >= FIRST_SCAN_SIZE))
+        {
+            this->linesCount      = scanner.GetLinesCount();
+            this->indexedSize     = scanner.GetOffset();
+            this->foundLinesCount = this->linesCount;
+            this->foundSize       = this->indexedSize;
+            this->foundCompleted  = false;
+            this->path            = obj->GetPath();
+            this->stopRequested   = false;
+            this->worker          = std::thread([this]() { Build(); });
+            return;
+        }
+        auto buf = cache.Get(scanner.GetOffset(), csz, false);
+        if (buf.Empty())
+            break;
+        scanner.Scan(buf.GetData(), buf.GetLength(), scanner.GetOffset() + buf.GetLength() >= this->size);
+    }
+    scanner.Finish();
+    this->linesCount  = scanner.GetLinesCount();
+    this->indexedSize = this->size;
+    this->completed   = true;
+}
+void LineIndex::Stop()
+{
+    stopRequested = true;
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+}
+void LineIndex::Build()
+{
+    AppCUI::OS::File file;
+    std::vector<uint8> buffer(WORKER_CHUNK_SIZE);
+    std::vector<LineCheckpoint> newCheckpoints;
+    auto ok = file.OpenRead(std::filesystem::path(path));
+
+    scanner.SetOutput(nullptr, &newCheckpoints, linesPerCheckpoint);
+    while ((ok) && (scanner.GetOffset() < size) && (!stopRequested))
+    {
+        const auto offset = scanner.GetOffset();
+        const auto length = static_cast<uint32>(std::min<uint64>(WORKER_CHUNK_SIZE, size - offset));
+        ok                = file.SetCurrentPos(offset) && file.Read(buffer.data(), length);
+        if (!ok)
+            break;
+        const auto lastChunk = offset + length == size;
+        scanner.Scan(buffer.data(), length, lastChunk);
+        if (lastChunk)
+            scanner.Finish();
+
+        std::lock_guard<std::mutex> guard(lock);
+        found.insert(found.end(), newCheckpoints.begin(), newCheckpoints.end());
+        foundLinesCount = scanner.GetLinesCount();
+        foundSize       = scanner.GetOffset();
+        foundCompleted  = lastChunk;
+        newCheckpoints.clear();
+    }
+    file.Close();
+
+    if (!ok)
+    {
+        // the rest of the file can not be read => keep what was indexed so far
+        scanner.Finish();
+        std::lock_guard<std::mutex> guard(lock);
+        found.insert(found.end(), newCheckpoints.begin(), newCheckpoints.end());
+        foundLinesCount = scanner.GetLinesCount();
+        foundCompleted  = true;
+    }
+}
+bool LineIndex::Update()
+{
+    if (this->completed)
+        return false;
+
+    std::lock_guard<std::mutex> guard(lock);
+    if ((found.empty()) && (foundSize == indexedSize) && (!foundCompleted))
+        return false;
+    checkpoints.insert(checkpoints.end(), found.begin(), found.end());
+    found.clear();
+    linesCount  = foundLinesCount;
+    indexedSize = foundCompleted ? size : foundSize;
+    completed   = foundCompleted;
+    return true;
+}
+const LineIndex::Block* LineIndex::GetBlock(uint32 index)
+{
+    const auto first    = static_cast<uint64>(index) * linesPerCheckpoint;
+    const auto expected = static_cast<size_t>(std::min<uint64>(linesPerCheckpoint, linesCount - first));
+
+    // recently used blocks (a block computed while indexing might be incomplete)
+    auto* result = blocks;
+    for (auto& b : blocks)
+    {
+        if (b.index == index)
+        {
+            result = &b;
+            break;
+        }
+        if (b.lastUsed < result->lastUsed)
+            result = &b;
+    }
+    result->lastUsed = ++blocksUseCount;
+    if ((result->index == index) && (result->lines.size() >= expected))
+        return result;
+
+    // rescan from the checkpoint
+    result->index = index;
+    result->lines.clear();
+    LineScanner s;
+    s.Init(encoding, checkpoints[index]);
+    s.SetOutput(&result->lines, nullptr, 0);
+    s.SetLinesLimit(expected);
+    auto& cache = obj->GetData();
+    while ((result->lines.size() < expected) && (s.GetOffset() < size))
+    {
+        auto buf = cache.Get(s.GetOffset(), RESCAN_CHUNK_SIZE, false);
+        if (buf.Empty())
+            break;
+        const auto lastChunk = s.GetOffset() + buf.GetLength() >= size;
+        s.Scan(buf.GetData(), buf.GetLength(), lastChunk);
+        if (lastChunk)
+            s.Finish();
+    }
+    if (result->lines.size() > expected)
+        result->lines.resize(expected);
+    return result;
+}
+bool LineIndex::GetLine(uint32 lineNo, LineInfo& li)
+{
+    if (lineNo >= linesCount)
+        return false;
+    const auto* b = GetBlock(lineNo / linesPerCheckpoint);
+    const auto i  = lineNo % linesPerCheckpoint;
+    if (i >= b->lines.size())
+        return false;
+    li = b->lines[i];
+    return true;
+}
+uint32 LineIndex::GetEstimatedLinesCount() const
+{
+    if ((completed) || (indexedSize == 0))
+        return GetLinesCount();
+    return static_cast<uint32>(std::min<uint64>(std::max<uint64>(linesCount, (linesCount * size) / indexedSize), 0xFFFFFFFF));
+}
+uint32 LineIndex::FindLine(uint64 offset)
+{
+    // the last line that starts before (or at) offset
+    if (linesCount == 0)
+        return 0;
+    auto it    = std::partition_point(checkpoints.begin(), checkpoints.end(), [offset](const LineCheckpoint& c) { return c.GetOffset() <= offset; });
+    auto index = it == checkpoints.begin() ? 0U : static_cast<uint32>((it - checkpoints.begin()) - 1);
+    index      = std::min<>(index, static_cast<uint32>((linesCount - 1) / linesPerCheckpoint));
+
+    const auto* b = GetBlock(index);
+    auto li       = std::partition_point(b->lines.begin(), b->lines.end(), [offset](const LineInfo& l) { return l.offset <= offset; });
+    if (li == b->lines.begin())
+    {
+        // the checkpoint can be placed before the LF of a CRLF (the first line of the block starts after it)
+        return index > 0 ? index * linesPerCheckpoint - 1 : 0;
+    }
+    return static_cast<uint32>(index * linesPerCheckpoint + ((li - b->lines.begin()) - 1));
+}
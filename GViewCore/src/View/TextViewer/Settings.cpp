@@ -9,6 +9,7 @@ SettingsData::SettingsData()
     this->wrapMethod           = WrapMethod::Bullets;
     this->highlightCurrentLine = true;
     this->showTabCharacter     = false;
+    this->linesPerCheckpoint   = 32;
     this->encoding             = CharacterEncoding::Encoding::Binary;
 }
 Settings::Settings()
@@ -29,6 +30,10 @@ void Settings::ShowTabCharacter(bool show)
 {
     reinterpret_cast<SettingsData*>(this->data)->showTabCharacter = show;
 }
+void Settings::SetLinesPerCheckpoint(uint32 count)
+{
+    reinterpret_cast<SettingsData*>(this->data)->linesPerCheckpoint = std::min<>(std::max<>(1U, count), MAX_LINES_PER_CHECKPOINT);
+}
 void Settings::HightlightCurrentLine(bool highlight)
 {
     reinterpret_cast<SettingsData*>(this->data)->highlightCurrentLine = highlight;
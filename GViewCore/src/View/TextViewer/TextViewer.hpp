@@ -2,6 +2,11 @@
 
 #include "Internal.hpp"
 
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+
 namespace GView
 {
 namespace View
@@ -11,8 +16,9 @@ namespace View
         using namespace AppCUI;
         using namespace GView::Utils;
 
-        constexpr uint32 MAX_CHARACTERS_PER_LINE = 1024;
-        constexpr uint32 MAX_LINES_TO_VIEW       = 256;
+        constexpr uint32 MAX_CHARACTERS_PER_LINE  = 1024;
+        constexpr uint32 MAX_LINES_TO_VIEW        = 256;
+        constexpr uint32 MAX_LINES_PER_CHECKPOINT = 4096;
 
         struct SettingsData
         {
@@ -22,6 +28,7 @@ namespace View
             WrapMethod wrapMethod;
             bool highlightCurrentLine;
             bool showTabCharacter;
+            uint32 linesPerCheckpoint;
             SettingsData();
         };
 
@@ -48,6 +55,132 @@ namespace View
             {
             }
         };
+        // the start of a line + the CR or LF before it (that can still be combined with the next character into CRLF / LFCR)
+        struct LineCheckpoint
+        {
+            static constexpr uint64 OFFSET_MASK = 0x3FFFFFFFFFFFFFFFULL;
+            uint64 value;
+
+            LineCheckpoint()
+            {
+            }
+            LineCheckpoint(uint64 offset, char16 lastChar)
+                : value(offset | (lastChar == '\n' ? (1ULL << 62) : (lastChar == '\r' ? (2ULL << 62) : 0ULL)))
+            {
+            }
+            inline uint64 GetOffset() const
+            {
+                return value & OFFSET_MASK;
+            }
+            inline char16 GetLastChar() const
+            {
+                switch (value >> 62)
+                {
+                case 1:
+                    return '\n';
+                case 2:
+                    return '\r';
+                default:
+                    return 0;
+                }
+            }
+        };
+        class LineScanner
+        {
+            CharacterEncoding::Encoding encoding;
+            uint64 offset;
+            uint64 start;
+            uint64 linesCount;
+            uint64 linesLimit;
+            uint32 charCount;
+            uint32 linesPerCheckpoint;
+            char16 lastChar;
+            std::vector<LineInfo>* lines;
+            std::vector<LineCheckpoint>* checkpoints;
+
+            void AddCharacters(size_t count, uint32 unitSize);
+            void EndLine(uint32 separatorSize, char16 newLastChar);
+
+          public:
+            void Init(CharacterEncoding::Encoding encoding, LineCheckpoint from);
+            // found lines are added to `lines` and the start of every `linesPerCheckpoint`-th line to `checkpoints` (if not null)
+            void SetOutput(std::vector<LineInfo>* lines, std::vector<LineCheckpoint>* checkpoints, uint32 linesPerCheckpoint);
+            // data starts at GetOffset(); returns how many bytes were used (the rest must be given again with the next chunk)
+            size_t Scan(const uint8* data, size_t size, bool lastChunk);
+            void Finish();
+            // Scan stops once `count` lines were found
+            inline void SetLinesLimit(uint64 count)
+            {
+                linesLimit = count;
+            }
+            inline uint64 GetOffset() const
+            {
+                return offset;
+            }
+            inline uint64 GetLinesCount() const
+            {
+                return linesCount;
+            }
+        };
+        class LineIndex
+        {
+            static constexpr uint32 CACHED_BLOCKS = 16;
+            static constexpr uint32 NO_BLOCK      = 0xFFFFFFFF;
+
+            // the lines between two checkpoints (computed on demand, the least recently used one is replaced)
+            struct Block
+            {
+                std::vector<LineInfo> lines;
+                uint32 index;
+                uint64 lastUsed;
+            };
+
+            // only used by the UI thread
+            Reference<GView::Object> obj;
+            CharacterEncoding::Encoding encoding;
+            std::vector<LineCheckpoint> checkpoints; // checkpoints[i] is the start of line i * linesPerCheckpoint
+            Block blocks[CACHED_BLOCKS];
+            uint64 blocksUseCount;
+            uint64 linesCount;
+            uint32 linesPerCheckpoint;
+            LineScanner scanner;
+            uint64 size;
+            uint64 indexedSize;
+            bool completed;
+
+            // found by the worker and not yet moved into `checkpoints`
+            std::vector<LineCheckpoint> found;
+            uint64 foundLinesCount;
+            uint64 foundSize;
+            bool foundCompleted;
+            std::u16string path;
+            std::thread worker;
+            std::mutex lock;
+            std::atomic<bool> stopRequested{ false };
+
+            void Build();
+            const Block* GetBlock(uint32 index);
+
+          public:
+            LineIndex();
+            ~LineIndex();
+
+            void Start(Reference<GView::Object> obj, CharacterEncoding::Encoding encoding, uint64 startOffset, uint32 linesPerCheckpoint);
+            void Stop();
+            bool Update();
+
+            bool GetLine(uint32 lineNo, LineInfo& li);
+            uint32 FindLine(uint64 offset);
+            uint32 GetEstimatedLinesCount() const;
+            inline uint32 GetLinesCount() const
+            {
+                return static_cast<uint32>(std::min<uint64>(linesCount, 0xFFFFFFFF));
+            }
+            inline bool IsCompleted() const
+            {
+                return completed;
+            }
+        };
         struct SubLineInfo
         {
             uint32 relativeOffset;
@@ -59,6 +192,21 @@ namespace View
             {
             }
         };
+        // the sub-lines of a line for a width and a wrap method
+        struct WrappedLineInfo
+        {
+            std::vector<SubLineInfo> entries;
+            uint32 leftAlignament;
+            uint32 width;
+            uint32 lineWidth; // the width of the line when it is not wrapped (only for lines with one sub-line)
+            WrapMethod wrapMethod;
+
+            inline bool IsValidFor(uint32 w, WrapMethod method) const
+            {
+                // a line that was not wrapped stays the same as long as it fits
+                return (method == wrapMethod) && ((w == width) || (lineWidth <= w));
+            }
+        };
         class Instance : public View::ViewControl
         {
             enum class Direction
@@ -72,7 +220,7 @@ namespace View
                 Text,
                 Border
             };
-            std::vector<LineInfo> lines;      
+            LineIndex lines;
             Utils::Selection selection;
             Pointer<SettingsData> settings;
             Reference<GView::Object> obj;
@@ -88,6 +236,7 @@ namespace View
                 uint32 lineNo;
                 uint32 leftAlignament;
             } SubLines;
+            std::map<uint32, WrappedLineInfo> wrapCache;
             struct
             {
                 uint64 pos;
@@ -125,6 +274,8 @@ namespace View
             void OpenCurrentSelection();
 
             void RecomputeLineIndexes();
+            bool UpdateLineIndexes();
+            void UpdateLineNumberWidth();
             void CommputeViewPort_NoWrap(uint32 lineNo, Direction dir);
             void CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction dir);
             void ComputeViewPort(uint32 lineNo, uint32 subLineNo, Direction dir);
@@ -134,6 +285,8 @@ namespace View
             void ComputeSubLineIndexes(uint32 lineNo, BufferView& buf, uint64& startOffset);
             void ComputeSubLineIndexes(uint32 lineNo);
             uint32 CharacterIndexToSubLineNo(uint32 charIndex);
+            uint32 GetWrapWidth();
+            void InvalidateWrapCache(bool all);
             
             void DrawLine(uint32 viewDataIndex, Graphics::Renderer& renderer, ControlState state, bool showLineNumber);
 
@@ -3,6 +3,7 @@
 #include "GView.hpp"
 
 #include <set>
+#include <unordered_map>
 #include <span>
 #include <array>
 #include <filesystem>
@@ -282,6 +283,11 @@ namespace Utils
     };
 } // namespace Utils
 
+namespace App
+{
+    class PluginRegistry;
+}
+
 namespace Generic
 {
     constexpr uint32 MAX_PLUGINS_COMMANDS = 8;
@@ -301,6 +307,8 @@ namespace Generic
         bool Init(AppCUI::Utils::IniSection section);
         void UpdateCommandBar(AppCUI::Application::CommandBar& commandBar, uint32 commandID);
         void Run(uint32 commandIndex, Reference<GView::Object> currentObject);
+
+        friend class App::PluginRegistry;
     };
 }; // namespace Generic
 
@@ -359,10 +367,18 @@ namespace Type
                 return std::span<uint32>(this->Lines.offsets, static_cast<size_t>(this->Lines.count));
             }
         };
+        enum class Kind : uint8
+        {
+            Magic,
+            StartsWith,
+            LineStartsWith
+        };
         struct Interface
         {
+            virtual ~Interface()                                                = default;
             virtual bool Init(std::string_view text)                            = 0;
             virtual bool Match(AppCUI::Utils::BufferView buf, TextParser& text) = 0;
+            virtual Kind GetKind() const                                        = 0;
         };
         class MagicMatcher : public Interface
         {
@@ -381,6 +397,15 @@ namespace Type
             }
             virtual bool Init(std::string_view text) override;
             virtual bool Match(AppCUI::Utils::BufferView buf, TextParser& text) override;
+            virtual Kind GetKind() const override
+            {
+                return Kind::Magic;
+            }
+            bool Init(AppCUI::Utils::BufferView bytes);
+            inline AppCUI::Utils::BufferView GetValue() const
+            {
+                return { u8, count };
+            }
         };
         class StartsWithMatcher : public Interface
         {
@@ -389,6 +414,14 @@ namespace Type
           public:
             virtual bool Init(std::string_view text) override;
             virtual bool Match(AppCUI::Utils::BufferView buf, TextParser& text) override;
+            virtual Kind GetKind() const override
+            {
+                return Kind::StartsWith;
+            }
+            inline std::string_view GetValue() const
+            {
+                return value;
+            }
         };
         class LineStartsWithMatcher : public Interface
         {
@@ -398,8 +431,17 @@ namespace Type
           public:
             virtual bool Init(std::string_view text) override;
             virtual bool Match(AppCUI::Utils::BufferView buf, TextParser& text) override;
+            virtual Kind GetKind() const override
+            {
+                return Kind::LineStartsWith;
+            }
+            inline std::string_view GetValue() const
+            {
+                return value;
+            }
         };
         Interface* CreateFromString(std::string_view stringRepresentation);
+        Interface* Create(Kind kind, AppCUI::Utils::BufferView value);
     } // namespace Matcher
 
     struct PluginCommand
@@ -423,6 +465,8 @@ namespace Type
         bool (*fnValidate)(const AppCUI::Utils::BufferView& buf, const std::string_view& extension);
         TypeInterface* (*fnCreateInstance)();
         bool (*fnPopulateWindow)(Reference<GView::View::WindowInterface> win);
+        bool (*fnUpdate)(Reference<GView::Object> obj); // optional (parse an object without a window)
+        const char* (*fnUpdateScope)();                 // optional (what `Update` checks, if it is less than the structure)
 
         bool LoadPlugin();
 
@@ -433,8 +477,19 @@ namespace Type
         bool MatchExtension(uint64 extensionHash);
         bool MatchContent(AppCUI::Utils::BufferView buf, Matcher::TextParser& textParser);
         bool IsOfType(AppCUI::Utils::BufferView buf, GView::Type::Matcher::TextParser& textParser, const std::string_view& extension = "");
+        bool Load();
+        bool Validate(AppCUI::Utils::BufferView buf, const std::string_view& extension = "") const;
         bool PopulateWindow(Reference<GView::View::WindowInterface> win) const;
         TypeInterface* CreateInstance() const;
+        bool Update(Reference<GView::Object> obj) const;
+        inline bool CanUpdate() const
+        {
+            return fnUpdate != nullptr;
+        }
+        inline std::string_view GetUpdateScope() const
+        {
+            return fnUpdateScope ? fnUpdateScope() : "structure";
+        }
         inline bool operator<(const Plugin& plugin) const
         {
             return priority > plugin.priority;
@@ -451,14 +506,81 @@ namespace Type
         {
             return commands;
         }
+        void GetPatterns(std::vector<Matcher::Interface*>& list) const;
+        void GetExtensions(std::vector<uint64>& list) const;
 
         static uint64 ExtensionToHash(std::string_view ext);
         static uint64 ExtensionToHash(std::u16string_view ext);
+        static std::filesystem::path GetPluginPath(std::string_view name);
+
+        friend class App::PluginRegistry;
+    };
+
+    // Maps an extension hash or the first bytes / lines of a buffer to the (few) type plugins that could match them.
+    // Built once (after plugins are sorted) so that identifying a file does not require asking every plugin.
+    // Candidates are returned as indexes in the plugins vector, in priority order.
+    class DispatchIndex
+    {
+        template <typename T>
+        class PrefixTrie
+        {
+            struct Node
+            {
+                std::vector<std::pair<T, uint32>> children;
+                std::vector<uint32> plugins;
+            };
+            std::vector<Node> nodes;
+
+          public:
+            PrefixTrie();
+            void Clear();
+            void Add(const T* key, size_t size, uint32 pluginIndex);
+            void Find(const T* data, size_t size, std::vector<uint32>& result) const;
+        };
+
+        std::unordered_map<uint64, std::vector<uint32>> extensions;
+        PrefixTrie<uint8> magics;
+        PrefixTrie<char16> textStarts;
+        PrefixTrie<char16> lineStarts;
+        std::vector<uint32> unindexed;
+
+      public:
+        void Build(const std::vector<Plugin>& plugins);
+        std::span<const uint32> GetExtensionCandidates(uint64 extensionHash) const;
+        void GetContentCandidates(AppCUI::Utils::BufferView buf, Matcher::TextParser& textParser, std::vector<uint32>& candidates) const;
     };
 } // namespace Type
 
 namespace App
 {
+    // Binary snapshot of the plugins section from the configuration file (pre-parsed matchers, extension hashes and
+    // commands). It is saved next to the configuration file and it is valid as long as neither the plugin sections of
+    // the configuration file (their content is hashed) nor any of the referenced plugin libraries (size and last write
+    // time are checked) change.
+    class PluginRegistry
+    {
+        static bool Read(
+              AppCUI::Utils::BufferView content,
+              const std::filesystem::path& settingsPath,
+              std::vector<Type::Plugin>& types,
+              std::vector<Generic::Plugin>& generics,
+              uint32& cacheSize);
+        static void ReleaseMatchers(std::vector<Type::Plugin>& typePlugins);
+
+      public:
+        static std::filesystem::path GetPath(const std::filesystem::path& settingsPath);
+        static bool Load(
+              const std::filesystem::path& settingsPath,
+              std::vector<Type::Plugin>& typePlugins,
+              std::vector<Generic::Plugin>& genericPlugins,
+              uint32& cacheSize);
+        static bool Save(
+              const std::filesystem::path& settingsPath,
+              const std::vector<Type::Plugin>& typePlugins,
+              const std::vector<Generic::Plugin>& genericPlugins,
+              uint32 cacheSize);
+    };
+
     namespace MenuCommands
     {
         constexpr int ARRANGE_VERTICALLY       = 100000;
@@ -514,6 +636,23 @@ namespace App
         };
     }
 
+    // a cached identification is reused only if the prefix has the same SHA-256 (a 64 bit hash alone could collide)
+    struct IdentificationKey {
+        std::array<uint8, 32> digest;
+        uint64 extensionHash;
+        OpenMethod method;
+
+        bool operator==(const IdentificationKey& other) const = default;
+    };
+    struct IdentificationKeyHash {
+        size_t operator()(const IdentificationKey& key) const
+        {
+            uint64 value;
+            memcpy(&value, key.digest.data(), sizeof(value));
+            return static_cast<size_t>(value ^ key.extensionHash);
+        }
+    };
+
     class Instance : public AppCUI::Utils::PropertiesInterface,
                      public AppCUI::Controls::Handlers::OnEventInterface,
                      public AppCUI::Controls::Handlers::OnStartInterface
@@ -523,6 +662,9 @@ namespace App
         AppCUI::Controls::Menu* mnuFile;
         AppCUI::Controls::Menu* mnuOptions;
         std::vector<GView::Type::Plugin> typePlugins;
+        GView::Type::DispatchIndex typePluginsIndex;
+        std::vector<TypePluginStats> typePluginsStats;
+        std::unordered_map<IdentificationKey, std::vector<uint32>, IdentificationKeyHash> identificationCache;
         std::vector<GView::Generic::Plugin> genericPlugins;
         GView::Type::Plugin defaultPlugin;
         GView::Utils::ErrorList errList;
@@ -530,7 +672,9 @@ namespace App
         std::filesystem::path lastOpenedFolderLocation;
 
         bool BuildMainMenus();
-        bool LoadSettings();
+        bool LoadSettings(AppCUI::Utils::IniObject* ini);
+        bool LoadPlugins(AppCUI::Utils::IniObject* ini);
+        void IndexTypePlugins();
         void OpenFile();
         void OpenFolder();
         void ShowErrors();
@@ -539,6 +683,10 @@ namespace App
         void ShowChangeThemeWindow();
         void ShowRestrictedModeWindow();
 
+        bool ValidateTypePlugin(uint32 index, AppCUI::Utils::BufferView buf, std::string_view extension);
+        void ValidateTypePlugins(const std::vector<uint32>& candidates, AppCUI::Utils::BufferView buf, std::vector<bool>& results);
+        const std::vector<uint32>* FindIdentification(const IdentificationKey& key);
+        const std::vector<uint32>* AddIdentification(const IdentificationKey& key, std::vector<uint32> matches);
         Reference<Type::Plugin> IdentifyTypePlugin_FirstMatch(
               const std::string_view& extension,
               AppCUI::Utils::BufferView buf,
@@ -593,6 +741,8 @@ namespace App
         Instance();
         virtual ~Instance() {}
         bool Init(bool isTestingEnabled);
+        bool InitHeadless();
+        bool Scan(const std::vector<std::filesystem::path>& paths, const ScanSettings& settings);
         bool AddFileWindow(
               const std::filesystem::path& path,
               OpenMethod method,
@@ -641,6 +791,7 @@ namespace App
         uint32 GetTypePluginsCount();
         std::string_view GetTypePluginName(uint32 index);
         std::string_view GetTypePluginDescription(uint32 index);
+        bool GetTypePluginStats(uint32 index, TypePluginStats& stats);
     };
 
     class SelectTypeDialog : public Window
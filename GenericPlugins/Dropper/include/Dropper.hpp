@@ -15,6 +15,7 @@
 #include "Images.hpp"
 #include "Archives.hpp"
 #include "Cryptographic.hpp"
+#include "PrintableRuns.hpp"
 
 using namespace GView::Utils;
 using namespace GView::GenericPlugins::Droppper::SpecialStrings;
@@ -77,6 +78,18 @@ class Instance
     bool ProcessBinaryDataCharset(std::string_view include, std::string_view exclude);
     bool FillCharSetMatrix(bool binaryCharSetMatrix[BINARY_CHARSET_MATRIX_SIZE], std::string_view s, bool value);
 
+    void CheckDroppers(
+          std::vector<std::unique_ptr<IDrop>*>& droppers,
+          uint64 offset,
+          BufferView buffer,
+          bool recursive,
+          ArtefactIdentificationCallback identify,
+          uint64& nextOffset);
+    bool ProcessRunStarts(std::vector<std::unique_ptr<IDrop>*>& droppers, uint64 offset, uint64 size, bool recursive, ArtefactIdentificationCallback identify);
+    bool ProcessRun(
+          std::vector<std::unique_ptr<IDrop>*>& droppers, uint64 start, uint64 size, bool recursive, ArtefactIdentificationCallback identify, uint64& nextOffset);
+    uint64 FindRunEnd(uint64 offset, uint64 size, bool isUnicode);
+
   public:
     Instance() = default;
 
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Constants.hpp"
+
+#include <vector>
+#include <string>
+
+namespace GView::GenericPlugins::Droppper
+{
+/*
+ * Classifies a stream of bytes (64 at a time) into printable / space / zero bitmasks and reports the offsets where an
+ * ASCII or UTF-16LE printable run starts. Only these offsets are relevant for the text & special strings droppers so the
+ * rest of the data (binary garbage or the inside of an already started run) never reaches a dropper.
+ *
+ * A run start is the first non-space printable character after a non printable one (or after a space). For UTF-16LE
+ * text ("a\0b\0c\0") only the first code unit is reported, the following ones being considered part of the same run.
+ */
+class PrintableRunScanner
+{
+  public:
+    static constexpr uint32 WORD_SIZE = 64;
+
+  private:
+    struct Word {
+        uint64 printable;
+        uint64 zero;
+        uint64 offset;
+    };
+
+    uint8 tail[WORD_SIZE]{};
+    uint32 tailSize{ 0 };
+    uint64 nextOffset{ 0 };
+
+    Word pending{};
+    bool hasPending{ false };
+    uint64 carryPrintable{ 0 };
+    uint64 carryUnicode{ 0 };
+
+    static Word Classify(const uint8* data, uint64 offset);
+    void Push(const Word& word, std::vector<uint64>& runStarts);
+    void Emit(const Word& word, uint64 nextZero, std::vector<uint64>& runStarts);
+
+  public:
+    void Reset(uint64 offset);
+
+    // data must follow (contiguously) the data from the previous call
+    void Scan(BufferView data, std::vector<uint64>& runStarts);
+    // flushes what is left from the last (incomplete) word
+    void Finish(std::vector<uint64>& runStarts);
+
+    // "a\0b\0c\0" -> "abc"
+    static void NarrowUnicode(BufferView data, std::string& output);
+};
+} // namespace GView::GenericPlugins::Droppper
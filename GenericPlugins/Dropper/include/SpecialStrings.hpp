@@ -48,11 +48,20 @@ class SpecialStrings : public IDrop
     bool caseSensitive{ false };
     GView::Regex::Matcher matcherAscii{};
     GView::Regex::Matcher matcherUnicode{};
+    // same expressions as the matchers but not anchored (used to find the values inside a printable run)
+    GView::Regex::Matcher searcherAscii{};
+    GView::Regex::Matcher searcherUnicode{};
+    bool hasSearchers{ false };
+
+    void InitMatchers(std::string_view expressionAscii, std::string_view expressionUnicode);
 
   public:
     virtual Category GetCategory() const override;
     virtual Priority GetPriority() const override;
     virtual bool ShouldGroupInOneFile() const override;
+
+    // the first offset from [offset, end) where Check might succeed (false if there is none)
+    virtual bool FindCandidate(uint64 offset, uint64 end, DataCache& file, bool isUnicode, uint64& candidate);
 };
 
 class IpAddress : public SpecialStrings
@@ -112,6 +121,7 @@ class Wallet : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual bool FindCandidate(uint64 offset, uint64 end, DataCache& file, bool isUnicode, uint64& candidate) override;
 
     WalletType GetLastCheckResult() const;
 };
@@ -153,11 +153,11 @@ bool Instance::WriteToLog(std::ofstream& f, uint64 start, uint64 end, Result res
         case GView::GenericPlugins::Droppper::Result::Ascii:
             f.write(reinterpret_cast<const char*>(bv.GetData()), bv.GetLength());
             break;
-        case GView::GenericPlugins::Droppper::Result::Unicode:
-            for (uint32 i = 0; i < bv.GetLength(); i += 2) {
-                f.write(reinterpret_cast<const char*>(bv.GetData() + i), 1);
-            }
-            break;
+        case GView::GenericPlugins::Droppper::Result::Unicode: {
+            std::string value;
+            PrintableRunScanner::NarrowUnicode(bv, value);
+            f.write(value.data(), value.size());
+        } break;
         default:
             break;
         }
@@ -191,9 +191,9 @@ bool Instance::WriteToFile(std::filesystem::path path, uint64 start, uint64 end,
 
     if (dropper->ShouldGroupInOneFile()) {
         if (result == Result::Unicode) {
-            for (uint32 i = 0; i < bv.GetLength(); i += 2) {
-                f.write(reinterpret_cast<const char*>(bv.GetData() + i), 1);
-            }
+            std::string value;
+            PrintableRunScanner::NarrowUnicode(bv, value);
+            f.write(value.data(), value.size());
         } else {
             f.write(reinterpret_cast<const char*>(bv.GetData()), bv.GetLength());
         }
@@ -291,6 +291,18 @@ bool Instance::ProcessObjects(
         whitelistedPlugins.push_back(&context.textDropper);
     }
 
+    // strings only -> no need to look at every offset, just at the start of each printable run
+    bool onlyStrings = true;
+    for (const auto& d : whitelistedPlugins) {
+        if ((*d)->GetCategory() != Category::SpecialStrings) {
+            onlyStrings = false;
+            break;
+        }
+    }
+    if (onlyStrings) {
+        return ProcessRunStarts(whitelistedPlugins, offset, size, recursive, identify);
+    }
+
     ProgressStatus::Init("Searching...", size);
     LocalString<512> ls;
     const char* format          = "[%llu/%llu] bytes... Found [%u] object(s).";
@@ -315,50 +327,62 @@ bool Instance::ProcessObjects(
         CHECKBK(buffer.GetLength() > 0, "");
         nextOffset = offset + 1;
 
-        for (uint32 i = 0; i < static_cast<uint32>(Priority::Count); i++) {
-            const auto priority = static_cast<Priority>(i);
-            if (priority == Priority::Text) {
-                if (!IDrop::IsAsciiPrintable(buffer.GetData()[0])) {
-                    continue;
-                }
-            }
+        CheckDroppers(whitelistedPlugins, offset, buffer, recursive, identify, nextOffset);
 
-            for (auto& dropper : whitelistedPlugins) {
-                if ((*dropper)->GetPriority() != priority) {
-                    continue;
-                }
+        offset = nextOffset;
+    }
+
+    uint32 objectsCount = 0;
+    for (const auto& [_, v] : context.occurences) {
+        objectsCount += v;
+    }
+    ProgressStatus::Update(size, ls.Format(format, size, size, objectsCount));
 
-                Finding finding{ .dropperName = (*dropper)->GetName(), .category = (*dropper)->GetCategory(), .subcategory = (*dropper)->GetSubcategory() };
-                const auto result = (*dropper)->Check(offset, cache, buffer, finding);
+    return true;
+}
 
-                if (result && finding.result != Result::NotFound) {
-                    auto& f = context.findings.emplace_back(finding);
-                    context.occurences[f.dropperName] += 1;
+bool Instance::ProcessRunStarts(
+      std::vector<std::unique_ptr<IDrop>*>& droppers, uint64 offset, uint64 size, bool recursive, ArtefactIdentificationCallback identify)
+{
+    DataCache& cache  = object->GetData();
+    uint64 nextOffset = offset;
 
-                    if (!recursive) {
-                        nextOffset = f.end;
-                    }
+    ProgressStatus::Init("Searching...", size);
+    LocalString<512> ls;
+    const char* format = "[%llu/%llu] bytes... Found [%u] object(s).";
+
+    // the droppers will move the cache around -> the run starts for the whole block are collected first
+    PrintableRunScanner scanner;
+    scanner.Reset(offset);
+    std::vector<uint64> runStarts;
+
+    const uint32 blockSize = std::max<uint32>(cache.GetCacheSize() / 2, PrintableRunScanner::WORD_SIZE);
+    uint64 blockOffset     = offset;
+    while (blockOffset < size) {
+        uint32 objectsCount = 0;
+        for (const auto& [_, v] : context.occurences) {
+            objectsCount += v;
+        }
+        CHECKBK(ProgressStatus::Update(blockOffset, ls.Format(format, blockOffset, size, objectsCount)) == false, "");
 
-                    // adjust for zones
-                    if (f.result == Result::Unicode) {
-                        f.end -= 2;
-                    } else if (f.result == Result::Ascii) {
-                        f.end -= 1;
-                    } else {
-                        f.end += 1;
-                    }
-                    context.zones.Add(f.start, f.end, OBJECT_CATEGORY_COLOR_MAP.at(f.category), f.dropperName);
+        const auto toRead = static_cast<uint32>(std::min<uint64>(blockSize, size - blockOffset));
+        auto block        = cache.Get(blockOffset, toRead, false);
+        CHECKBK(block.GetLength() > 0, "");
 
-                    if (identify != nullptr) {
-                        f.artefact = identify(cache, f.subcategory, f.start, f.end, f.result);
-                    }
+        runStarts.clear();
+        scanner.Scan(block, runStarts);
+        blockOffset += block.GetLength();
+        if (blockOffset >= size) {
+            scanner.Finish(runStarts);
+        }
 
-                    break;
-                }
+        for (const auto start : runStarts) {
+            if (start < nextOffset) {
+                continue; // inside an already dropped object
             }
-        }
 
-        offset = nextOffset;
+            CHECKBK(ProcessRun(droppers, start, size, recursive, identify, nextOffset), "");
+        }
     }
 
     uint32 objectsCount = 0;
@@ -370,6 +394,126 @@ bool Instance::ProcessObjects(
     return true;
 }
 
+bool Instance::ProcessRun(
+      std::vector<std::unique_ptr<IDrop>*>& droppers, uint64 start, uint64 size, bool recursive, ArtefactIdentificationCallback identify, uint64& nextOffset)
+{
+    DataCache& cache = object->GetData();
+
+    auto buffer = GetPrecachedBuffer(start, cache);
+    CHECK(buffer.GetLength() > 0, false, "");
+    const auto isUnicode = buffer.GetLength() > 1 && buffer.GetData()[1] == 0;
+    const auto end       = FindRunEnd(start, size, isUnicode);
+
+    // the next candidate of every dropper in [from, end) (end => none) - it is searched again only after the run moves past it
+    std::vector<uint64> candidates(droppers.size(), 0);
+    auto position = start;
+    while (true) {
+        nextOffset = position + 1;
+        CheckDroppers(droppers, position, buffer, recursive, identify, nextOffset);
+        auto from = nextOffset;
+        if (isUnicode && ((from - start) & 1)) {
+            from++; // keep the UTF-16LE alignment of the run
+        }
+        CHECKBK(from < end, "");
+
+        // the values can also start inside the run (href="http://..." or ip=1.2.3.4) => every dropper searches for the next place
+        // where it could match and only there the droppers are checked again
+        auto next = end;
+        for (size_t i = 0; i < droppers.size(); i++) {
+            if (candidates[i] < from) {
+                auto specialString = static_cast<SpecialStrings::SpecialStrings*>(droppers[i]->get());
+                if (!specialString->FindCandidate(from, end, cache, isUnicode, candidates[i])) {
+                    candidates[i] = end;
+                }
+            }
+            next = std::min<uint64>(next, candidates[i]);
+        }
+        CHECKBK(next < end, "");
+
+        position = next;
+        buffer   = GetPrecachedBuffer(position, cache);
+        CHECK(buffer.GetLength() > 0, false, "");
+    }
+
+    return true;
+}
+
+uint64 Instance::FindRunEnd(uint64 offset, uint64 size, bool isUnicode)
+{
+    DataCache& cache  = object->GetData();
+    const uint32 step = isUnicode ? 2 : 1;
+
+    // a run ends at the first space or non printable character (same as for PrintableRunScanner)
+    while (offset < size) {
+        auto buffer = cache.Get(offset, static_cast<uint32>(std::min<uint64>(cache.GetCacheSize() / 12, size - offset)), false);
+        const auto length = static_cast<uint32>(buffer.GetLength() / step * step);
+        CHECKBK(length > 0, "");
+        for (uint32 i = 0; i < length; i += step) {
+            const auto c = buffer.GetData()[i];
+            if (c == ' ' || !IDrop::IsAsciiPrintable(c) || (isUnicode && buffer.GetData()[i + 1] != 0)) {
+                return offset + i;
+            }
+        }
+        offset += length;
+    }
+
+    return std::min<uint64>(offset, size);
+}
+
+void Instance::CheckDroppers(
+      std::vector<std::unique_ptr<IDrop>*>& droppers,
+      uint64 offset,
+      BufferView buffer,
+      bool recursive,
+      ArtefactIdentificationCallback identify,
+      uint64& nextOffset)
+{
+    DataCache& cache = object->GetData();
+
+    for (uint32 i = 0; i < static_cast<uint32>(Priority::Count); i++) {
+        const auto priority = static_cast<Priority>(i);
+        if (priority == Priority::Text) {
+            if (!IDrop::IsAsciiPrintable(buffer.GetData()[0])) {
+                continue;
+            }
+        }
+
+        for (auto& dropper : droppers) {
+            if ((*dropper)->GetPriority() != priority) {
+                continue;
+            }
+
+            Finding finding{ .dropperName = (*dropper)->GetName(), .category = (*dropper)->GetCategory(), .subcategory = (*dropper)->GetSubcategory() };
+            const auto result = (*dropper)->Check(offset, cache, buffer, finding);
+
+            if (result && finding.result != Result::NotFound) {
+                auto& f = context.findings.emplace_back(finding);
+                context.occurences[f.dropperName] += 1;
+
+                if (!recursive) {
+                    nextOffset = f.end;
+                }
+
+                // adjust for zones
+                if (f.result == Result::Unicode) {
+                    f.end -= 2;
+                } else if (f.result == Result::Ascii) {
+                    f.end -= 1;
+                } else {
+                    f.end += 1;
+                }
+                context.zones.Add(f.start, f.end, OBJECT_CATEGORY_COLOR_MAP.at(f.category), f.dropperName);
+
+                if (identify != nullptr) {
+                    f.artefact = identify(cache, f.subcategory, f.start, f.end, f.result);
+                }
+
+                break;
+            }
+        }
+    }
+}
+
 bool Instance::SetHighlighting(bool value, bool warn)
 {
     if (value) {
@@ -0,0 +1,147 @@
+#include "PrintableRuns.hpp"
+
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define DROPPER_USE_SSE2
+#    include <emmintrin.h>
+#endif
+
+namespace GView::GenericPlugins::Droppper
+{
+// word.printable -> printable characters without space (0x21 - 0x7e)
+// word.zero      -> 0x00 characters
+PrintableRunScanner::Word PrintableRunScanner::Classify(const uint8* data, uint64 offset)
+{
+    Word word{ 0, 0, offset };
+
+#ifdef DROPPER_USE_SSE2
+    // x in [0x21, 0x7e] <=> (int8) (x + 0x5f) < (int8) 0xde
+    const auto bias  = _mm_set1_epi8(0x5f);
+    const auto limit = _mm_set1_epi8(static_cast<char>(0xde));
+    const auto zero  = _mm_setzero_si128();
+    for (uint32 i = 0; i < WORD_SIZE; i += 16) {
+        const auto v         = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const auto printable = _mm_cmplt_epi8(_mm_add_epi8(v, bias), limit);
+        const auto zeroes    = _mm_cmpeq_epi8(v, zero);
+        word.printable |= static_cast<uint64>(static_cast<uint16>(_mm_movemask_epi8(printable))) << i;
+        word.zero |= static_cast<uint64>(static_cast<uint16>(_mm_movemask_epi8(zeroes))) << i;
+    }
+#else
+    for (uint32 i = 0; i < WORD_SIZE; i++) {
+        const auto c = data[i];
+        word.printable |= static_cast<uint64>(c > 0x20 && c < 0x7f) << i;
+        word.zero |= static_cast<uint64>(c == 0) << i;
+    }
+#endif
+
+    return word;
+}
+
+void PrintableRunScanner::Emit(const Word& word, uint64 nextZero, std::vector<uint64>& runStarts)
+{
+    // a printable character followed by a 0 is (possibly) an UTF-16LE code unit
+    const auto zeroAfter = (word.zero >> 1) | (nextZero << 63);
+    const auto unicode   = word.printable & zeroAfter;
+
+    const auto starts   = word.printable & ~((word.printable << 1) | carryPrintable);
+    const auto interior = unicode & ((unicode << 2) | carryUnicode);
+
+    carryPrintable = word.printable >> 63;
+    carryUnicode   = unicode >> 62;
+
+    auto mask = starts & ~interior;
+    while (mask) {
+        runStarts.push_back(word.offset + std::countr_zero(mask));
+        mask &= mask - 1;
+    }
+}
+
+void PrintableRunScanner::Push(const Word& word, std::vector<uint64>& runStarts)
+{
+    // the UTF-16 check for the last byte of a word requires the first byte of the next one
+    if (hasPending) {
+        Emit(pending, word.zero & 1, runStarts);
+    }
+    pending    = word;
+    hasPending = true;
+}
+
+void PrintableRunScanner::Reset(uint64 offset)
+{
+    tailSize       = 0;
+    nextOffset     = offset;
+    hasPending     = false;
+    carryPrintable = 0;
+    carryUnicode   = 0;
+}
+
+void PrintableRunScanner::Scan(BufferView data, std::vector<uint64>& runStarts)
+{
+    auto p         = data.GetData();
+    const auto end = p + data.GetLength();
+
+    if (tailSize > 0) {
+        const auto toCopy = std::min<uint64>(WORD_SIZE - tailSize, end - p);
+        memcpy(tail + tailSize, p, toCopy);
+        tailSize += static_cast<uint32>(toCopy);
+        p += toCopy;
+
+        if (tailSize < WORD_SIZE) {
+            return;
+        }
+
+        Push(Classify(tail, nextOffset), runStarts);
+        nextOffset += WORD_SIZE;
+        tailSize = 0;
+    }
+
+    while (p + WORD_SIZE <= end) {
+        Push(Classify(p, nextOffset), runStarts);
+        nextOffset += WORD_SIZE;
+        p += WORD_SIZE;
+    }
+
+    tailSize = static_cast<uint32>(end - p);
+    memcpy(tail, p, tailSize);
+}
+
+void PrintableRunScanner::Finish(std::vector<uint64>& runStarts)
+{
+    if (tailSize > 0) {
+        // 0x01 is neither printable nor zero
+        memset(tail + tailSize, 1, WORD_SIZE - tailSize);
+        Push(Classify(tail, nextOffset), runStarts);
+        nextOffset += tailSize;
+        tailSize = 0;
+    }
+
+    if (hasPending) {
+        Emit(pending, 0, runStarts);
+        hasPending = false;
+    }
+}
+
+void PrintableRunScanner::NarrowUnicode(BufferView data, std::string& output)
+{
+    const auto length = (static_cast<size_t>(data.GetLength()) + 1) / 2;
+    output.resize(length);
+
+    auto src = data.GetData();
+    auto dst = reinterpret_cast<uint8*>(output.data());
+    size_t i = 0;
+
+#ifdef DROPPER_USE_SSE2
+    const auto lowBytes = _mm_set1_epi16(0x00ff);
+    for (; i * 2 + 32 <= data.GetLength(); i += 16) {
+        const auto a = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2)), lowBytes);
+        const auto b = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2 + 16)), lowBytes);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(a, b));
+    }
+#endif
+
+    for (; i < length; i++) {
+        dst[i] = src[i * 2];
+    }
+}
+} // namespace GView::GenericPlugins::Droppper
@@ -11,8 +11,7 @@ EmailAddress::EmailAddress(bool caseSensitive, bool unicode)
 {
     this->unicode       = unicode;
     this->caseSensitive = caseSensitive;
-    this->matcherAscii.Init(EMAIL_REGEX_ASCII, unicode, caseSensitive);
-    this->matcherUnicode.Init(EMAIL_REGEX_UNICODE, unicode, caseSensitive);
+    InitMatchers(EMAIL_REGEX_ASCII, EMAIL_REGEX_UNICODE);
 }
 
 const std::string_view EmailAddress::GetName() const
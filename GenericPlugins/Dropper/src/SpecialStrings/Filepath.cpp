@@ -13,8 +13,7 @@ Filepath::Filepath(bool caseSensitive, bool unicode)
 {
     this->unicode       = unicode;
     this->caseSensitive = caseSensitive;
-    this->matcherAscii.Init(PATH_REGEX_ASCII, unicode, caseSensitive);
-    this->matcherUnicode.Init(PATH_REGEX_UNICODE, unicode, caseSensitive);
+    InitMatchers(PATH_REGEX_ASCII, PATH_REGEX_UNICODE);
 }
 
 const std::string_view Filepath::GetName() const
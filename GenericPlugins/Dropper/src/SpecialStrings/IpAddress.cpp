@@ -13,8 +13,7 @@ IpAddress::IpAddress(bool caseSensitive, bool unicode)
 {
     this->unicode       = unicode;
     this->caseSensitive = caseSensitive;
-    this->matcherAscii.Init(IPS_REGEX_ASCII, unicode, caseSensitive);
-    this->matcherUnicode.Init(IPS_REGEX_UNICODE, unicode, caseSensitive);
+    InitMatchers(IPS_REGEX_ASCII, IPS_REGEX_UNICODE);
 }
 
 const std::string_view IpAddress::GetName() const
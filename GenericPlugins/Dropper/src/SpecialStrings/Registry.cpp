@@ -15,8 +15,7 @@ Registry::Registry(bool caseSensitive, bool unicode)
 {
     this->unicode       = unicode;
     this->caseSensitive = caseSensitive;
-    this->matcherAscii.Init(REGISTRY_REGEX_ASCII, unicode, caseSensitive);
-    this->matcherUnicode.Init(REGISTRY_REGEX_UNICODE, unicode, caseSensitive);
+    InitMatchers(REGISTRY_REGEX_ASCII, REGISTRY_REGEX_UNICODE);
 }
 
 const std::string_view Registry::GetName() const
@@ -18,4 +18,42 @@ bool SpecialStrings::ShouldGroupInOneFile() const
 {
     return true;
 }
+
+void SpecialStrings::InitMatchers(std::string_view expressionAscii, std::string_view expressionUnicode)
+{
+    this->matcherAscii.Init(expressionAscii, unicode, caseSensitive);
+    this->matcherUnicode.Init(expressionUnicode, unicode, caseSensitive);
+
+    const auto unanchored = [](std::string_view expression) { return expression.starts_with('^') ? expression.substr(1) : expression; };
+    this->searcherAscii.Init(unanchored(expressionAscii), unicode, caseSensitive);
+    this->searcherUnicode.Init(unanchored(expressionUnicode), unicode, caseSensitive);
+    this->hasSearchers = true;
+}
+
+bool SpecialStrings::FindCandidate(uint64 offset, uint64 end, DataCache& file, bool isUnicode, uint64& candidate)
+{
+    constexpr uint32 OVERLAP = 256; // a value cut by the end of a window is searched again in the next one
+
+    CHECK(hasSearchers, false, "");
+    if (isUnicode) {
+        CHECK(unicode, false, "");
+    }
+    auto& searcher      = isUnicode ? this->searcherUnicode : this->searcherAscii;
+    const uint32 window = std::max<uint32>(file.GetCacheSize() / 12, OVERLAP * 2);
+
+    while (offset < end) {
+        auto buffer = file.Get(offset, static_cast<uint32>(std::min<uint64>(window, end - offset)), false);
+        CHECK(buffer.GetLength() > 0, false, "");
+
+        uint64 start = 0, matchEnd = 0;
+        if (searcher.Match(buffer, start, matchEnd)) {
+            candidate = offset + start;
+            return true;
+        }
+        CHECK(offset + buffer.GetLength() < end && buffer.GetLength() > OVERLAP, false, "");
+        offset += buffer.GetLength() - OVERLAP;
+    }
+
+    return false;
+}
 } // namespace GView::GenericPlugins::Droppper::SpecialStrings
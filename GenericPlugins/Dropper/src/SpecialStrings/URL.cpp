@@ -13,8 +13,7 @@ URL::URL(bool caseSensitive, bool unicode)
 {
     this->unicode       = unicode;
     this->caseSensitive = caseSensitive;
-    this->matcherAscii.Init(URL_REGEX_ASCII, unicode, caseSensitive);
-    this->matcherUnicode.Init(URL_REGEX_UNICODE, unicode, caseSensitive);
+    InitMatchers(URL_REGEX_ASCII, URL_REGEX_UNICODE);
 }
 
 const std::string_view URL::GetName() const
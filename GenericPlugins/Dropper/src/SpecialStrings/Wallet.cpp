@@ -105,6 +105,31 @@ bool Wallet::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, F
     return true;
 }
 
+bool Wallet::FindCandidate(uint64 offset, uint64 end, DataCache& file, bool isUnicode, uint64& candidate)
+{
+    if (isUnicode) {
+        CHECK(unicode, false, "");
+    }
+
+    // every wallet address starts with one of these characters => only there Check can succeed
+    const uint32 step = isUnicode ? 2 : 1;
+    while (offset < end) {
+        auto buffer       = file.Get(offset, static_cast<uint32>(std::min<uint64>(file.GetCacheSize() / 12, end - offset)), false);
+        const auto length = static_cast<uint32>(buffer.GetLength() / step * step);
+        CHECK(length > 0, false, "");
+        for (uint32 i = 0; i < length; i += step) {
+            const auto c = buffer.GetData()[i];
+            if (c == Bitcoin_P2WPKH_MAGIC[0] || c == Ethereum_MAGIC[0] || c == Stellar_MEMO_MAGIC[0] || c == Stellar_MUXED_MAGIC[0]) {
+                candidate = offset + i;
+                return true;
+            }
+        }
+        offset += length;
+    }
+
+    return false;
+}
+
 WalletType Wallet::GetLastCheckResult() const
 {
     return this->checkResult;
@@ -2,6 +2,10 @@
 
 #include "GView.hpp"
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 namespace GView::GenericPlugins::EntropyVisualizer
 {
 static const SpecialChars BLOCK_SPECIAL_CHARACTER                   = SpecialChars::Block75;
@@ -29,6 +33,103 @@ enum class EntropyType {
   Renyi = 2
 };
 
+/*
+    Entropy of the whole object for every block size of the form leafSize * 2^level.
+    The object is split in chunks of (at most) MAX_CHUNK_LEAVES leaves that are processed in parallel: a worker reads a
+    chunk (through its own file handle, READ_SIZE bytes at a time), builds the histogram of every leaf and merges them
+    pairwise up to the chunk level.
+    The levels above a chunk are merged from the chunk histograms once all chunks are done.
+*/
+class EntropyPyramid
+{
+  public:
+    struct Values {
+        float shannon;
+        float renyi;
+    };
+
+  private:
+    static constexpr uint64 MAX_LEAVES       = 1ULL << 18;
+    static constexpr uint32 MAX_CHUNK_LEAVES = 256;
+    static constexpr uint32 READ_SIZE        = 0x100000; // a chunk (or a leaf) can be much larger than this
+
+    Reference<Object> object;
+    uint64 size{ 0 };
+    uint64 leafSize{ 0 };
+    uint32 chunkLevel{ 0 }; // a chunk has (1 << chunkLevel) leaves
+    uint32 chunksCount{ 0 };
+    bool computeRenyi{ false };
+    double alpha{ 0.0 };
+
+    std::vector<std::vector<Values>> levels; // levels[k][i] = block i of size (leafSize << k)
+    std::vector<GView::Entropy::Frequencies> chunkHistograms;
+    std::unique_ptr<std::atomic<bool>[]> chunkReady;
+    std::atomic<bool> failed{ false }; // a chunk could not be read => the levels above the chunks are not available
+
+    std::vector<std::thread> workers;
+    std::atomic<uint32> nextChunk{ 0 };
+    std::atomic<bool> stopRequested{ false };
+    uint32 completedChunks{ 0 };
+    bool complete{ false };
+    std::mutex lock; // completedChunks + object data (for objects that are not files)
+
+    void WorkerLoop();
+    bool Read(AppCUI::OS::File* file, uint64 offset, uint32 length, Buffer& buffer);
+    void MergeLevels(std::vector<GView::Entropy::Frequencies>& histograms, uint64 count, uint32 fromLevel, uint32 toLevel, uint64 firstBlock, uint64 bytes);
+    bool ProcessChunk(uint32 chunk, AppCUI::OS::File* file, Buffer& buffer, std::vector<GView::Entropy::Frequencies>& histograms);
+    Values ComputeValues(const GView::Entropy::Frequencies& frequency, uint64 count) const;
+    static uint64 ComputeLeafSize(uint64 size);
+    inline uint64 GetLevelBlocksCount(uint32 level) const
+    {
+        const auto blockSize = leafSize << level;
+        return (size + blockSize - 1) / blockSize;
+    }
+
+  public:
+    ~EntropyPyramid();
+
+    bool Start(Reference<Object> object, bool computeRenyi, double alpha);
+    void Stop();
+    bool IsStarted() const
+    {
+        return !levels.empty();
+    }
+    bool IsCompatible(bool computeRenyi, double alpha) const
+    {
+        return IsStarted() && (!computeRenyi || (this->computeRenyi && this->alpha == alpha));
+    }
+    bool GetLevel(uint64 blockSize, uint32& level) const;
+    // true if a pyramid of an object of `size` bytes has a level with blocks of `blockSize` bytes (known before Start)
+    static bool HasBlockSize(uint64 size, uint64 blockSize);
+    uint32 GetChunksCount() const
+    {
+        return chunksCount;
+    }
+    uint32 GetCompletedChunks();
+    bool IsComplete();
+    // the cache of the object is shared with the workers => any other read of the object data goes through this
+    bool CopyObjectData(Reference<Object> object, uint64 offset, uint32 length, Buffer& buffer);
+
+    // the blocks of chunk `chunk` at level `level` (level <= chunkLevel) - valid once the chunk is ready
+    bool IsChunkReady(uint32 chunk) const
+    {
+        return chunkReady[chunk].load(std::memory_order_acquire);
+    }
+    std::pair<uint64, uint64> GetChunkBlocks(uint32 chunk, uint32 level) const;
+    uint32 GetChunkLevel() const
+    {
+        return chunkLevel;
+    }
+    const Values& GetValues(uint32 level, uint64 index) const
+    {
+        return levels[level][index];
+    }
+    uint64 GetBlocksCount(uint32 level) const
+    {
+        return levels[level].size();
+    }
+};
+
 class Plugin : public Window
 {
   private:
@@ -40,12 +141,21 @@ class Plugin : public Window
     Reference<NumericSelector> blockSizeSelector;
     Reference<CanvasViewer> canvasEntropy;
     Reference<CanvasViewer> canvasLegend;
+    Reference<Label> progressLabel;
 
     Reference<NumericSelector> alphaSelector;
 
     uint32 blockSize  = MINIMUM_BLOCK_SIZE;
     double renyiAlpha = 0.5;
 
+    EntropyPyramid pyramid;
+
+    // the pyramid blocks are drawn as their chunks are computed (on every repaint) => nothing waits for the workers
+    bool drawPending        = false;
+    EntropyType pendingType = EntropyType::Shannon;
+    uint32 pendingLevel     = 0;
+    std::vector<bool> drawnChunks;
+
   private:
     void ResizeLegendCanvas();
     static Color ShannonEntropyValueToColor(int32 value);
@@ -54,6 +164,9 @@ class Plugin : public Window
     static double ComputeEpsilon(uint64 size);
     static Color EmbeddedObjectValueToColor(std::string_view name);
     bool InitializeBlocksForCanvas();
+    bool DrawEntropyFromPyramid(EntropyType type, uint32 level);
+    bool DrawPendingEntropyBlocks();
+    void DrawEntropyBlock(uint64 index, double value, EntropyType type, double epsilon);
 
   public:
     Plugin(Reference<Object> object);
@@ -65,6 +178,7 @@ class Plugin : public Window
     bool DrawEmbeddedObjectsLegend();
     std::optional<GView::Utils::Zone> IsOffsetInZone(const GView::Utils::ZonesList& zones, uint64 offset) const;
 
+    virtual void Paint(AppCUI::Graphics::Renderer& renderer) override;
     virtual void OnAfterResize(int newWidth, int newHeight) override;
     bool OnEvent(Reference<Control> sender, Event eventType, int controlID) override;
 };
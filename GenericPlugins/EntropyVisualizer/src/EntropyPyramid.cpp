@@ -0,0 +1,263 @@
+#include "EntropyVisualizer.hpp"
+
+namespace GView::GenericPlugins::EntropyVisualizer
+{
+EntropyPyramid::~EntropyPyramid()
+{
+    Stop();
+}
+
+bool EntropyPyramid::Start(Reference<Object> object, bool computeRenyi, double alpha)
+{
+    Stop();
+    CHECK(object.IsValid(), false, "");
+
+    this->object       = object;
+    this->size         = object->GetData().GetSize();
+    this->computeRenyi = computeRenyi;
+    this->alpha        = alpha;
+    CHECK(this->size > 0, false, "");
+
+    leafSize               = ComputeLeafSize(this->size);
+    const auto leavesCount = GetLevelBlocksCount(0);
+    chunkLevel             = 0;
+    while (((1U << chunkLevel) < MAX_CHUNK_LEAVES) && ((1ULL << chunkLevel) < leavesCount)) {
+        chunkLevel++;
+    }
+    chunksCount = static_cast<uint32>((leavesCount + (1ULL << chunkLevel) - 1) >> chunkLevel);
+
+    for (uint32 level = 0;; level++) {
+        const auto count = GetLevelBlocksCount(level);
+        levels.emplace_back(count, Values{ 0.0f, 0.0f });
+        if (count == 1) {
+            break;
+        }
+    }
+    chunkHistograms.assign(chunksCount, GView::Entropy::Frequencies{});
+    chunkReady = std::make_unique<std::atomic<bool>[]>(chunksCount);
+
+    nextChunk       = 0;
+    completedChunks = 0;
+    complete        = false;
+    failed          = false;
+    stopRequested   = false;
+
+    const auto threadsCount = std::min<uint32>(std::max<uint32>(std::thread::hardware_concurrency(), 1), chunksCount);
+    for (uint32 idx = 0; idx < threadsCount; idx++) {
+        workers.emplace_back([this]() { WorkerLoop(); });
+    }
+    return true;
+}
+
+void EntropyPyramid::Stop()
+{
+    stopRequested = true;
+    for (auto& t : workers) {
+        t.join();
+    }
+    workers.clear();
+    levels.clear();
+    chunkHistograms.clear();
+    chunkReady.reset();
+    chunksCount = 0;
+}
+
+uint64 EntropyPyramid::ComputeLeafSize(uint64 size)
+{
+    // leaves as small as possible without having more than MAX_LEAVES of them
+    uint64 leafSize = MINIMUM_BLOCK_SIZE;
+    while ((size + leafSize - 1) / leafSize > MAX_LEAVES) {
+        leafSize *= 2;
+    }
+    return leafSize;
+}
+
+bool EntropyPyramid::HasBlockSize(uint64 size, uint64 blockSize)
+{
+    // the same levels as Start builds: leafSize << level, up to the first level with a single block
+    for (auto levelBlockSize = ComputeLeafSize(size);; levelBlockSize *= 2) {
+        if (levelBlockSize == blockSize) {
+            return true;
+        }
+        if (levelBlockSize >= size || levelBlockSize > blockSize) {
+            return false;
+        }
+    }
+}
+
+bool EntropyPyramid::GetLevel(uint64 blockSize, uint32& level) const
+{
+    for (uint32 idx = 0; idx < static_cast<uint32>(levels.size()); idx++) {
+        if ((leafSize << idx) == blockSize) {
+            if ((idx > chunkLevel) && failed) {
+                return false;
+            }
+            level = idx;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32 EntropyPyramid::GetCompletedChunks()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return completedChunks;
+}
+
+bool EntropyPyramid::IsComplete()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return complete;
+}
+
+bool EntropyPyramid::CopyObjectData(Reference<Object> object, uint64 offset, uint32 length, Buffer& buffer)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    buffer = object->GetData().CopyToBuffer(offset, length, false);
+    return buffer.GetLength() > 0;
+}
+
+std::pair<uint64, uint64> EntropyPyramid::GetChunkBlocks(uint32 chunk, uint32 level) const
+{
+    const auto shift = chunkLevel - level;
+    const auto first = static_cast<uint64>(chunk) << shift;
+    const auto last  = std::min<uint64>(first + (1ULL << shift), levels[level].size());
+    return { first, last };
+}
+
+EntropyPyramid::Values EntropyPyramid::ComputeValues(const GView::Entropy::Frequencies& frequency, uint64 count) const
+{
+    Values v{};
+    v.shannon = static_cast<float>(GView::Entropy::ShannonEntropy(frequency, count));
+    if (computeRenyi) {
+        v.renyi = static_cast<float>(GView::Entropy::RenyiEntropy(frequency, count, alpha));
+    }
+    return v;
+}
+
+bool EntropyPyramid::Read(AppCUI::OS::File* file, uint64 offset, uint32 length, Buffer& buffer)
+{
+    if (file) {
+        buffer.Resize(length);
+        CHECK(file->SetCurrentPos(offset), false, "");
+        CHECK(file->Read(buffer.GetData(), length), false, "Fail to read %u bytes from %llu", length, offset);
+        return true;
+    }
+    // the cache of the object is not thread safe
+    std::lock_guard<std::mutex> guard(lock);
+    buffer = object->GetData().CopyToBuffer(offset, length, true);
+    return buffer.GetLength() == length;
+}
+
+void EntropyPyramid::MergeLevels(
+      std::vector<GView::Entropy::Frequencies>& histograms, uint64 count, uint32 fromLevel, uint32 toLevel, uint64 firstBlock, uint64 bytes)
+{
+    // histograms[i] is block (firstBlock + i) of level `fromLevel` => merge the neighbours two by two
+    for (auto level = fromLevel + 1; level <= toLevel; level++) {
+        const auto blockSize = leafSize << level;
+        const auto first     = firstBlock >> (level - fromLevel);
+        const auto newCount  = (count + 1) / 2;
+        for (uint64 i = 0; i < newCount; i++) {
+            auto& h = histograms[i];
+            h       = histograms[2 * i];
+            if (2 * i + 1 < count) {
+                const auto& right = histograms[2 * i + 1];
+                for (uint32 b = 0; b < 256; b++) {
+                    h[b] += right[b];
+                }
+            }
+            const auto blockBytes   = std::min<uint64>(blockSize, bytes - i * blockSize);
+            levels[level][first + i] = ComputeValues(h, blockBytes);
+        }
+        count = newCount;
+    }
+}
+
+bool EntropyPyramid::ProcessChunk(uint32 chunk, AppCUI::OS::File* file, Buffer& buffer, std::vector<GView::Entropy::Frequencies>& histograms)
+{
+    const auto firstLeaf = static_cast<uint64>(chunk) << chunkLevel;
+    const auto offset    = firstLeaf * leafSize;
+    const auto bytes     = std::min<uint64>(leafSize << chunkLevel, size - offset);
+
+    // the chunk is read in pieces of (at most) READ_SIZE bytes => a piece can hold several leaves or a part of a leaf
+    uint64 leaf       = 0;
+    uint64 leafFilled = 0;
+    for (uint64 done = 0; done < bytes;) {
+        if (stopRequested) {
+            return false;
+        }
+        const auto toRead = static_cast<uint32>(std::min<uint64>(READ_SIZE, bytes - done));
+        CHECK(Read(file, offset + done, toRead, buffer), false, "");
+
+        auto p    = buffer.GetData();
+        auto left = static_cast<uint64>(toRead);
+        while (left > 0) {
+            if (leafFilled == 0) {
+                histograms[leaf].fill(0);
+            }
+            const auto leafLength = std::min<uint64>(leafSize, bytes - leaf * leafSize);
+            const auto length     = std::min<uint64>(left, leafLength - leafFilled);
+            GView::Entropy::AddFrequencies(BufferView(p, static_cast<size_t>(length)), histograms[leaf]);
+            p += length;
+            left -= length;
+            leafFilled += length;
+            if (leafFilled == leafLength) {
+                levels[0][firstLeaf + leaf] = ComputeValues(histograms[leaf], leafLength);
+                leaf++;
+                leafFilled = 0;
+            }
+        }
+        done += toRead;
+    }
+
+    MergeLevels(histograms, leaf, 0, chunkLevel, firstLeaf, bytes);
+    chunkHistograms[chunk] = histograms[0];
+    return true;
+}
+
+void EntropyPyramid::WorkerLoop()
+{
+    // every worker has its own handle => reads do not wait for each other
+    std::unique_ptr<AppCUI::OS::File> file;
+    if (object->GetObjectType() == Object::Type::File) {
+        file = std::make_unique<AppCUI::OS::File>();
+        if (!file->OpenRead(std::filesystem::path(object->GetPath()))) {
+            file.reset();
+        }
+    }
+
+    Buffer buffer;
+    std::vector<GView::Entropy::Frequencies> histograms(1ULL << chunkLevel);
+    while (!stopRequested) {
+        const auto chunk = nextChunk++;
+        if (chunk >= chunksCount) {
+            break;
+        }
+
+        if (ProcessChunk(chunk, file.get(), buffer, histograms)) {
+            chunkReady[chunk].store(true, std::memory_order_release);
+        } else {
+            failed = true;
+        }
+
+        bool lastChunk;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            lastChunk = (++completedChunks) == chunksCount;
+        }
+        if (lastChunk) {
+            // all the chunks are done => the levels above them are merged from the chunk histograms
+            if (!failed) {
+                MergeLevels(chunkHistograms, chunksCount, chunkLevel, static_cast<uint32>(levels.size() - 1), 0, size);
+            }
+            std::lock_guard<std::mutex> guard(lock);
+            complete = true;
+        }
+    }
+
+    if (file) {
+        file->Close();
+    }
+}
+} // namespace GView::GenericPlugins::EntropyVisualizer
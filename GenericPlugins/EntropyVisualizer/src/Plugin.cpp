@@ -124,6 +124,9 @@ Plugin::Plugin(Reference<Object> object) : Window("Entropy Visualizer", "d:c,w:1
         auto canvas = this->canvasLegend->GetCanvas();
         canvas->Resize(this->canvasLegend->GetWidth(), this->canvasLegend->GetHeight());
     }
+    {
+        this->progressLabel = Factory::Label::Create(this, "", "x:81%,y:8,w:19%,h:1");
+    }
 
     this->InitializeBlocksForCanvas();
     // raise events after all children are initialized
@@ -142,17 +145,33 @@ bool Plugin::DrawEntropy(EntropyType type)
     const auto epsilon       = ComputeEpsilon(this->blockSize);
     const uint32 blocksCount = static_cast<uint32>(size / this->blockSize + 1);
 
-    uint32 x         = 0;
-    uint32 y         = 0;
     uint32 maxX      = canvas->GetWidth();
     uint32 maxY      = std::max<uint32>(blocksCount / maxX + 1 + 1, canvas->GetHeight());
     const auto color = ColorPair{ Color::White, this->GetConfig()->Window.Background.Normal };
     canvas->Resize(maxX, maxY, 'X', color);
     canvas->ClearEntireSurface('X', color);
 
+    // the entropy is computed only once (for all block sizes) - Renyi values depend on alpha
+    this->drawPending = false;
+    const auto renyi  = type == EntropyType::Renyi;
+    if (EntropyPyramid::HasBlockSize(size, this->blockSize)) {
+        if (!this->pyramid.IsCompatible(renyi, this->renyiAlpha)) {
+            this->pyramid.Start(this->object, renyi, this->renyiAlpha);
+        }
+        uint32 level = 0;
+        if (this->pyramid.IsStarted() && this->pyramid.GetLevel(this->blockSize, level)) {
+            return DrawEntropyFromPyramid(type, level);
+        }
+    }
+
+    // block size that is not a power of 2 multiple of the pyramid leaves
+    // the workers might still be reading the object (for another block size) => the data is read under their lock
+    this->progressLabel->SetText("");
+    Buffer buffer;
     for (uint32 i = 0; i < blocksCount; i++) {
-        auto bf    = cache.Get(i * static_cast<uint64>(this->blockSize), this->blockSize, false);
-        auto value = 0.0;
+        this->pyramid.CopyObjectData(this->object, i * static_cast<uint64>(this->blockSize), this->blockSize, buffer);
+        const auto bf = BufferView(buffer);
+        auto value    = 0.0;
         switch (type) {
         case EntropyType::Shannon:
         case EntropyType::ShannonDataType:
@@ -164,28 +183,89 @@ bool Plugin::DrawEntropy(EntropyType type)
             break;
         }
 
-        auto fColor = Color::Black;
-        switch (type) {
-        case EntropyType::Shannon:
-        case EntropyType::Renyi:
-            fColor = ShannonEntropyValueToColor(static_cast<uint32>(std::llround(value)));
-            break;
-        case EntropyType::ShannonDataType:
-            fColor = ShannonEntropyDataTypeValueToColor(value, epsilon);
-        default:
-            break;
+        DrawEntropyBlock(i, value, type, epsilon);
+    }
+
+    return true;
+}
+
+bool Plugin::DrawEntropyFromPyramid(EntropyType type, uint32 level)
+{
+    // the canvas is filled while the chunks are computed (see DrawPendingEntropyBlocks) => the UI thread never waits
+    this->drawPending  = true;
+    this->pendingType  = type;
+    this->pendingLevel = level;
+    this->drawnChunks.assign(this->pyramid.GetChunksCount(), false);
+    DrawPendingEntropyBlocks();
+    return true;
+}
+
+bool Plugin::DrawPendingEntropyBlocks()
+{
+    if (!this->drawPending) {
+        return false;
+    }
+
+    const auto type        = this->pendingType;
+    auto level             = this->pendingLevel;
+    const auto epsilon     = ComputeEpsilon(this->blockSize);
+    const auto chunksCount = this->pyramid.GetChunksCount();
+    const auto drawBlocks  = [&](uint64 first, uint64 last) {
+        for (auto i = first; i < last; i++) {
+            const auto& v = this->pyramid.GetValues(level, i);
+            DrawEntropyBlock(i, type == EntropyType::Renyi ? v.renyi : v.shannon, type, epsilon);
         }
+    };
 
-        canvas->WriteSpecialCharacter(x++, y, BLOCK_SPECIAL_CHARACTER, ColorPair{ fColor, CANVAS_ENTROPY_BACKGROUND });
-        if (x == maxX) {
-            x = 0;
-            y++;
+    // completed is read first => every chunk done before it is ready
+    const auto completed = this->pyramid.IsComplete();
+    if (level <= this->pyramid.GetChunkLevel()) {
+        for (uint32 chunk = 0; chunk < chunksCount; chunk++) {
+            if (!this->drawnChunks[chunk] && this->pyramid.IsChunkReady(chunk)) {
+                const auto [first, last] = this->pyramid.GetChunkBlocks(chunk, level);
+                drawBlocks(first, last);
+                this->drawnChunks[chunk] = true;
+            }
         }
     }
+    if (!completed) {
+        LocalString<64> ls;
+        this->progressLabel->SetText(ls.Format("Computing: %u/%u chunks", this->pyramid.GetCompletedChunks(), chunksCount));
+        return true;
+    }
+
+    // levels above a chunk are available only at the end
+    this->drawPending = false;
+    this->progressLabel->SetText("");
+    if (level > this->pyramid.GetChunkLevel()) {
+        CHECK(this->pyramid.GetLevel(this->blockSize, level), false, "Fail to compute the entropy");
+        drawBlocks(0, this->pyramid.GetBlocksCount(level));
+    }
 
     return true;
 }
 
+void Plugin::DrawEntropyBlock(uint64 index, double value, EntropyType type, double epsilon)
+{
+    auto canvas       = this->canvasEntropy->GetCanvas();
+    const uint32 maxX = canvas->GetWidth();
+
+    auto fColor = Color::Black;
+    switch (type) {
+    case EntropyType::Shannon:
+    case EntropyType::Renyi:
+        fColor = ShannonEntropyValueToColor(static_cast<uint32>(std::llround(value)));
+        break;
+    case EntropyType::ShannonDataType:
+        fColor = ShannonEntropyDataTypeValueToColor(value, epsilon);
+    default:
+        break;
+    }
+
+    canvas->WriteSpecialCharacter(
+          static_cast<int32>(index % maxX), static_cast<int32>(index / maxX), BLOCK_SPECIAL_CHARACTER, ColorPair{ fColor, CANVAS_ENTROPY_BACKGROUND });
+}
+
 bool Plugin::DrawEntropyLegend(EntropyType type)
 {
     CHECK(this->canvasLegend.IsValid(), false, "");
@@ -267,6 +347,10 @@ bool Plugin::DrawEmbeddedObjects()
 
     CHECK(currentViewName == VIEW_NAME, true, "");
 
+    // the entropy blocks still computed in background are not drawn over the embedded objects
+    this->drawPending = false;
+    this->progressLabel->SetText("");
+
     const auto& zones = currentView->GetObjectsHighlightingZonesList();
 
     CHECK(this->canvasEntropy.IsValid(), false, "");
@@ -402,6 +486,15 @@ std::optional<GView::Utils::Zone> Plugin::IsOffsetInZone(const GView::Utils::Zon
     return std::nullopt;
 }
 
+void Plugin::Paint(AppCUI::Graphics::Renderer& renderer)
+{
+    // the chunks computed since the last repaint are added to the canvas before it is painted
+    if (this->drawPending) {
+        DrawPendingEntropyBlocks();
+    }
+    Window::Paint(renderer);
+}
+
 void Plugin::OnAfterResize(int, int)
 {
     ResizeLegendCanvas();
@@ -476,7 +569,7 @@ bool Plugin::OnEvent(Reference<Control> sender, Event eventType, int controlID)
             this->blockSize = this->blockSizeSelector->GetValue();
             return drawSelectedEntropyType();
         } else if (sender == this->alphaSelector.ToBase<Control>()) {
-            this->renyiAlpha = this->alphaSelector->GetValue() / 10;
+            this->renyiAlpha = this->alphaSelector->GetValue() / 10.0;
             return drawSelectedEntropyType();
         }
         break;
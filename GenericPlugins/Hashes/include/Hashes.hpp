@@ -5,6 +5,10 @@
 #include <any>
 #include <array>
 #include <map>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <condition_variable>
 
 namespace GView::GenericPlugins::Hashes
 {
@@ -106,6 +110,36 @@ class HashesDialog : public Window, public Handlers::OnButtonPressedInterface
     void SetSettingsFromFlags();
 };
 
+// The blocks are read once (by the caller) and every hash consumes them from a ring of buffers on its own thread,
+// so computing many hashes takes (almost) as long as the slowest one of them.
+class HashPipeline
+{
+  public:
+    using Updater = std::function<bool(BufferView)>;
+
+  private:
+    static constexpr uint32 RING_SIZE = 4;
+
+    std::vector<Updater>* updaters{ nullptr };
+    std::vector<std::thread> workers;
+    std::array<Buffer, RING_SIZE> slots;
+    std::array<uint32, RING_SIZE> pending{}; // workers that did not process the slot yet
+
+    std::mutex lock;
+    std::condition_variable blockReady;
+    std::condition_variable slotFree;
+    uint64 published{ 0 };
+    bool finished{ false };
+    bool failed{ false };
+
+    void WorkerLoop(uint32 updaterIndex);
+
+  public:
+    bool Start(std::vector<Updater>& updaters);
+    bool Push(Buffer&& buffer);
+    bool Finish();
+};
+
 static bool ComputeHash(
       std::map<std::string, std::string>& outputs,
       uint32 hashFlags,
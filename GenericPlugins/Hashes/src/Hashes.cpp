@@ -591,6 +591,138 @@ void HashesDialog::SetSettingsFromFlags()
     allSettings->Save(Application::GetAppSettingsFile());
 }
 
+// the same names as the ones used for outputs
+static std::string_view GetHashName(Hashes hash)
+{
+    switch (hash)
+    {
+    case Hashes::Adler32:
+        return Adler32::GetName();
+    case Hashes::CRC16:
+        return CRC16::GetName();
+    case Hashes::CRC32_JAMCRC_0:
+        return CRC32::GetName(CRC32Type::JAMCRC_0);
+    case Hashes::CRC32_JAMCRC:
+        return CRC32::GetName(CRC32Type::JAMCRC);
+    case Hashes::CRC64_ECMA_182:
+        return CRC64::GetName(CRC64Type::ECMA_182);
+    case Hashes::CRC64_WE:
+        return CRC64::GetName(CRC64Type::WE);
+    case Hashes::MD5:
+        return "MD5";
+    case Hashes::BLAKE2S256:
+        return "BLAKE2S256";
+    case Hashes::BLAKE2B512:
+        return "BLAKE2B512";
+    case Hashes::SHA1:
+        return "SHA1";
+    case Hashes::SHA224:
+        return "SHA224";
+    case Hashes::SHA256:
+        return "SHA256";
+    case Hashes::SHA384:
+        return "SHA384";
+    case Hashes::SHA512:
+        return "SHA512";
+    case Hashes::SHA512_224:
+        return "SHA512_224";
+    case Hashes::SHA512_256:
+        return "SHA512_256";
+    case Hashes::SHA3_224:
+        return "SHA3_224";
+    case Hashes::SHA3_256:
+        return "SHA3_256";
+    case Hashes::SHA3_384:
+        return "SHA3_384";
+    case Hashes::SHA3_512:
+        return "SHA3_512";
+    case Hashes::SHAKE128:
+        return "SHAKE128";
+    case Hashes::SHAKE256:
+        return "SHAKE256";
+    default:
+        return "";
+    }
+}
+
+bool HashPipeline::Start(std::vector<Updater>& updaters)
+{
+    this->updaters = &updaters;
+    // a single hash => no need for threads, `Push` updates it directly
+    if (updaters.size() > 1)
+    {
+        for (auto idx = 0U; idx < updaters.size(); idx++)
+        {
+            workers.emplace_back([this, idx]() { WorkerLoop(idx); });
+        }
+    }
+    return true;
+}
+
+void HashPipeline::WorkerLoop(uint32 updaterIndex)
+{
+    auto& update = (*updaters)[updaterIndex];
+    for (uint64 index = 0;; index++)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        blockReady.wait(guard, [&]() { return published > index || finished; });
+        if (published <= index)
+            return; // finished and every block was consumed
+
+        const auto slot = index % RING_SIZE;
+        BufferView view = slots[slot];
+        guard.unlock();
+
+        // every worker reads the same buffer (no copies) => the slot is reused only after all of them are done
+        const auto ok = update(view);
+
+        guard.lock();
+        failed |= !ok;
+        if (--pending[slot] == 0)
+            slotFree.notify_one();
+    }
+}
+
+bool HashPipeline::Push(Buffer&& buffer)
+{
+    if (workers.empty())
+    {
+        for (auto& update : *updaters)
+        {
+            CHECK(update(buffer), false, "");
+        }
+        return true;
+    }
+
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        const auto slot = published % RING_SIZE;
+        slotFree.wait(guard, [&]() { return pending[slot] == 0; });
+        CHECK(failed == false, false, "");
+
+        slots[slot]   = std::move(buffer);
+        pending[slot] = static_cast<uint32>(workers.size());
+        published++;
+    }
+    blockReady.notify_all();
+    return true;
+}
+
+bool HashPipeline::Finish()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        finished = true;
+    }
+    blockReady.notify_all();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    workers.clear();
+    return failed == false;
+}
+
 static bool ComputeHash(
       std::map<std::string, std::string>& outputs,
       uint32 hashFlags,
@@ -613,6 +745,30 @@ static bool ComputeHash(
         }
     }
 
+    // same file (not modified since) => the results from a previous computation are reused
+    if (computeForFile)
+    {
+        std::map<std::string, std::string> cached;
+        std::string digest;
+        for (const auto& hash : hashList)
+        {
+            const auto name = GetHashName(static_cast<Hashes>(hashFlags & static_cast<uint32>(hash)));
+            if (name.empty())
+                continue;
+            if (!HashCache::Find(object, name, 0, objectSize, digest))
+            {
+                cached.clear();
+                break;
+            }
+            cached.emplace(name, digest);
+        }
+        if (!cached.empty())
+        {
+            outputs.insert(cached.begin(), cached.end());
+            return true;
+        }
+    }
+
     ProgressStatus::Init("Computing...", objectSize);
 
     Adler32 adler32{};
@@ -683,85 +839,86 @@ static bool ComputeHash(
         }
     }
 
-    const auto UpdateHashOnBuffer = [&](const Buffer& buffer)
+    // every selected hash gets its own updater (and its own worker thread, see HashPipeline)
+    std::vector<HashPipeline::Updater> updaters;
+    const auto AddOpenSSLUpdater = [&updaters](OpenSSLHash& hash)
     {
-        for (const auto& hash : hashList)
+        updaters.emplace_back([&hash](BufferView buffer) { return hash.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())); });
+    };
+    for (const auto& hash : hashList)
+    {
+        switch (static_cast<Hashes>(hashFlags & static_cast<uint32>(hash)))
         {
-            switch (static_cast<Hashes>(hashFlags & static_cast<uint32>(hash)))
-            {
-            case Hashes::Adler32:
-                CHECK(adler32.Update(buffer), false, "");
-                break;
-            case Hashes::CRC16:
-                CHECK(crc16.Update(buffer), false, "");
-                break;
-            case Hashes::CRC32_JAMCRC_0:
-                CHECK(crc32JAMCRC0.Update(buffer), false, "");
-                break;
-            case Hashes::CRC32_JAMCRC:
-                CHECK(crc32JAMCRC.Update(buffer), false, "");
-                break;
-            case Hashes::CRC64_ECMA_182:
-                CHECK(crc64ECMA182.Update(buffer), false, "");
-                break;
-            case Hashes::CRC64_WE:
-                CHECK(crc64WE.Update(buffer), false, "");
-                break;
-            case Hashes::MD5:
-                CHECK(md5.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::BLAKE2S256:
-                CHECK(blake2s256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::BLAKE2B512:
-                CHECK(blake2b512.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA1:
-                CHECK(sha1.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA224:
-                CHECK(sha224.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA256:
-                CHECK(sha256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA384:
-                CHECK(sha384.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA512:
-                CHECK(sha512.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA512_224:
-                CHECK(sha512_224.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA512_256:
-                CHECK(sha512_256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA3_224:
-                CHECK(sha3_224.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA3_256:
-                CHECK(sha3_256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA3_384:
-                CHECK(sha3_384.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA3_512:
-                CHECK(sha3_512.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHAKE128:
-                CHECK(shake128.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHAKE256:
-                CHECK(shake256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            default:
-                break;
-            }
+        case Hashes::Adler32:
+            updaters.emplace_back([&](BufferView buffer) { return adler32.Update(buffer); });
+            break;
+        case Hashes::CRC16:
+            updaters.emplace_back([&](BufferView buffer) { return crc16.Update(buffer); });
+            break;
+        case Hashes::CRC32_JAMCRC_0:
+            updaters.emplace_back([&](BufferView buffer) { return crc32JAMCRC0.Update(buffer); });
+            break;
+        case Hashes::CRC32_JAMCRC:
+            updaters.emplace_back([&](BufferView buffer) { return crc32JAMCRC.Update(buffer); });
+            break;
+        case Hashes::CRC64_ECMA_182:
+            updaters.emplace_back([&](BufferView buffer) { return crc64ECMA182.Update(buffer); });
+            break;
+        case Hashes::CRC64_WE:
+            updaters.emplace_back([&](BufferView buffer) { return crc64WE.Update(buffer); });
+            break;
+        case Hashes::MD5:
+            AddOpenSSLUpdater(md5);
+            break;
+        case Hashes::BLAKE2S256:
+            AddOpenSSLUpdater(blake2s256);
+            break;
+        case Hashes::BLAKE2B512:
+            AddOpenSSLUpdater(blake2b512);
+            break;
+        case Hashes::SHA1:
+            AddOpenSSLUpdater(sha1);
+            break;
+        case Hashes::SHA224:
+            AddOpenSSLUpdater(sha224);
+            break;
+        case Hashes::SHA256:
+            AddOpenSSLUpdater(sha256);
+            break;
+        case Hashes::SHA384:
+            AddOpenSSLUpdater(sha384);
+            break;
+        case Hashes::SHA512:
+            AddOpenSSLUpdater(sha512);
+            break;
+        case Hashes::SHA512_224:
+            AddOpenSSLUpdater(sha512_224);
+            break;
+        case Hashes::SHA512_256:
+            AddOpenSSLUpdater(sha512_256);
+            break;
+        case Hashes::SHA3_224:
+            AddOpenSSLUpdater(sha3_224);
+            break;
+        case Hashes::SHA3_256:
+            AddOpenSSLUpdater(sha3_256);
+            break;
+        case Hashes::SHA3_384:
+            AddOpenSSLUpdater(sha3_384);
+            break;
+        case Hashes::SHA3_512:
+            AddOpenSSLUpdater(sha3_512);
+            break;
+        case Hashes::SHAKE128:
+            AddOpenSSLUpdater(shake128);
+            break;
+        case Hashes::SHAKE256:
+            AddOpenSSLUpdater(shake256);
+            break;
+        default:
+            break;
         }
-
-        return true;
-    };
+    }
 
     LocalString<512> ls;
 
@@ -773,6 +930,19 @@ static bool ComputeHash(
 
     const auto block = object->GetData().GetCacheSize();
 
+    // per block SHA256 digests (used for diffing) are computed in the same pass
+    PiecewiseHash sha256Blocks(OpenSSLHashKind::Sha256, HashCache::DEFAULT_BLOCK_SIZE);
+    const auto computeBlocks = computeForFile && ((hashFlags & static_cast<uint32>(Hashes::SHA256)) != 0);
+    if (computeBlocks)
+    {
+        updaters.emplace_back([&sha256Blocks](BufferView buffer)
+                              { return sha256Blocks.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())); });
+    }
+
+    // this thread only reads the data (the cache is not thread safe), the hashes are updated by the pipeline workers
+    HashPipeline pipeline;
+    pipeline.Start(updaters);
+
     const auto UpdateHashOnBlock = [&](uint64 offset, uint64 left)
     {
         do
@@ -782,10 +952,10 @@ static bool ComputeHash(
             const auto sizeToRead = (left >= block ? block : left);
             left -= (left >= block ? block : left);
 
-            const Buffer buffer = object->GetData().CopyToBuffer(offset, static_cast<uint32>(sizeToRead), true);
+            Buffer buffer = object->GetData().CopyToBuffer(offset, static_cast<uint32>(sizeToRead), true);
             CHECK(buffer.IsValid(), false, "");
 
-            CHECK(UpdateHashOnBuffer(buffer), false, "");
+            CHECK(pipeline.Push(std::move(buffer)), false, "");
 
             offset += sizeToRead;
         } while (left > 0);
@@ -793,11 +963,12 @@ static bool ComputeHash(
         return true;
     };
 
+    auto result = true;
     if (computeForFile)
     {
         const auto offset = 0ULL;
         const auto left   = object->GetData().GetSize();
-        CHECK(UpdateHashOnBlock(offset, left), false, "");
+        result            = UpdateHashOnBlock(offset, left);
     }
     else
     {
@@ -805,9 +976,19 @@ static bool ComputeHash(
         {
             const auto offset = sz.start;
             const auto left   = sz.end - sz.start + 1;
-            CHECK(UpdateHashOnBlock(offset, left), false, "");
+            if (!(result = UpdateHashOnBlock(offset, left)))
+                break;
         }
     }
+    // always wait for the workers (they use the hash objects from this stack frame)
+    CHECK(pipeline.Finish() && result, false, "");
+
+    // the block digests and the digests of the file are written in the cache file only once
+    HashCache::Batch cacheBatch(computeForFile ? object : Reference<GView::Object>(nullptr));
+    if (computeBlocks && sha256Blocks.Final())
+    {
+        HashCache::AddBlocks(object, GetHashName(Hashes::SHA256), 0, objectSize, HashCache::DEFAULT_BLOCK_SIZE, sha256Blocks.GetBlocks());
+    }
 
     NumericFormatter nf;
     for (const auto& hash : hashList)
@@ -886,7 +1067,7 @@ static bool ComputeHash(
             outputs.emplace(std::pair{ "SHA3_384", sha3_384.GetHexValue() });
             break;
         case Hashes::SHA3_512:
-            sha3_384.Final();
+            sha3_512.Final();
             outputs.emplace(std::pair{ "SHA3_512", sha3_512.GetHexValue() });
             break;
         case Hashes::SHAKE128:
@@ -902,6 +1083,11 @@ static bool ComputeHash(
         }
     }
 
+    if (computeForFile)
+    {
+        HashCache::Add(object, 0, objectSize, outputs);
+    }
+
     return true;
 }
 } // namespace GView::GenericPlugins::Hashes
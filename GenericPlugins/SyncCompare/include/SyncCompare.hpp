@@ -1,17 +1,149 @@
 #pragma once
 
 #include "GView.hpp"
+#include <atomic>
 #include <cmath>
+#include <mutex>
+#include <thread>
 
 namespace GView::GenericPlugins::SyncCompare
 {
 using namespace AppCUI::Graphics;
 using namespace GView::View;
 
+namespace Kernel
+{
+    // first position where "all the buffers have the same byte" is `equal` (length if there is none)
+    size_t FindFirst(const uint8* const* buffers, uint32 count, size_t length, bool equal);
+    // first position with a byte different than `value` (length if there is none)
+    size_t FindFirstDifferentFrom(const uint8* buffer, size_t length, uint8 value);
+} // namespace Kernel
+
+// a Buffer View window that takes part in the comparison
+struct SyncedView {
+    Reference<ViewControl> view;
+    Reference<Object> object;
+    ViewData data;
+    int64 alignment; // data.viewStartOffset - (the same for the first view)
+};
+
+/*
+    Ranges where the synced objects differ, in offsets of the first object (offset p is compared with p + alignment in
+    every other object). It is built in background, through separate file handles, and it is valid only for the
+    alignment of the views it was built for. Until it is complete, the part that was not indexed yet is scanned directly.
+*/
+class DiffIndex
+{
+    static constexpr uint32 BLOCK_SIZE        = 0x100000;
+    static constexpr size_t MAX_DIFFERENCES   = 1 << 20; // bounded memory: the rest of the range is scanned directly
+    static constexpr uint64 NO_OPEN_DIFFERENCE = GView::Utils::INVALID_OFFSET;
+
+    std::vector<std::u16string> paths;
+    std::vector<int64> alignments;
+    std::vector<uint64> sizes;
+    bool filesOnly{ false };
+    uint64 start{ 0 };
+    uint64 end{ 0 };
+
+    mutable std::mutex lock;
+    std::vector<std::pair<uint64, uint64>> differences; // [start, end) - sorted
+    uint64 indexedEnd{ 0 };
+    uint64 openDifference{ NO_OPEN_DIFFERENCE }; // a difference that starts before indexedEnd and is not closed yet
+
+    std::atomic<bool> stopRequested{ false };
+    std::thread worker;
+
+    void Build();
+    bool AddDifference(uint64 differenceStart, uint64 differenceEnd);
+
+  public:
+    ~DiffIndex();
+
+    // offsets (of the first object) that exist in all the objects
+    static bool GetCommonRange(const std::vector<SyncedView>& views, uint64& start, uint64& end);
+
+    bool Start(const std::vector<SyncedView>& views);
+    void Stop();
+    bool IsBuiltFor(const std::vector<SyncedView>& views) const;
+
+    // std::nullopt => not indexed (yet)
+    std::optional<bool> IsEqual(uint64 position) const;
+    // true if `result` is the answer, false if the search must continue (directly) from `result`
+    bool FindNextDifference(uint64 position, uint64& result) const;
+    // the same, searching backwards (INVALID_OFFSET if there is no previous difference) - the part from `result` up to
+    // `position` is not indexed yet when it returns false
+    bool FindPreviousDifference(uint64 position, uint64& result) const;
+};
+
+/*
+    Alignment of the objects with insertions, deletions and moved blocks. Every object is split in content defined chunks
+    (a boundary depends only on the previous 64 bytes - gear rolling hash - so an insertion changes only the chunks around
+    it) and the chunks of each object are matched against the chunks of the first (reference) object: the hashes that are
+    unique in both objects are anchors, the longest increasing sequence of anchors is kept and then extended to the
+    neighbour chunks. The matched chunks form segments that map offsets between the reference and every other object.
+*/
+class Alignment
+{
+  public:
+    struct Segment {
+        uint64 reference; // offset in the reference object
+        uint64 offset;    // offset in the aligned object
+        uint64 size;
+    };
+
+  private:
+    struct Chunk {
+        uint64 hash;
+        uint32 size;
+    };
+
+    static constexpr uint64 SEGMENT_SIZE   = 0x1000000; // bytes processed by one task
+    static constexpr uint64 MAX_CHUNKS     = 1 << 20;   // per object (bounded memory)
+    static constexpr uint32 MIN_CHUNK_SIZE = 0x800;
+
+    std::vector<Reference<Object>> objects;
+    std::vector<std::u16string> paths; // a closed window frees its object => the address alone is not enough
+    std::vector<uint64> sizes;
+    std::vector<std::vector<Segment>> mappings;                  // mappings[i] = segments of object i (empty for the reference)
+    std::vector<std::pair<uint64, uint64>> alignedInAllObjects; // [start, end) in the reference object
+
+    static std::vector<Segment> Match(const std::vector<Chunk>& reference, const std::vector<Chunk>& chunks);
+    int32 GetIndex(Reference<Object> object) const;
+
+  public:
+    bool Compute(const std::vector<SyncedView>& views);
+    void Clear();
+    bool IsValid() const
+    {
+        return !objects.empty();
+    }
+    // false if one of the aligned objects is no longer shown (closed window or another view)
+    bool IsBuiltFor(const std::vector<SyncedView>& views) const;
+
+    uint64 ToObject(Reference<Object> object, uint64 referenceOffset) const;
+    uint64 ToReference(Reference<Object> object, uint64 offset) const;
+    bool IsAligned(uint64 referenceOffset) const;
+    // offsets in the reference object (INVALID_OFFSET if there is none)
+    uint64 FindNextUnaligned(uint64 referenceOffset) const;
+    uint64 FindPreviousUnaligned(uint64 referenceOffset) const;
+};
+
 class Plugin : public Window, public Handlers::OnButtonPressedInterface, public BufferColorInterface, public OnStartViewMoveInterface
 {
     Reference<ListView> list;
     Reference<CheckBox> sync;
+    Reference<CheckBox> align;
+    DiffIndex diffIndex;
+    Alignment alignment;
+    std::vector<SyncedView> syncedViews; // refreshed once per paint (OnPaintStart)
+    int32 paintedView{ -1 };             // index in syncedViews of the view that is painted
+
+    static bool GetSyncedViews(std::vector<SyncedView>& views);
+    // the synced views, and the alignment is dropped if it was computed for other objects
+    bool GetCurrentViews(std::vector<SyncedView>& views);
+    void UpdateDiffIndex(const std::vector<SyncedView>& views);
+    static bool ScanForDifference(const std::vector<SyncedView>& views, uint64 from, uint64 to, bool last, uint64& result);
+    void MoveViews(std::vector<SyncedView>& views, uint64 position);
 
   public:
     Plugin();
@@ -20,11 +152,13 @@ class Plugin : public Window, public Handlers::OnButtonPressedInterface, public
     void Update();
     void SetAllWindowsWithGivenViewName(const std::string_view& viewName);
     void ArrangeFilteredWindows(const std::string_view& filterName);
+    void OnPaintStart(const ViewData& vd) override;
     bool GetColorForByteAt(uint64 offset, const ViewData& vd, ColorPair& cp) override;
     virtual bool GenerateActionOnMove(Reference<Control> sender, int64 deltaStartView, const ViewData& vd) override;
     void SetUpCallbackForViews(bool remove);
     bool ToggleSync();
     bool FindNextDifference();
+    bool FindPreviousDifference();
     static bool FindNextDifferentCharacter();
 };
 } // namespace GView::GenericPlugins::SyncCompare
@@ -0,0 +1,597 @@
+#include "SyncCompare.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <condition_variable>
+#include <unordered_map>
+
+namespace GView::GenericPlugins::SyncCompare
+{
+namespace
+{
+    constexpr uint32 ROLLING_WINDOW = 64; // the gear hash is shifted once per byte => it depends only on the last 64 bytes
+
+    constexpr std::array<uint64, 256> MakeGearTable()
+    {
+        std::array<uint64, 256> table{};
+        uint64 state = 0x2545F4914F6CDD1DULL;
+        for (auto& value : table)
+        {
+            // splitmix64
+            state += 0x9E3779B97F4A7C15ULL;
+            auto z = state;
+            z      = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z      = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            value  = z ^ (z >> 31);
+        }
+        return table;
+    }
+    constexpr auto GEAR = MakeGearTable();
+
+    uint64 HashChunk(const uint8* p, size_t size)
+    {
+        constexpr uint64 K1 = 0x87C37B91114253D5ULL;
+        constexpr uint64 K2 = 0x4CF5AD432745937FULL;
+
+        uint64 h = 0x9E3779B97F4A7C15ULL ^ size;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            uint64 w;
+            memcpy(&w, p + i, sizeof(w));
+            h = std::rotl(h ^ (std::rotl(w * K1, 31) * K2), 27) * 5 + 0x52DCE729;
+        }
+        uint64 tail = 0;
+        for (size_t shift = 0; i < size; i++, shift += 8)
+        {
+            tail |= static_cast<uint64>(p[i]) << shift;
+        }
+        h ^= std::rotl(tail * K1, 31) * K2;
+
+        // fmix64
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // every worker reads through its own file handles (the caches of the objects are used by the views)
+    class Reader
+    {
+        const std::vector<Object*>& objects;
+        std::mutex& cacheLock;
+        std::vector<std::unique_ptr<AppCUI::OS::File>> files;
+
+      public:
+        Reader(const std::vector<Object*>& objects, std::mutex& cacheLock) : objects(objects), cacheLock(cacheLock), files(objects.size())
+        {
+        }
+        ~Reader()
+        {
+            for (auto& f : files)
+            {
+                if (f)
+                {
+                    f->Close();
+                }
+            }
+        }
+        bool Read(uint32 index, uint64 offset, uint32 size, Buffer& buffer)
+        {
+            auto object = objects[index];
+            if (object->GetObjectType() == Object::Type::File)
+            {
+                if (!files[index])
+                {
+                    files[index] = std::make_unique<AppCUI::OS::File>();
+                    CHECK(files[index]->OpenRead(std::filesystem::path(object->GetPath())), false, "Fail to open the file");
+                }
+                buffer.Resize(size);
+                CHECK(files[index]->SetCurrentPos(offset), false, "");
+                CHECK(files[index]->Read(buffer.GetData(), size), false, "Fail to read %u bytes from %llu", size, offset);
+                return true;
+            }
+            std::lock_guard<std::mutex> guard(cacheLock);
+            buffer = object->GetData().CopyToBuffer(offset, size, true);
+            return buffer.GetLength() == size;
+        }
+    };
+
+    // runs all the tasks on all the cores (the calling thread shows the progress and can cancel them)
+    template <typename Task>
+    bool RunTasks(const char* title, uint32 count, const std::vector<Object*>& objects, Task&& task)
+    {
+        std::atomic<uint32> next{ 0 };
+        std::atomic<bool> failed{ false };
+        std::atomic<bool> stop{ false };
+        bool canceled = false;
+        std::mutex lock;
+        std::mutex cacheLock;
+        std::condition_variable taskDone;
+        uint32 done     = 0;
+        uint32 finished = 0;
+
+        const auto threadsCount = std::min<uint32>(std::max<uint32>(std::thread::hardware_concurrency(), 1), std::max<uint32>(count, 1));
+        std::vector<std::thread> workers;
+        for (uint32 idx = 0; idx < threadsCount; idx++)
+        {
+            workers.emplace_back(
+                  [&]()
+                  {
+                      Reader reader(objects, cacheLock);
+                      while (!stop)
+                      {
+                          const auto index = next++;
+                          if (index >= count)
+                          {
+                              break;
+                          }
+                          if (!task(index, reader))
+                          {
+                              failed = true;
+                              stop   = true;
+                          }
+                          std::lock_guard<std::mutex> guard(lock);
+                          done++;
+                          taskDone.notify_one();
+                      }
+                      std::lock_guard<std::mutex> guard(lock);
+                      finished++;
+                      taskDone.notify_one();
+                  });
+        }
+
+        ProgressStatus::Init(title, count);
+        LocalString<128> ls;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            while (finished < threadsCount)
+            {
+                taskDone.wait_for(guard, std::chrono::milliseconds(100));
+                const auto current = done;
+                guard.unlock();
+                if (ProgressStatus::Update(current, ls.Format("[%u/%u] blocks...", current, count)))
+                {
+                    canceled = true;
+                    stop     = true;
+                }
+                guard.lock();
+            }
+        }
+        for (auto& t : workers)
+        {
+            t.join();
+        }
+        return !failed && !canceled;
+    }
+} // namespace
+
+bool Alignment::Compute(const std::vector<SyncedView>& views)
+{
+    Clear();
+    CHECK(views.size() > 1, false, "");
+
+    std::vector<Object*> objects;
+    std::vector<std::u16string> paths;
+    uint64 maxSize = 0;
+    for (const auto& v : views)
+    {
+        objects.push_back(v.object.operator->());
+        paths.emplace_back(v.object->GetPath());
+        sizes.push_back(v.object->GetData().GetSize());
+        maxSize = std::max<uint64>(maxSize, sizes.back());
+    }
+
+    // the same (average) chunk size for all objects, so that there are at most MAX_CHUNKS chunks in each of them
+    uint64 averageSize = MIN_CHUNK_SIZE;
+    while (maxSize / averageSize > MAX_CHUNKS)
+    {
+        averageSize *= 2;
+    }
+    const auto bits         = std::countr_zero(averageSize);
+    const auto minChunkSize = averageSize / 4;
+    const auto maxChunkSize = averageSize * 8;
+
+    struct Task {
+        uint32 object;
+        uint64 start;
+        uint64 end;
+    };
+    std::vector<Task> tasks;
+    for (uint32 idx = 0; idx < objects.size(); idx++)
+    {
+        for (uint64 start = 0; start < sizes[idx]; start += SEGMENT_SIZE)
+        {
+            tasks.push_back({ idx, start, std::min<uint64>(start + SEGMENT_SIZE, sizes[idx]) });
+        }
+    }
+
+    // 1. the positions where the rolling hash allows a boundary (independent for every segment)
+    std::vector<std::vector<uint64>> candidates(tasks.size());
+    auto findCandidates = [&](uint32 index, Reader& reader) -> bool
+    {
+        const auto& t    = tasks[index];
+        const auto first = t.start - std::min<uint64>(t.start, ROLLING_WINDOW);
+        Buffer buffer;
+        CHECK(reader.Read(t.object, first, static_cast<uint32>(t.end - first), buffer), false, "");
+
+        auto& result = candidates[index];
+        auto p       = buffer.GetData();
+        uint64 hash  = 0;
+        for (uint64 pos = first; pos < t.end; pos++)
+        {
+            hash = (hash << 1) + GEAR[p[pos - first]];
+            if ((pos >= t.start) && ((hash >> (64 - bits)) == 0))
+            {
+                result.push_back(pos + 1); // boundary after this byte
+            }
+        }
+        return true;
+    };
+    CHECK(RunTasks("Chunking...", static_cast<uint32>(tasks.size()), objects, findCandidates), false, "");
+
+    // 2. the chunks (a minimum size between boundaries, and a forced boundary if there is none for too long)
+    std::vector<std::vector<Chunk>> chunks(objects.size());
+    std::vector<std::vector<uint64>> starts(objects.size());
+    for (uint32 idx = 0; idx < tasks.size();)
+    {
+        const auto object = tasks[idx].object;
+        auto& c           = chunks[object];
+        auto& s           = starts[object];
+        uint64 last       = 0;
+        auto addBoundary  = [&](uint64 position)
+        {
+            while (position - last > maxChunkSize)
+            {
+                s.push_back(last);
+                c.push_back({ 0, static_cast<uint32>(maxChunkSize) });
+                last += maxChunkSize;
+            }
+            if (position - last >= minChunkSize)
+            {
+                s.push_back(last);
+                c.push_back({ 0, static_cast<uint32>(position - last) });
+                last = position;
+            }
+        };
+        for (; idx < tasks.size() && tasks[idx].object == object; idx++)
+        {
+            for (auto position : candidates[idx])
+            {
+                addBoundary(position);
+            }
+            candidates[idx] = {};
+        }
+        addBoundary(sizes[object]);
+        if (last < sizes[object])
+        {
+            s.push_back(last);
+            c.push_back({ 0, static_cast<uint32>(sizes[object] - last) });
+        }
+    }
+
+    // 3. the hash of every chunk (a task hashes the chunks that start in its segment)
+    auto hashChunks = [&](uint32 index, Reader& reader) -> bool
+    {
+        const auto& t = tasks[index];
+        const auto& s = starts[t.object];
+        auto& c       = chunks[t.object];
+        const auto b  = static_cast<size_t>(std::lower_bound(s.begin(), s.end(), t.start) - s.begin());
+        const auto e  = static_cast<size_t>(std::lower_bound(s.begin(), s.end(), t.end) - s.begin());
+        if (b == e)
+        {
+            return true;
+        }
+
+        const auto first = s[b];
+        Buffer buffer;
+        CHECK(reader.Read(t.object, first, static_cast<uint32>(s[e - 1] + c[e - 1].size - first), buffer), false, "");
+        for (auto k = b; k < e; k++)
+        {
+            c[k].hash = HashChunk(buffer.GetData() + (s[k] - first), c[k].size);
+        }
+        return true;
+    };
+    CHECK(RunTasks("Hashing...", static_cast<uint32>(tasks.size()), objects, hashChunks), false, "");
+
+    // 4. every object against the reference one
+    mappings.resize(objects.size());
+    for (uint32 idx = 1; idx < objects.size(); idx++)
+    {
+        mappings[idx] = Match(chunks[0], chunks[idx]);
+    }
+
+    // the parts of the reference that are aligned with all the other objects
+    for (uint32 idx = 1; idx < objects.size(); idx++)
+    {
+        std::vector<std::pair<uint64, uint64>> ranges;
+        for (const auto& segment : mappings[idx])
+        {
+            ranges.emplace_back(segment.reference, segment.reference + segment.size);
+        }
+        if (idx == 1)
+        {
+            alignedInAllObjects = std::move(ranges);
+            continue;
+        }
+
+        std::vector<std::pair<uint64, uint64>> intersection;
+        for (size_t a = 0, b = 0; a < alignedInAllObjects.size() && b < ranges.size();)
+        {
+            const auto low  = std::max<uint64>(alignedInAllObjects[a].first, ranges[b].first);
+            const auto high = std::min<uint64>(alignedInAllObjects[a].second, ranges[b].second);
+            if (low < high)
+            {
+                intersection.emplace_back(low, high);
+            }
+            if (alignedInAllObjects[a].second < ranges[b].second)
+            {
+                a++;
+            }
+            else
+            {
+                b++;
+            }
+        }
+        alignedInAllObjects = std::move(intersection);
+    }
+    // segments that follow each other in the reference (but not in the other objects) => a single range
+    size_t count = 0;
+    for (const auto& range : alignedInAllObjects)
+    {
+        if ((count > 0) && (alignedInAllObjects[count - 1].second == range.first))
+        {
+            alignedInAllObjects[count - 1].second = range.second;
+        }
+        else
+        {
+            alignedInAllObjects[count++] = range;
+        }
+    }
+    alignedInAllObjects.resize(count);
+
+    for (const auto& v : views)
+    {
+        this->objects.push_back(v.object);
+    }
+    this->paths = std::move(paths);
+    return true;
+}
+
+std::vector<Alignment::Segment> Alignment::Match(const std::vector<Chunk>& reference, const std::vector<Chunk>& chunks)
+{
+    constexpr size_t NOT_UNIQUE = static_cast<size_t>(-1);
+    constexpr size_t UNMATCHED  = static_cast<size_t>(-1);
+
+    // hash -> index (if the hash is unique)
+    auto indexHashes = [](const std::vector<Chunk>& list)
+    {
+        std::unordered_map<uint64, size_t> result;
+        result.reserve(list.size());
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            auto [it, inserted] = result.try_emplace(list[i].hash, i);
+            if (!inserted)
+            {
+                it->second = NOT_UNIQUE;
+            }
+        }
+        return result;
+    };
+    const auto referenceIndex = indexHashes(reference);
+    const auto chunksIndex    = indexHashes(chunks);
+
+    // anchors: (reference index, chunk index) for the hashes that are unique in both objects - ordered by chunk index
+    std::vector<std::pair<size_t, size_t>> anchors;
+    for (size_t j = 0; j < chunks.size(); j++)
+    {
+        auto it = referenceIndex.find(chunks[j].hash);
+        if ((it != referenceIndex.end()) && (it->second != NOT_UNIQUE) && (chunksIndex.at(chunks[j].hash) == j) &&
+            (reference[it->second].size == chunks[j].size))
+        {
+            anchors.emplace_back(it->second, j);
+        }
+    }
+
+    // longest sequence of anchors that is increasing in the reference too (patience sorting)
+    std::vector<size_t> tails;
+    std::vector<size_t> previous(anchors.size(), UNMATCHED);
+    for (size_t k = 0; k < anchors.size(); k++)
+    {
+        auto pos = std::lower_bound(
+                         tails.begin(), tails.end(), anchors[k].first, [&](size_t anchor, size_t value) { return anchors[anchor].first < value; }) -
+                   tails.begin();
+        if (pos > 0)
+        {
+            previous[k] = tails[pos - 1];
+        }
+        if (static_cast<size_t>(pos) == tails.size())
+        {
+            tails.push_back(k);
+        }
+        else
+        {
+            tails[pos] = k;
+        }
+    }
+
+    std::vector<size_t> referenceMatch(reference.size(), UNMATCHED);
+    std::vector<size_t> chunksMatch(chunks.size(), UNMATCHED);
+    std::vector<size_t> kept;
+    for (auto k = tails.empty() ? UNMATCHED : tails.back(); k != UNMATCHED; k = previous[k])
+    {
+        kept.push_back(k);
+    }
+    std::reverse(kept.begin(), kept.end());
+    for (auto k : kept)
+    {
+        referenceMatch[anchors[k].first] = anchors[k].second;
+        chunksMatch[anchors[k].second]   = anchors[k].first;
+    }
+
+    // extend the anchors to the neighbour chunks that are equal (but not unique)
+    auto same = [&](size_t i, size_t j)
+    { return (referenceMatch[i] == UNMATCHED) && (chunksMatch[j] == UNMATCHED) && (reference[i].hash == chunks[j].hash) && (reference[i].size == chunks[j].size); };
+    for (auto k : kept)
+    {
+        for (auto i = anchors[k].first + 1, j = anchors[k].second + 1; i < reference.size() && j < chunks.size() && same(i, j); i++, j++)
+        {
+            referenceMatch[i] = j;
+            chunksMatch[j]    = i;
+        }
+        for (auto i = anchors[k].first, j = anchors[k].second; i > 0 && j > 0 && same(i - 1, j - 1); i--, j--)
+        {
+            referenceMatch[i - 1] = j - 1;
+            chunksMatch[j - 1]    = i - 1;
+        }
+    }
+
+    // consecutive matched chunks => one segment
+    std::vector<Segment> segments;
+    uint64 referenceOffset = 0;
+    std::vector<uint64> offsets(chunks.size() + 1, 0);
+    for (size_t j = 0; j < chunks.size(); j++)
+    {
+        offsets[j + 1] = offsets[j] + chunks[j].size;
+    }
+    for (size_t i = 0; i < reference.size(); referenceOffset += reference[i].size, i++)
+    {
+        const auto j = referenceMatch[i];
+        if (j == UNMATCHED)
+        {
+            continue;
+        }
+        if (!segments.empty())
+        {
+            auto& last = segments.back();
+            if ((last.reference + last.size == referenceOffset) && (last.offset + last.size == offsets[j]))
+            {
+                last.size += reference[i].size;
+                continue;
+            }
+        }
+        segments.push_back({ referenceOffset, offsets[j], reference[i].size });
+    }
+    return segments;
+}
+
+void Alignment::Clear()
+{
+    objects.clear();
+    paths.clear();
+    sizes.clear();
+    mappings.clear();
+    alignedInAllObjects.clear();
+}
+
+int32 Alignment::GetIndex(Reference<Object> object) const
+{
+    for (size_t idx = 0; idx < objects.size(); idx++)
+    {
+        if (objects[idx] == object)
+        {
+            return static_cast<int32>(idx);
+        }
+    }
+    return -1;
+}
+
+bool Alignment::IsBuiltFor(const std::vector<SyncedView>& views) const
+{
+    if (views.size() != objects.size())
+    {
+        return false;
+    }
+    for (const auto& v : views)
+    {
+        const auto index = GetIndex(v.object);
+        if ((index < 0) || (v.object->GetData().GetSize() != sizes[index]) || (v.object->GetPath() != std::u16string_view(paths[index])))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64 Alignment::ToObject(Reference<Object> object, uint64 referenceOffset) const
+{
+    const auto index = GetIndex(object);
+    if (index <= 0)
+    {
+        return referenceOffset;
+    }
+
+    // inside a segment => the matching offset, between segments => the same distance from the previous segment
+    const auto& segments = mappings[index];
+    auto it     = std::partition_point(segments.begin(), segments.end(), [&](const Segment& s) { return s.reference <= referenceOffset; });
+    auto result = referenceOffset;
+    if (it != segments.begin())
+    {
+        const auto& s = *(it - 1);
+        result        = s.offset + (referenceOffset - s.reference);
+    }
+    if ((it != segments.end()) && (result >= it->offset))
+    {
+        result = it->offset > 0 ? it->offset - 1 : 0;
+    }
+    return std::min<uint64>(result, sizes[index] > 0 ? sizes[index] - 1 : 0);
+}
+
+uint64 Alignment::ToReference(Reference<Object> object, uint64 offset) const
+{
+    const auto index = GetIndex(object);
+    if (index <= 0)
+    {
+        return offset;
+    }
+
+    const auto& segments = mappings[index];
+    auto it     = std::partition_point(segments.begin(), segments.end(), [&](const Segment& s) { return s.offset <= offset; });
+    auto result = offset;
+    if (it != segments.begin())
+    {
+        const auto& s = *(it - 1);
+        result        = s.reference + (offset - s.offset);
+    }
+    if ((it != segments.end()) && (result >= it->reference))
+    {
+        result = it->reference > 0 ? it->reference - 1 : 0;
+    }
+    return std::min<uint64>(result, sizes[0] > 0 ? sizes[0] - 1 : 0);
+}
+
+bool Alignment::IsAligned(uint64 referenceOffset) const
+{
+    auto it = std::partition_point(
+          alignedInAllObjects.begin(), alignedInAllObjects.end(), [&](const auto& range) { return range.second <= referenceOffset; });
+    return (it != alignedInAllObjects.end()) && (it->first <= referenceOffset);
+}
+
+uint64 Alignment::FindNextUnaligned(uint64 referenceOffset) const
+{
+    CHECK(IsValid() && referenceOffset < sizes[0], GView::Utils::INVALID_OFFSET, "");
+    auto it = std::partition_point(
+          alignedInAllObjects.begin(), alignedInAllObjects.end(), [&](const auto& range) { return range.second <= referenceOffset; });
+    if ((it == alignedInAllObjects.end()) || (it->first > referenceOffset))
+    {
+        return referenceOffset;
+    }
+    return it->second < sizes[0] ? it->second : GView::Utils::INVALID_OFFSET;
+}
+
+uint64 Alignment::FindPreviousUnaligned(uint64 referenceOffset) const
+{
+    CHECK(IsValid() && referenceOffset > 0, GView::Utils::INVALID_OFFSET, "");
+    const auto position = std::min<uint64>(referenceOffset, sizes[0]) - 1;
+    auto it             = std::partition_point(
+          alignedInAllObjects.begin(), alignedInAllObjects.end(), [&](const auto& range) { return range.second <= position; });
+    if ((it == alignedInAllObjects.end()) || (it->first > position))
+    {
+        return position;
+    }
+    return it->first > 0 ? it->first - 1 : GView::Utils::INVALID_OFFSET;
+}
+} // namespace GView::GenericPlugins::SyncCompare
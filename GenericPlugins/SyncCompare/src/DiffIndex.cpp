@@ -0,0 +1,336 @@
+#include "SyncCompare.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define SYNC_COMPARE_SSE2
+#    include <emmintrin.h>
+#endif
+
+namespace GView::GenericPlugins::SyncCompare
+{
+namespace Kernel
+{
+    size_t FindFirst(const uint8* const* buffers, uint32 count, size_t length, bool equal)
+    {
+        if (count < 2)
+        {
+            return equal ? 0 : length;
+        }
+
+        size_t i = 0;
+#ifdef SYNC_COMPARE_SSE2
+        // 16 bytes at a time: a bit of the mask is set if all the buffers have the same byte at that position
+        for (; i + 16 <= length; i += 16)
+        {
+            const auto first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffers[0] + i));
+            auto same        = _mm_set1_epi8(-1);
+            for (uint32 b = 1; b < count; b++)
+            {
+                same = _mm_and_si128(same, _mm_cmpeq_epi8(first, _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffers[b] + i))));
+            }
+            auto mask = static_cast<uint32>(_mm_movemask_epi8(same));
+            if (!equal)
+            {
+                mask = (~mask) & 0xFFFF;
+            }
+            if (mask != 0)
+            {
+                return i + std::countr_zero(mask);
+            }
+        }
+#else
+        // 8 bytes at a time: a byte of diff is 0 if all the buffers have the same byte at that position
+        constexpr uint64 LOW_BITS  = 0x0101010101010101ULL;
+        constexpr uint64 HIGH_BITS = 0x8080808080808080ULL;
+        for (; i + 8 <= length; i += 8)
+        {
+            uint64 first, diff = 0;
+            memcpy(&first, buffers[0] + i, sizeof(first));
+            for (uint32 b = 1; b < count; b++)
+            {
+                uint64 value;
+                memcpy(&value, buffers[b] + i, sizeof(value));
+                diff |= first ^ value;
+            }
+            const auto hasEqualByte = ((diff - LOW_BITS) & ~diff & HIGH_BITS) != 0;
+            if ((equal && hasEqualByte) || (!equal && diff != 0))
+            {
+                break; // the exact position is found below
+            }
+        }
+#endif
+        for (; i < length; i++)
+        {
+            const auto value = buffers[0][i];
+            bool same        = true;
+            for (uint32 b = 1; (b < count) && same; b++)
+            {
+                same = buffers[b][i] == value;
+            }
+            if (same == equal)
+            {
+                return i;
+            }
+        }
+        return length;
+    }
+
+    size_t FindFirstDifferentFrom(const uint8* buffer, size_t length, uint8 value)
+    {
+        size_t i = 0;
+#ifdef SYNC_COMPARE_SSE2
+        const auto pattern = _mm_set1_epi8(static_cast<char>(value));
+        for (; i + 16 <= length; i += 16)
+        {
+            const auto same = _mm_cmpeq_epi8(pattern, _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + i)));
+            const auto mask = (~static_cast<uint32>(_mm_movemask_epi8(same))) & 0xFFFF;
+            if (mask != 0)
+            {
+                return i + std::countr_zero(mask);
+            }
+        }
+#endif
+        for (; i < length; i++)
+        {
+            if (buffer[i] != value)
+            {
+                return i;
+            }
+        }
+        return length;
+    }
+} // namespace Kernel
+
+DiffIndex::~DiffIndex()
+{
+    Stop();
+}
+
+bool DiffIndex::GetCommonRange(const std::vector<SyncedView>& views, uint64& start, uint64& end)
+{
+    int64 first = 0;
+    int64 last  = std::numeric_limits<int64>::max();
+    for (const auto& v : views)
+    {
+        first = std::max<int64>(first, -v.alignment);
+        last  = std::min<int64>(last, static_cast<int64>(v.object->GetData().GetSize()) - v.alignment);
+    }
+    start = static_cast<uint64>(first);
+    end   = static_cast<uint64>(std::max<int64>(first, last));
+    return start < end;
+}
+
+bool DiffIndex::IsBuiltFor(const std::vector<SyncedView>& views) const
+{
+    if (views.size() != alignments.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < views.size(); i++)
+    {
+        if ((views[i].alignment != alignments[i]) || (views[i].object->GetData().GetSize() != sizes[i]) ||
+            (views[i].object->GetPath() != std::u16string_view(paths[i])))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DiffIndex::Start(const std::vector<SyncedView>& views)
+{
+    Stop();
+
+    paths.clear();
+    alignments.clear();
+    sizes.clear();
+    filesOnly = true;
+    for (const auto& v : views)
+    {
+        paths.emplace_back(v.object->GetPath());
+        alignments.push_back(v.alignment);
+        sizes.push_back(v.object->GetData().GetSize());
+        filesOnly &= v.object->GetObjectType() == Object::Type::File;
+    }
+    GetCommonRange(views, start, end);
+
+    differences.clear();
+    indexedEnd     = start;
+    openDifference = NO_OPEN_DIFFERENCE;
+
+    // the caches of the objects are used by the views => only files (that can be opened again) are indexed
+    if ((filesOnly == false) || (views.size() < 2))
+    {
+        return false;
+    }
+    stopRequested = false;
+    worker        = std::thread([this]() { Build(); });
+    return true;
+}
+
+void DiffIndex::Stop()
+{
+    stopRequested = true;
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+}
+
+bool DiffIndex::AddDifference(uint64 differenceStart, uint64 differenceEnd)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    CHECK(differences.size() < MAX_DIFFERENCES, false, "Too many differences - the rest of the objects is not indexed");
+    differences.emplace_back(differenceStart, differenceEnd);
+    return true;
+}
+
+void DiffIndex::Build()
+{
+    const auto count = static_cast<uint32>(paths.size());
+    std::vector<std::unique_ptr<AppCUI::OS::File>> files;
+    std::vector<std::vector<uint8>> buffers(count, std::vector<uint8>(BLOCK_SIZE));
+    std::vector<const uint8*> pointers(count);
+    for (const auto& path : paths)
+    {
+        auto& f = files.emplace_back(std::make_unique<AppCUI::OS::File>());
+        CHECKRET(f->OpenRead(std::filesystem::path(path)), "Fail to open the file");
+    }
+
+    bool inDifference      = false;
+    uint64 differenceStart = 0;
+    uint64 position        = start;
+    while ((position < end) && !stopRequested)
+    {
+        const auto length = static_cast<uint32>(std::min<uint64>(BLOCK_SIZE, end - position));
+        for (uint32 i = 0; i < count; i++)
+        {
+            const auto offset = static_cast<uint64>(static_cast<int64>(position) + alignments[i]);
+            CHECKRET(files[i]->SetCurrentPos(offset) && files[i]->Read(buffers[i].data(), length), "Fail to read %u bytes from %llu", length, offset);
+        }
+
+        // alternate between searching for the first difference and for the first position where all are equal again
+        size_t current = 0;
+        while (current < length)
+        {
+            for (uint32 i = 0; i < count; i++)
+            {
+                pointers[i] = buffers[i].data() + current;
+            }
+            current += Kernel::FindFirst(pointers.data(), count, length - current, inDifference);
+            if (current == length)
+            {
+                break;
+            }
+            if (inDifference)
+            {
+                CHECKRET(AddDifference(differenceStart, position + current), "");
+            }
+            else
+            {
+                differenceStart = position + current;
+            }
+            inDifference = !inDifference;
+        }
+
+        position += length;
+        std::lock_guard<std::mutex> guard(lock);
+        indexedEnd     = position;
+        openDifference = inDifference ? differenceStart : NO_OPEN_DIFFERENCE;
+    }
+
+    if ((position == end) && inDifference && AddDifference(differenceStart, end))
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        openDifference = NO_OPEN_DIFFERENCE;
+    }
+    for (auto& f : files)
+    {
+        f->Close();
+    }
+}
+
+std::optional<bool> DiffIndex::IsEqual(uint64 position) const
+{
+    if ((position < start) || (position >= end))
+    {
+        return false; // not all objects have this offset
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (position >= indexedEnd)
+    {
+        return std::nullopt;
+    }
+    if ((openDifference != NO_OPEN_DIFFERENCE) && (position >= openDifference))
+    {
+        return false;
+    }
+    auto it = std::partition_point(differences.begin(), differences.end(), [position](const auto& d) { return d.second <= position; });
+    return (it == differences.end()) || (it->first > position);
+}
+
+bool DiffIndex::FindNextDifference(uint64 position, uint64& result) const
+{
+    result = position;
+    if ((position < start) || (position >= end))
+    {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (position >= indexedEnd)
+    {
+        return false;
+    }
+    auto it = std::partition_point(differences.begin(), differences.end(), [position](const auto& d) { return d.second <= position; });
+    if (it != differences.end())
+    {
+        result = std::max<uint64>(it->first, position);
+        return true;
+    }
+    if (openDifference != NO_OPEN_DIFFERENCE)
+    {
+        result = std::max<uint64>(openDifference, position);
+        return true;
+    }
+    if (indexedEnd == end)
+    {
+        result = end; // one of the objects ends here
+        return true;
+    }
+    result = indexedEnd;
+    return false;
+}
+
+bool DiffIndex::FindPreviousDifference(uint64 position, uint64& result) const
+{
+    if ((position <= start) || (position > end))
+    {
+        result = position > 0 ? position - 1 : GView::Utils::INVALID_OFFSET;
+        return true;
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (position > indexedEnd)
+    {
+        result = indexedEnd;
+        return false;
+    }
+    if ((openDifference != NO_OPEN_DIFFERENCE) && (openDifference < position))
+    {
+        result = position - 1;
+        return true;
+    }
+    auto it = std::partition_point(differences.begin(), differences.end(), [position](const auto& d) { return d.first < position; });
+    if (it != differences.begin())
+    {
+        result = std::min<uint64>((it - 1)->second, position) - 1;
+        return true;
+    }
+    result = start > 0 ? start - 1 : GView::Utils::INVALID_OFFSET;
+    return true;
+}
+} // namespace GView::GenericPlugins::SyncCompare
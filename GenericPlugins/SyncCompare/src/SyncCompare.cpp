@@ -1,6 +1,6 @@
 #include "SyncCompare.hpp"
 
-#include <unordered_map>
+#include <algorithm>
 #include <vector>
 
 using namespace AppCUI;
@@ -28,6 +28,9 @@ Plugin::Plugin() : Window("SyncCompare", "d:c,w:140,h:40", WindowFlags::FixedPos
     sync = Factory::CheckBox::Create(this, "&Sync windows", "x:2%,y:1,w:30");
     sync->SetChecked(false);
 
+    align = Factory::CheckBox::Create(this, "&Align insertions/deletions", "x:35%,y:1,w:40");
+    align->SetChecked(false);
+
     list = Factory::ListView::Create(
           this,
           "x:2%,y:3,w:96%,h:80%",
@@ -54,6 +57,11 @@ void Plugin::OnButtonPressed(Reference<Button> button)
     case BTN_ID_OK:
         SetAllWindowsWithGivenViewName(VIEW_NAME);
         ArrangeFilteredWindows(VIEW_NAME);
+        alignment.Clear();
+        if (align->IsChecked() && GetSyncedViews(syncedViews))
+        {
+            alignment.Compute(syncedViews);
+        }
         SetUpCallbackForViews(false);
         this->Exit(Dialogs::Result::Ok);
         break;
@@ -230,48 +238,193 @@ void Plugin::ArrangeFilteredWindows(const std::string_view& filterName)
     }
 }
 
-bool Plugin::GetColorForByteAt(uint64 offset, const ViewData& vd, ColorPair& cp)
+bool Plugin::GetSyncedViews(std::vector<SyncedView>& views)
 {
+    views.clear();
+
     auto desktop         = AppCUI::Application::GetDesktop();
     const auto windowsNo = desktop->GetChildrenCount();
-    CHECK(windowsNo > 1, false, "");
-
-    std::unordered_map<unsigned char, uint32> bytes;
-
-    CHECK(vd.viewStartOffset <= offset, false, "");
-    const auto deltaOffset = offset - vd.viewStartOffset;
-
     for (uint32 i = 0; i < windowsNo; i++)
     {
         auto window    = desktop->GetChild(i);
         auto interface = window.ToObjectRef<GView::View::WindowInterface>();
-        auto& data     = interface->GetObject()->GetData();
+        auto view      = interface->GetCurrentView();
+        if (view->GetName() != VIEW_NAME)
+        {
+            continue;
+        }
+
+        auto& sv  = views.emplace_back();
+        sv.view   = view;
+        sv.object = interface->GetObject();
+        CHECK(view->GetViewData(sv.data, GView::Utils::INVALID_OFFSET), false, "");
+        sv.alignment = static_cast<int64>(sv.data.viewStartOffset) - static_cast<int64>(views[0].data.viewStartOffset);
+    }
 
-        ViewData viewData{}; // we assume that current view is what we want (buffer view)
-        CHECK(interface->GetCurrentView()->GetViewData(viewData, GView::Utils::INVALID_OFFSET), false, "");
+    return views.size() > 1;
+}
 
-        uint64 thisOffset = viewData.viewStartOffset + deltaOffset;
-        const auto buffer = data.Get(thisOffset, 1, true);
-        if (buffer.IsValid())
+bool Plugin::GetCurrentViews(std::vector<SyncedView>& views)
+{
+    CHECK(GetSyncedViews(views), false, "");
+    if (alignment.IsValid() && alignment.IsBuiltFor(views) == false)
+    {
+        alignment.Clear(); // one of the aligned windows was closed (or shows another object)
+    }
+    return true;
+}
+
+void Plugin::UpdateDiffIndex(const std::vector<SyncedView>& views)
+{
+    // the index is built for the relative position of the views (moving them while they are synced keeps it valid)
+    if (diffIndex.IsBuiltFor(views) == false)
+    {
+        diffIndex.Start(views);
+    }
+}
+
+bool Plugin::ScanForDifference(const std::vector<SyncedView>& views, uint64 from, uint64 to, bool last, uint64& result)
+{
+    uint32 chunk = 0xFFFFFFFF;
+    for (const auto& v : views)
+    {
+        chunk = std::min<uint32>(chunk, std::max<uint32>(v.object->GetData().GetCacheSize() / 2, 1));
+    }
+
+    std::vector<BufferView> buffers(views.size());
+    std::vector<const uint8*> pointers(views.size());
+    bool found = false;
+    while (from < to)
+    {
+        auto length = static_cast<uint32>(std::min<uint64>(chunk, to - from));
+        for (size_t i = 0; i < views.size(); i++)
+        {
+            const auto offset = static_cast<uint64>(static_cast<int64>(from) + views[i].alignment);
+            buffers[i]        = views[i].object->GetData().Get(offset, length, false);
+            length            = std::min<uint32>(length, static_cast<uint32>(buffers[i].GetLength()));
+        }
+        CHECK(length > 0, found, "");
+        for (size_t i = 0; i < views.size(); i++)
         {
-            ++bytes[buffer.GetData()[0]];
+            pointers[i] = buffers[i].GetData();
+        }
+
+        const auto count = static_cast<uint32>(views.size());
+        auto current     = Kernel::FindFirst(pointers.data(), count, length, false);
+        if (current < length && !last)
+        {
+            result = from + current;
+            return true;
         }
+        while (current < length)
+        {
+            // the last byte of every different range
+            for (size_t i = 0; i < views.size(); i++)
+            {
+                pointers[i] = buffers[i].GetData() + current;
+            }
+            current += Kernel::FindFirst(pointers.data(), count, length - current, true);
+            result = from + current - 1;
+            found  = true;
+            for (size_t i = 0; i < views.size(); i++)
+            {
+                pointers[i] = buffers[i].GetData() + current;
+            }
+            current += Kernel::FindFirst(pointers.data(), count, length - current, false);
+        }
+        from += length;
     }
 
-    if (bytes.size() == 1 && bytes.at(vd.byte) == windowsNo)
+    return found;
+}
+
+void Plugin::MoveViews(std::vector<SyncedView>& views, uint64 position)
+{
+    for (auto& v : views)
     {
-        cp = MATCH_COMPLETE;
-        return true;
+        // position is an offset in the reference object (aligned views) or in the first view
+        const auto offset = alignment.IsValid() ? alignment.ToObject(v.object, position) : static_cast<uint64>(static_cast<int64>(position) + v.alignment);
+
+        v.view->OnEvent(nullptr, AppCUI::Controls::Event::Command, View::VIEW_COMMAND_DEACTIVATE_SYNC);
+
+        v.view->GoTo(offset); // moves the cursor
+        v.view->GoTo(offset); // moves the start view
+
+        v.view->OnEvent(nullptr, AppCUI::Controls::Event::Command, sync->IsChecked() ? View::VIEW_COMMAND_ACTIVATE_SYNC : View::VIEW_COMMAND_DEACTIVATE_SYNC);
+    }
+}
+
+void Plugin::OnPaintStart(const ViewData& vd)
+{
+    // the desktop walk and the index check are done once per paint => a colored byte is only a lookup
+    paintedView = -1;
+    CHECKRET(GetCurrentViews(syncedViews), "");
+    if (alignment.IsValid() == false)
+    {
+        UpdateDiffIndex(syncedViews);
     }
 
-    if (bytes.size() < windowsNo)
+    auto it = std::find_if(syncedViews.begin(), syncedViews.end(), [&](const SyncedView& v) { return v.object == vd.object; });
+    CHECKRET(it != syncedViews.end(), "");
+    paintedView = static_cast<int32>(it - syncedViews.begin());
+}
+
+bool Plugin::GetColorForByteAt(uint64 offset, const ViewData& vd, ColorPair& cp)
+{
+    CHECK(vd.viewStartOffset <= offset, false, "");
+    CHECK(paintedView >= 0 && syncedViews[paintedView].object == vd.object, false, "");
+    const auto& painted = syncedViews[paintedView];
+
+    uint64 position = 0;
+    if (alignment.IsValid())
     {
-        if (bytes.at(vd.byte) >= 2)
+        position = alignment.ToReference(painted.object, offset);
+        if (alignment.IsAligned(position))
         {
-            cp = MATCH_PARTIAL;
+            cp = MATCH_COMPLETE;
             return true;
         }
     }
+    else
+    {
+        CHECK(static_cast<int64>(offset) >= painted.alignment, false, "");
+        position         = static_cast<uint64>(static_cast<int64>(offset) - painted.alignment);
+        const auto equal = diffIndex.IsEqual(position);
+        if (equal.has_value() && equal.value())
+        {
+            cp = MATCH_COMPLETE;
+            return true;
+        }
+    }
+
+    // different (or not indexed yet) => count the objects that have the same byte
+    uint32 matches = 0;
+    for (const auto& v : syncedViews)
+    {
+        const auto thisOffset =
+              alignment.IsValid() ? static_cast<int64>(alignment.ToObject(v.object, position)) : static_cast<int64>(position) + v.alignment;
+        if (thisOffset < 0)
+        {
+            continue;
+        }
+        const auto buffer = v.object->GetData().Get(static_cast<uint64>(thisOffset), 1, true);
+        if (buffer.IsValid() && buffer.GetData()[0] == vd.byte)
+        {
+            matches++;
+        }
+    }
+
+    if (matches == syncedViews.size())
+    {
+        cp = MATCH_COMPLETE;
+        return true;
+    }
+
+    if (matches >= 2)
+    {
+        cp = MATCH_PARTIAL;
+        return true;
+    }
 
     return false;
 }
@@ -280,6 +433,28 @@ bool Plugin::GenerateActionOnMove(Reference<Control> sender, int64 deltaStartVie
 {
     CHECK(deltaStartView != 0, false, "");
 
+    std::vector<SyncedView> views;
+    if (alignment.IsValid() && GetCurrentViews(views) == false)
+    {
+        alignment.Clear();
+    }
+
+    if (alignment.IsValid())
+    {
+        // the other views go to the offsets that are aligned with the new start of the sender
+        auto it = std::find_if(views.begin(), views.end(), [&](const SyncedView& v) { return v.view.ToObjectRef<Control>() == sender; });
+        CHECK(it != views.end(), false, "");
+        const auto position = alignment.ToReference(it->object, vd.viewStartOffset);
+        for (auto& v : views)
+        {
+            if (v.view.ToObjectRef<Control>() != sender)
+            {
+                v.view->AdvanceStartView(static_cast<int64>(alignment.ToObject(v.object, position)) - static_cast<int64>(v.data.viewStartOffset));
+            }
+        }
+        return true;
+    }
+
     auto desktop         = AppCUI::Application::GetDesktop();
     const auto windowsNo = desktop->GetChildrenCount();
     CHECK(windowsNo > 1, false, "");
@@ -341,103 +516,62 @@ bool Plugin::ToggleSync()
 
 bool Plugin::FindNextDifference()
 {
-    auto desktop         = AppCUI::Application::GetDesktop();
-    const auto windowsNo = desktop->GetChildrenCount();
-
-    std::vector<Reference<ViewControl>> views;
-    views.reserve(windowsNo);
-
-    std::vector<DataCache*> caches;
-    caches.reserve(windowsNo);
-
-    std::vector<ViewData> viewsData;
-    viewsData.reserve(windowsNo);
+    std::vector<SyncedView> views;
+    CHECK(GetCurrentViews(views), false, "");
 
-    for (uint32 i = 0; i < windowsNo; i++)
+    if (alignment.IsValid())
     {
-        auto window         = desktop->GetChild(i);
-        auto interface      = window.ToObjectRef<GView::View::WindowInterface>();
-        auto view           = interface->GetCurrentView();
-        const auto viewName = view->GetName();
-        if (viewName == VIEW_NAME)
-        {
-            views.push_back(view);
-            caches.push_back(&interface->GetObject()->GetData());
-
-            auto& vd = viewsData.emplace_back();
-            view->GetViewData(vd, GView::Utils::INVALID_OFFSET);
-            vd.viewStartOffset += 1;
-        }
+        const auto next = alignment.FindNextUnaligned(alignment.ToReference(views[0].object, views[0].data.viewStartOffset) + 1);
+        CHECK(next != GView::Utils::INVALID_OFFSET, false, "No next difference");
+        MoveViews(views, next);
+        return true;
     }
 
-    uint64 bufferSize{ GView::Utils::INVALID_OFFSET };
-    for (const auto& data : viewsData)
+    UpdateDiffIndex(views);
+    uint64 next = 0;
+    if (diffIndex.FindNextDifference(views[0].data.viewStartOffset + 1, next) == false)
     {
-        if (data.viewSize > 0)
+        // not indexed (yet) => scan the rest of the objects
+        uint64 start, end;
+        DiffIndex::GetCommonRange(views, start, end);
+        if (ScanForDifference(views, next, end, false, next) == false)
         {
-            bufferSize = std::min<uint64>(bufferSize, data.viewSize);
+            next = end;
         }
     }
-    CHECK(bufferSize != GView::Utils::INVALID_OFFSET, false, "");
 
-    bool differenceNotFound{ true };
-    do
-    {
-        std::vector<BufferView> buffers;
-        buffers.reserve(windowsNo);
-
-        for (uint32 i = 0; i < windowsNo; i++)
-        {
-            auto& view             = views.at(i);
-            auto& data             = viewsData.at(i);
-            auto& cache            = caches.at(i);
-            buffers.emplace_back() = cache->Get(data.viewStartOffset, static_cast<uint32>(bufferSize), false);
-        }
-
-        uint32 i = 0;
-        std::vector<char> bytes;
-        bytes.reserve(windowsNo);
-        for (; i < bufferSize; i++)
-        {
-            for (const auto& buffer : buffers)
-            {
-                if (buffer.GetLength() <= i)
-                {
-                    differenceNotFound = false;
-                    break;
-                }
-
-                bytes.push_back(buffer.GetData()[i]);
-            }
+    MoveViews(views, next);
+    return true;
+}
 
-            if (bytes.empty() || std::equal(bytes.begin() + 1, bytes.end(), bytes.begin()) == false)
-            {
-                differenceNotFound = false;
-                break;
-            }
+bool Plugin::FindPreviousDifference()
+{
+    std::vector<SyncedView> views;
+    CHECK(GetCurrentViews(views), false, "");
 
-            bytes.clear();
-        }
+    if (alignment.IsValid())
+    {
+        const auto previous = alignment.FindPreviousUnaligned(alignment.ToReference(views[0].object, views[0].data.viewStartOffset));
+        CHECK(previous != GView::Utils::INVALID_OFFSET, false, "No previous difference");
+        MoveViews(views, previous);
+        return true;
+    }
 
-        for (auto& data : viewsData)
+    UpdateDiffIndex(views);
+    const auto position = views[0].data.viewStartOffset;
+    uint64 previous     = 0;
+    if (diffIndex.FindPreviousDifference(position, previous) == false)
+    {
+        // [previous, position) is not indexed yet
+        const auto indexedEnd = previous;
+        if (ScanForDifference(views, indexedEnd, position, true, previous) == false)
         {
-            data.viewStartOffset += i;
+            diffIndex.FindPreviousDifference(indexedEnd, previous);
         }
-
-    } while (differenceNotFound);
-
-    for (uint32 i = 0; i < windowsNo; i++)
-    {
-        auto& view = views.at(i);
-
-        view->OnEvent(nullptr, AppCUI::Controls::Event::Command, View::VIEW_COMMAND_DEACTIVATE_SYNC);
-
-        view->GoTo(viewsData.at(i).viewStartOffset); // moves the cursor
-        view->GoTo(viewsData.at(i).viewStartOffset); // moves the start view
-
-        view->OnEvent(nullptr, AppCUI::Controls::Event::Command, sync->IsChecked() ? View::VIEW_COMMAND_ACTIVATE_SYNC : View::VIEW_COMMAND_DEACTIVATE_SYNC);
     }
+    CHECK(previous != GView::Utils::INVALID_OFFSET, false, "No previous difference");
 
+    MoveViews(views, previous);
     return true;
 }
 
@@ -471,19 +605,17 @@ bool Plugin::FindNextDifferentCharacter()
             while (true)
             {
                 const auto bf = dc.Get(vd.cursorStartOffset, dc.GetCacheSize(), false);
-                for (uint64 i = 0; i < bf.GetLength(); i++)
-                {
-                    const auto c = bf.GetData()[i];
-                    if (c != initial)
-                    {
-                        view->GoTo(vd.cursorStartOffset + i); // moves the cursor
-                        return true;
-                    }
-                }
                 if (bf.IsValid() == false || bf.GetLength() == 0)
                 {
                     break;
                 }
+                const auto i = Kernel::FindFirstDifferentFrom(bf.GetData(), bf.GetLength(), initial);
+                if (i < bf.GetLength())
+                {
+                    view->GoTo(vd.cursorStartOffset + i); // moves the cursor
+                    return true;
+                }
+                vd.cursorStartOffset += bf.GetLength();
             }
         }
     }
@@ -527,6 +659,15 @@ extern "C"
             plugin->FindNextDifference();
             return true;
         }
+        if (command == "FindPreviousDifference")
+        {
+            if (plugin == nullptr)
+            {
+                plugin.reset(new GView::GenericPlugins::SyncCompare::Plugin());
+            }
+            plugin->FindPreviousDifference();
+            return true;
+        }
         if (command == "FindNextDC")
         {
             GView::GenericPlugins::SyncCompare::Plugin::FindNextDifferentCharacter();
@@ -537,9 +678,10 @@ extern "C"
 
     PLUGIN_EXPORT void UpdateSettings(IniSection sect)
     {
-        sect["Command.SyncCompare"]        = Input::Key::Ctrl | Input::Key::Shift | Input::Key::Space;
-        sect["Command.ToggleSync"]         = Input::Key::Shift | Input::Key::Space;
-        sect["Command.FindNextDifference"] = Input::Key::Shift | Input::Key::F11;
-        sect["Command.FindNextDC"]         = Input::Key::Ctrl | Input::Key::Shift | Input::Key::F11;
+        sect["Command.SyncCompare"]            = Input::Key::Ctrl | Input::Key::Shift | Input::Key::Space;
+        sect["Command.ToggleSync"]             = Input::Key::Shift | Input::Key::Space;
+        sect["Command.FindNextDifference"]     = Input::Key::Shift | Input::Key::F11;
+        sect["Command.FindPreviousDifference"] = Input::Key::Alt | Input::Key::F11;
+        sect["Command.FindNextDC"]             = Input::Key::Ctrl | Input::Key::Shift | Input::Key::F11;
     }
 }
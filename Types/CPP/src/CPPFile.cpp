@@ -988,10 +988,10 @@ void CPPFile::RemoveLineContinuityCharacter(TextEditor& editor)
         if (!res.has_value())
             break;
         pos       = res.value() + 1;
-        auto next = editor[pos];
+        auto next = editor.GetChar(pos);
         if ((next == '\n') || (next == '\r'))
         {
-            auto nextAfterNext = editor[pos + 1];
+            auto nextAfterNext = editor.GetChar(pos + 1);
             if (((nextAfterNext == '\n') || (nextAfterNext == '\r')) && (nextAfterNext != next))
             {
                 // case like \CRLF or \LFCR
@@ -1023,7 +1023,7 @@ void CPPFile::PreprocessText(GView::View::LexicalViewer::TextEditor& editor)
         if (!res.has_value())
             break;
         pos = res.value() + 2;
-        if ((editor[pos] == ':') && ((editor[pos + 1] == '>') || (editor[pos + 1] == ':')))
+        if ((editor.GetChar(pos) == ':') && ((editor.GetChar(pos + 1) == '>') || (editor.GetChar(pos + 1) == ':')))
         {
             // skip it
         }
@@ -24,6 +24,11 @@ extern "C"
         return new ELF::ELFFile();
     }
 
+    PLUGIN_EXPORT bool Update(Reference<GView::Object> object)
+    {
+        return object->GetContentType<ELF::ELFFile>()->Update();
+    }
+
     static const auto HEADER_COLOR      = ColorPair{ Color::Olive, Color::Transparent };
     static const auto PHT_COLOR         = ColorPair{ Color::Magenta, Color::Transparent };
     static const auto SHT_COLOR         = ColorPair{ Color::DarkRed, Color::Transparent };
@@ -1094,10 +1094,10 @@ void JSFile::RemoveLineContinuityCharacter(TextEditor& editor)
         if (!res.has_value())
             break;
         pos       = res.value() + 1;
-        auto next = editor[pos];
+        auto next = editor.GetChar(pos);
         if ((next == '\n') || (next == '\r'))
         {
-            auto nextAfterNext = editor[pos + 1];
+            auto nextAfterNext = editor.GetChar(pos + 1);
             if (((nextAfterNext == '\n') || (nextAfterNext == '\r')) && (nextAfterNext != next))
             {
                 // case like \CRLF or \LFCR
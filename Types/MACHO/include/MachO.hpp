@@ -241,6 +241,7 @@ class MachOFile : public TypeInterface,
 
 private:
     bool ComputeHash(const Buffer& buffer, uint8 hashType, std::string& output) const;
+    bool ComputePagesHashes(uint8 hashType, uint64 codeLimit, uint32 pageSize, uint32 slotsCount, std::vector<std::string>& output);
 
     bool GetColorForBuffer(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result) override;
     bool GetColorForBufferIntel(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result);
@@ -611,15 +611,20 @@ bool MachOFile::SetCodeSignature()
             const auto pageSize = codeSignature->codeDirectory.pageSize ? (1U << codeSignature->codeDirectory.pageSize) : 0x1000U;
             auto remaining      = codeSignature->codeDirectory.codeLimit;
             auto processed      = 0ULL;
+
+            std::vector<std::string> pagesHashes;
+            ComputePagesHashes(hashType, codeSignature->codeDirectory.codeLimit, pageSize, codeSignature->codeDirectory.nCodeSlots, pagesHashes);
+
             for (auto slot = 0U; slot < codeSignature->codeDirectory.nCodeSlots; slot++) {
                 CHECK(ProgressStatus::Update(slot, ls.Format("Hashes %u/%u...", slot, codeSignature->codeDirectory.nCodeSlots)) == false, false, "");
 
-                const auto size             = std::min<>(remaining, pageSize);
-                const auto hashOffset       = codeSignature->codeDirectory.hashOffset + codeSignature->codeDirectory.hashSize * slot;
-                const auto bufferToValidate = obj->GetData().CopyToBuffer(processed, size);
+                const auto size       = std::min<>(remaining, pageSize);
+                const auto hashOffset = codeSignature->codeDirectory.hashOffset + codeSignature->codeDirectory.hashSize * slot;
 
                 std::string hashComputed;
-                if (ComputeHash(bufferToValidate, hashType, hashComputed) == false) {
+                if (slot < pagesHashes.size()) {
+                    hashComputed = pagesHashes[slot];
+                } else if (ComputeHash(obj->GetData().CopyToBuffer(processed, size), hashType, hashComputed) == false) {
                     throw std::runtime_error("Unable to validate!");
                 }
 
@@ -721,15 +726,20 @@ bool MachOFile::SetCodeSignature()
             const auto pageSize = cd.pageSize ? (1U << cd.pageSize) : 0U;
             auto remaining      = cd.codeLimit;
             auto processed      = 0ULL;
+
+            std::vector<std::string> pagesHashes;
+            ComputePagesHashes(hashType, cd.codeLimit, pageSize, cd.nCodeSlots, pagesHashes);
+
             for (auto slot = 0U; slot < cd.nCodeSlots; slot++) {
                 CHECK(ProgressStatus::Update(slot, ls.Format("Hashes %u/%u...", slot, cd.nCodeSlots)) == false, false, "");
 
-                const auto size             = std::min<>(remaining, pageSize);
-                const auto hashOffset       = cd.hashOffset + cd.hashSize * slot;
-                const auto bufferToValidate = obj->GetData().CopyToBuffer(processed, size);
+                const auto size       = std::min<>(remaining, pageSize);
+                const auto hashOffset = cd.hashOffset + cd.hashSize * slot;
 
                 std::string hashComputed;
-                if (ComputeHash(bufferToValidate, hashType, hashComputed) == false) {
+                if (slot < pagesHashes.size()) {
+                    hashComputed = pagesHashes[slot];
+                } else if (ComputeHash(obj->GetData().CopyToBuffer(processed, size), hashType, hashComputed) == false) {
                     throw std::runtime_error("Unable to validate!");
                 }
 
@@ -1103,6 +1113,47 @@ bool MachOFile::ComputeHash(const Buffer& buffer, uint8 hashType, std::string& o
     return false;
 }
 
+bool MachOFile::ComputePagesHashes(uint8 hashType, uint64 codeLimit, uint32 pageSize, uint32 slotsCount, std::vector<std::string>& output)
+{
+    // all the pages are hashed in a single pass and the hashes are cached (reopening the file does not hash them again)
+    GView::Hashes::OpenSSLHashKind kind;
+    uint64 length;
+    switch (static_cast<MAC::CodeSignMagic>(hashType)) {
+    case MAC::CodeSignMagic::CS_HASHTYPE_SHA1:
+        kind   = GView::Hashes::OpenSSLHashKind::Sha1;
+        length = static_cast<uint64>(MAC::CodeSignMagic::CS_CDHASH_LEN);
+        break;
+    case MAC::CodeSignMagic::CS_HASHTYPE_SHA256:
+        kind   = GView::Hashes::OpenSSLHashKind::Sha256;
+        length = static_cast<uint64>(MAC::CodeSignMagic::CS_SHA256_LEN);
+        break;
+    case MAC::CodeSignMagic::CS_HASHTYPE_SHA256_TRUNCATED:
+        kind   = GView::Hashes::OpenSSLHashKind::Sha256;
+        length = static_cast<uint64>(MAC::CodeSignMagic::CS_SHA256_TRUNCATED_LEN);
+        break;
+    case MAC::CodeSignMagic::CS_HASHTYPE_SHA384:
+        kind   = GView::Hashes::OpenSSLHashKind::Sha384;
+        length = static_cast<uint64>(MAC::CodeSignMagic::CS_CDHASH_LEN);
+        break;
+    case MAC::CodeSignMagic::CS_HASHTYPE_SHA512:
+        kind   = GView::Hashes::OpenSSLHashKind::Sha512;
+        length = static_cast<uint64>(MAC::CodeSignMagic::CS_CDHASH_LEN);
+        break;
+    default:
+        return false;
+    }
+    CHECK(pageSize > 0, false, "");
+    CHECK((codeLimit + pageSize - 1) / pageSize == slotsCount, false, "");
+    CHECK(codeLimit <= obj->GetData().GetSize(), false, "");
+
+    std::string digest;
+    CHECK(GView::Hashes::HashCache::Compute(obj, kind, 0, codeLimit, pageSize, digest, output), false, "");
+    for (auto& hash : output) {
+        hash.resize(length * 2ULL);
+    }
+    return true;
+}
+
 uint64 MachOFile::VAtoFA(uint64 addr)
 {
     constexpr std::string_view pageZero{ "__PAGEZERO" };
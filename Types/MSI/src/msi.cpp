@@ -61,6 +61,11 @@ PLUGIN_EXPORT TypeInterface* CreateInstance()
     return new MSI::MSIFile();
 }
 
+PLUGIN_EXPORT bool Update(Reference<GView::Object> object)
+{
+    return object->GetContentType<MSI::MSIFile>()->Update();
+}
+
 void CreateBufferView(Reference<WindowInterface> win, Reference<MSI::MSIFile> msi)
 {
     BufferViewer::Settings settings;
@@ -426,6 +426,7 @@ namespace Type
             // View::ContainerViewer::OpenItemInterface
             virtual void OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewItem item) override;
             void DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size);
+            void ReportDecodeIssue(bool isError, const String& message);
 
             uint32 GetSelectionZonesCount() override
             {
@@ -192,6 +192,24 @@ static bool IsValidXML(const std::vector<std::string>& dictionarySubtypes)
     return std::find(dictionarySubtypes.begin(), dictionarySubtypes.end(), KEY::PDF_XML) != dictionarySubtypes.end();
 }
 
+void PDFFile::ReportDecodeIssue(bool isError, const String& message)
+{
+    // DecodeStream also runs without a window (headless scan workers) => no dialogs there, keep the issue in the error list
+    if (GView::App::HasUI()) {
+        if (isError) {
+            Dialogs::MessageBox::ShowError("Error!", message);
+        } else {
+            Dialogs::MessageBox::ShowWarning("Warning!", message);
+        }
+        return;
+    }
+    if (isError) {
+        errList.AddError("%s", message.GetText());
+    } else {
+        errList.AddWarning("%s", message.GetText());
+    }
+}
+
 void PDFFile::DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size)
 {
     // decompress the stream
@@ -213,7 +231,7 @@ void PDFFile::DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size)
                     }
                     buffer = decompressedData;
                 } else {
-                    Dialogs::MessageBox::ShowError("Error!", message);
+                    ReportDecodeIssue(true, message);
                 }
             } else if (filter == PDF::FILTER::RUNLENGTH) {
                 Buffer runLengthDecompressed;
@@ -221,29 +239,29 @@ void PDFFile::DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size)
                 if (RunLengthDecode(buffer, runLengthDecompressed, message)) {
                     buffer = runLengthDecompressed;
                 } else {
-                    Dialogs::MessageBox::ShowError("Error!", message);
+                    ReportDecodeIssue(true, message);
                 }
             } else if (filter == PDF::FILTER::ASCIIHEX) {
                 String message;
                 Buffer asciiHexDecompressed;
                 if (ASCIIHexDecode(buffer, asciiHexDecompressed, message)) {
                     if (message.Len()) {
-                        Dialogs::MessageBox::ShowWarning("Warning!", message);
+                        ReportDecodeIssue(false, message);
                     }
                     buffer = asciiHexDecompressed;
                 } else {
-                    Dialogs::MessageBox::ShowError("Error!", message);
+                    ReportDecodeIssue(true, message);
                 }
             } else if (filter == PDF::FILTER::ASCII85) {
                 String message;
                 Buffer ascii85Decompressed;
                 if (ASCII85Decode(buffer, ascii85Decompressed, message)) {
                     if (message.Len()) {
-                        Dialogs::MessageBox::ShowWarning("Warning!", message);
+                        ReportDecodeIssue(false, message);
                     }
                     buffer = ascii85Decompressed;
                 } else {
-                    Dialogs::MessageBox::ShowError("Error!", message);
+                    ReportDecodeIssue(true, message);
                 }
             } else if (filter == PDF::FILTER::JPX) {
                 // this one has to be a separate plugin for JPEG2000
@@ -255,7 +273,7 @@ void PDFFile::DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size)
                 if (JPXDecode(buffer, jpxDecompressed, width, height, components, message)) {
                     buffer = jpxDecompressed;
                 } else {
-                    Dialogs::MessageBox::ShowError("Error!", message);
+                    ReportDecodeIssue(true, message);
                 }
             } else if (filter == PDF::FILTER::LZW) {
                 Buffer lzwDecompressed;
@@ -270,7 +288,7 @@ void PDFFile::DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size)
                     }
                     buffer = std::move(lzwDecompressed);
                 } else {
-                    Dialogs::MessageBox::ShowError("Error!", message);
+                    ReportDecodeIssue(true, message);
                 }
             } else if (filter == PDF::FILTER::JBIG2) {
                 Buffer jbig2Decompressed;
@@ -278,7 +296,7 @@ void PDFFile::DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size)
                 if (JBIG2Decode(buffer, jbig2Decompressed, message)) {
                     buffer = std::move(jbig2Decompressed);
                 } else {
-                    Dialogs::MessageBox::ShowError("Error!", message);
+                    ReportDecodeIssue(true, message);
                 }
             }
         }
@@ -55,6 +55,17 @@ PLUGIN_EXPORT TypeInterface* CreateInstance()
     return new PDF::PDFFile;
 }
 
+PLUGIN_EXPORT bool Update(Reference<GView::Object> object)
+{
+    return object->GetContentType<PDF::PDFFile>()->Update();
+}
+
+// the objects are parsed by ProcessPDF (with the window) => without one only the header is read
+PLUGIN_EXPORT const char* UpdateScope()
+{
+    return "header";
+}
+
 bool CheckType(GView::Utils::DataCache& data, uint64& offset, const uint64& size_type, const uint8_t PDF_ARRAY[])
 {
     uint8_t buffer;
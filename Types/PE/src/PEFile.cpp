@@ -1998,8 +1998,10 @@ void PEFile::RunCommand(std::string_view commandName)
 
         if (signatureChecked) {
             PE::Commands::DigitalSignature(this).Show();
-        } else {
+        } else if (GView::App::HasUI()) {
             AppCUI::Dialogs::MessageBox::ShowError("Error", data.winTrust.errorMessage);
+        } else {
+            errList.AddError("%s", data.winTrust.errorMessage.GetText());
         }
     } else if (commandName == "AreaHighlighter") {
         static auto ah = PE::Commands::AreaHighlighter(this);
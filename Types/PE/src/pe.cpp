@@ -31,6 +31,11 @@ PLUGIN_EXPORT TypeInterface* CreateInstance()
     return new PE::PEFile();
 }
 
+PLUGIN_EXPORT bool Update(Reference<GView::Object> object)
+{
+    return object->GetContentType<PE::PEFile>()->Update();
+}
+
 void CreateBufferView(Reference<GView::View::WindowInterface> win, Reference<PE::PEFile> pe)
 {
     LocalString<128> tempStr;
@@ -60,6 +60,11 @@ PLUGIN_EXPORT TypeInterface* CreateInstance()
     return new GView::Type::ZIP::ZIPFile();
 }
 
+PLUGIN_EXPORT bool Update(Reference<GView::Object> object)
+{
+    return object->GetContentType<GView::Type::ZIP::ZIPFile>()->Update();
+}
+
 void CreateBufferView(Reference<GView::View::WindowInterface> win, Reference<GView::Type::ZIP::ZIPFile> zip)
 {
     BufferViewer::Settings settings{};